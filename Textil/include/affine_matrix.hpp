@@ -0,0 +1,192 @@
+/**
+ * @file affine_matrix.hpp
+ * @brief Compact 2x3 affine matrix class for 2D transformations in Textil library
+ * @details Provides a templated 2x3 matrix storing only the rows of a 2D affine transformation
+ *          that carry information. It is the compact counterpart of Matrix3 and is used wherever
+ *          a transformation has to be stored or applied many times, such as in draw commands.
+ */
+
+#ifndef TIL_AFFINE_MATRIX_HPP
+#define TIL_AFFINE_MATRIX_HPP
+
+#include "matrix3.hpp"
+#include "vector2.hpp"
+#include "numeric_types.hpp"
+
+namespace til
+{
+    /**
+     * @brief 2x3 affine matrix class template for 2D transformations
+     * @tparam T Numeric type for matrix elements (typically f32 or f64)
+     * @details Stores the upper two rows of a homogeneous 3x3 transformation matrix. The implicit
+     *          third row is always [0, 0, 1], so composition and inversion need fewer operations
+     *          than their Matrix3 equivalents and the matrix occupies six values instead of nine.
+     *
+     * Matrix layout:
+     * ```
+     * | a  b  tx |
+     * | c  d  ty |
+     * ```
+     */
+    template<typename T>
+    class AffineMatrix
+    {
+    public:
+        /**
+         * @brief Default constructor creating uninitialized matrix
+         * @details Matrix elements are not initialized and contain garbage values.
+         *          Use identity() or explicit initialization for predictable behavior.
+         */
+        AffineMatrix() = default;
+
+        /**
+         * @brief Constructor from the six matrix coefficients
+         * @param a Row 0, column 0
+         * @param b Row 0, column 1
+         * @param tx Row 0, column 2 (x translation)
+         * @param c Row 1, column 0
+         * @param d Row 1, column 1
+         * @param ty Row 1, column 2 (y translation)
+         */
+        AffineMatrix(T a, T b, T tx, T c, T d, T ty);
+
+        /**
+         * @brief Constructor from a full 3x3 matrix
+         * @param matrix Matrix whose upper two rows are copied
+         * @details The third row of the source matrix is assumed to be [0, 0, 1].
+         */
+        explicit AffineMatrix(const Matrix3<T>& matrix);
+
+        /**
+         * @brief Transform a 2D vector using this matrix
+         * @param vec 2D vector to transform (treated as homogeneous coordinate [x, y, 1])
+         * @return Transformed 2D vector
+         */
+        Vector2<T> operator*(const Vector2<T>& vec) const;
+
+        /**
+         * @brief Matrix composition operator
+         * @param other Matrix to multiply with (on the right)
+         * @return New matrix representing the composition of transformations
+         * @details The result represents applying transformation 'other' first, then 'this'.
+         */
+        AffineMatrix<T> operator*(const AffineMatrix<T>& other) const;
+
+        /**
+         * @brief Calculate matrix inverse
+         * @return Inverse matrix that undoes this transformation
+         * @throws LogicError if matrix is singular (determinant is zero)
+         */
+        AffineMatrix<T> inverse() const;
+
+        /**
+         * @brief Expand this matrix to a full 3x3 matrix
+         * @return Matrix3 with the implicit third row [0, 0, 1]
+         */
+        Matrix3<T> toMatrix3() const;
+
+        /**
+         * @brief Create identity transformation matrix
+         * @return Identity matrix (no transformation applied)
+         */
+        static AffineMatrix<T> identity();
+
+        /**
+         * @brief Equality comparison operator
+         * @param other Matrix to compare with
+         * @return True if all six elements are exactly equal
+         */
+        bool operator==(const AffineMatrix<T>& other) const;
+
+        /**
+         * @brief Access matrix row for modification
+         * @param row Row index (0-1)
+         * @return Pointer to the first element of the specified row
+         */
+        T* operator[](std::size_t row) { return m[row]; }
+
+        /**
+         * @brief Access matrix row for reading (const version)
+         * @param row Row index (0-1)
+         * @return Const pointer to the first element of the specified row
+         */
+        const T* operator[](std::size_t row) const { return m[row]; }
+
+    private:
+        T m[2][3]; ///< Matrix data stored in row-major order [row][column]
+    };
+
+    template<typename T>
+    AffineMatrix<T>::AffineMatrix(T a, T b, T tx, T c, T d, T ty) {
+        m[0][0] = a; m[0][1] = b; m[0][2] = tx;
+        m[1][0] = c; m[1][1] = d; m[1][2] = ty;
+    }
+
+    template<typename T>
+    AffineMatrix<T>::AffineMatrix(const Matrix3<T>& matrix) {
+        for (int i = 0; i < 2; ++i)
+            for (int j = 0; j < 3; ++j)
+                m[i][j] = matrix[i][j];
+    }
+
+    template<typename T>
+    Vector2<T> AffineMatrix<T>::operator*(const Vector2<T>& vec) const {
+        return Vector2<T>(
+            m[0][0] * vec.x + m[0][1] * vec.y + m[0][2],
+            m[1][0] * vec.x + m[1][1] * vec.y + m[1][2]
+        );
+    }
+
+    template<typename T>
+    AffineMatrix<T> AffineMatrix<T>::operator*(const AffineMatrix<T>& other) const {
+        return AffineMatrix<T>(
+            m[0][0] * other.m[0][0] + m[0][1] * other.m[1][0],
+            m[0][0] * other.m[0][1] + m[0][1] * other.m[1][1],
+            m[0][0] * other.m[0][2] + m[0][1] * other.m[1][2] + m[0][2],
+            m[1][0] * other.m[0][0] + m[1][1] * other.m[1][0],
+            m[1][0] * other.m[0][1] + m[1][1] * other.m[1][1],
+            m[1][0] * other.m[0][2] + m[1][1] * other.m[1][2] + m[1][2]
+        );
+    }
+
+    template<typename T>
+    AffineMatrix<T> AffineMatrix<T>::inverse() const {
+        T det = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+        if (det == 0) {
+            invokeError<LogicError>("Matrix is singular and cannot be inverted.");
+        }
+
+        T a =  m[1][1] / det;
+        T b = -m[0][1] / det;
+        T c = -m[1][0] / det;
+        T d =  m[0][0] / det;
+
+        return AffineMatrix<T>(
+            a, b, -(a * m[0][2] + b * m[1][2]),
+            c, d, -(c * m[0][2] + d * m[1][2])
+        );
+    }
+
+    template<typename T>
+    Matrix3<T> AffineMatrix<T>::toMatrix3() const {
+        Matrix3<T> result;
+        result[0][0] = m[0][0]; result[0][1] = m[0][1]; result[0][2] = m[0][2];
+        result[1][0] = m[1][0]; result[1][1] = m[1][1]; result[1][2] = m[1][2];
+        result[2][0] = (T)0;    result[2][1] = (T)0;    result[2][2] = (T)1;
+        return result;
+    }
+
+    template<typename T>
+    AffineMatrix<T> AffineMatrix<T>::identity() {
+        return AffineMatrix<T>((T)1, (T)0, (T)0, (T)0, (T)1, (T)0);
+    }
+
+    template<typename T>
+    bool AffineMatrix<T>::operator==(const AffineMatrix<T>& other) const {
+        return m[0][0] == other.m[0][0] && m[0][1] == other.m[0][1] && m[0][2] == other.m[0][2] &&
+               m[1][0] == other.m[1][0] && m[1][1] == other.m[1][1] && m[1][2] == other.m[1][2];
+    }
+}
+
+#endif // TIL_AFFINE_MATRIX_HPP
@@ -0,0 +1,480 @@
+/**
+ * @file animation.hpp
+ * @brief Sprite sheet animation and sprite batching for Textil library
+ * @details Provides SpriteSheet, which describes the frames of a texture atlas and the clips
+ *          playing them, SpriteAnimator, which advances many animations at once over
+ *          structure-of-arrays state, and SpriteBatch, which draws many textured quads from
+ *          one texture in a single draw call.
+ */
+
+#ifndef TIL_ANIMATION_HPP
+#define TIL_ANIMATION_HPP
+
+#include "drawables.hpp"
+#include "rect.hpp"
+#include <vector>
+
+namespace til
+{
+    /**
+     * @brief Frames and animation clips of a texture atlas
+     *
+     * @details A sheet stores a table of frames, each a sub-rectangle of the
+     * texture kept in UV coordinates, and a table of clips, each a sequence of
+     * frame indices played at a fixed rate. The sheet is shared: any number of
+     * animators and sprites reference its frames and clips by index, so
+     * thousands of animated entities need only one texture and one set of
+     * tables.
+     *
+     * Frames are converted to UV coordinates when they are added, so the
+     * texture should have its final size by then.
+     *
+     * @par Example Usage:
+     * @code
+     * Texture texture("hero.png");          // 4x2 grid of 16x16 frames
+     * SpriteSheet sheet(&texture);
+     * u32 first = sheet.addFrameGrid({ 16, 16 });
+     *
+     * u32 walk = sheet.addClip(first, 4, 8.f);          // frames 0-3 at 8 fps
+     * u32 jump = sheet.addClip({ 4, 5, 6, 7, 6 }, 12.f, false);
+     * @endcode
+     */
+    class SpriteSheet
+    {
+    public:
+
+        /**
+         * @brief A sequence of frames played at a fixed rate
+         */
+        struct Clip
+        {
+            u32 firstFrame = 0;          ///< Offset of the clip in the clip frame table
+            u32 frameCount = 0;          ///< Number of frames in the clip
+            f32 frameDuration = 0.f;     ///< Time each frame is shown, in seconds
+            bool loop = true;            ///< Whether the clip restarts after its last frame
+        };
+
+        /**
+         * @brief Create a sheet without a texture
+         */
+        SpriteSheet() = default;
+
+        /**
+         * @brief Create a sheet for a texture
+         * @param texture Texture holding the frames, must outlive the sheet
+         */
+        explicit SpriteSheet(Texture *texture);
+
+        /**
+         * @brief Set the texture holding the frames
+         * @details Frames already added keep their UV coordinates.
+         * @param texture Texture holding the frames, must outlive the sheet
+         */
+        void setTexture(Texture *texture);
+
+        /**
+         * @brief Get the texture holding the frames
+         * @return Pointer to the texture, or nullptr if none is set
+         */
+        Texture *getTexture() const;
+
+        /**
+         * @brief Add a frame
+         * @param region Frame region in texels
+         * @return Index of the new frame
+         * @throws LogicError If no texture is set or the texture is empty
+         * @throws InvalidArgumentError If the region is empty or exceeds the texture
+         */
+        u32 addFrame(const Rect<u32> &region);
+
+        /**
+         * @brief Add every cell of a regular grid covering the texture as frames
+         * @details Cells are added left to right, top to bottom. Texels past
+         * the last full row or column are ignored.
+         * @param frameSize Size of one cell in texels
+         * @return Index of the first added frame
+         * @throws LogicError If no texture is set or the texture is empty
+         * @throws InvalidArgumentError If the frame size is zero or larger than the texture
+         */
+        u32 addFrameGrid(const Vector2<u32> &frameSize);
+
+        /**
+         * @brief Get the number of frames
+         * @return Frame count
+         */
+        u32 getFrameCount() const;
+
+        /**
+         * @brief Get the region of a frame in UV coordinates
+         * @param frame Frame index
+         * @return UV rectangle of the frame
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        const Rect<f32> &getFrameUV(u32 frame) const;
+
+        /**
+         * @brief Add a clip playing a list of frames
+         * @param frames Frame indices in playing order
+         * @param framesPerSecond Playback rate
+         * @param loop Whether the clip restarts after its last frame
+         * @return Index of the new clip
+         * @throws InvalidArgumentError If the list is empty, a frame is out of range or the rate is not positive
+         */
+        u32 addClip(const std::vector<u32> &frames, f32 framesPerSecond, bool loop = true);
+
+        /**
+         * @brief Add a clip playing consecutive frames
+         * @param firstFrame Index of the first frame
+         * @param frameCount Number of frames
+         * @param framesPerSecond Playback rate
+         * @param loop Whether the clip restarts after its last frame
+         * @return Index of the new clip
+         * @throws InvalidArgumentError If the range is empty or out of range or the rate is not positive
+         */
+        u32 addClip(u32 firstFrame, u32 frameCount, f32 framesPerSecond, bool loop = true);
+
+        /**
+         * @brief Get the number of clips
+         * @return Clip count
+         */
+        u32 getClipCount() const;
+
+        /**
+         * @brief Get a clip
+         * @param clip Clip index
+         * @return The clip description
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        const Clip &getClip(u32 clip) const;
+
+        /**
+         * @brief Get the sheet frame shown at a position of a clip
+         * @param clip Clip index
+         * @param index Position in the clip, less than its frame count
+         * @return Frame index in the sheet
+         * @throws InvalidArgumentError If either index is out of range
+         */
+        u32 getClipFrame(u32 clip, u32 index) const;
+
+    private:
+
+        friend class SpriteAnimator;
+        friend class SpriteBatch;
+
+        Texture *m_texture = nullptr;        ///< Texture holding the frames
+        std::vector<Rect<f32>> m_frames {};  ///< Frame regions in UV coordinates
+        std::vector<Clip> m_clips {};        ///< Clip descriptions
+        std::vector<u32> m_clipFrames {};    ///< Frame indices of all clips, back to back
+    };
+
+    /**
+     * @brief Plays sprite sheet clips for many instances at once
+     *
+     * @details Instance state is kept as structure of arrays: one array each
+     * for the clip, playback time, speed, state flags and current frame. A
+     * single update() advances every instance in one pass, in parallel for
+     * large counts, and the resulting frames can be read as UV rectangles or
+     * appended directly to a SpriteBatch.
+     *
+     * Instances are identified by index. remove() moves the last instance into
+     * the freed slot, so the index of the last instance changes.
+     *
+     * @par Example Usage:
+     * @code
+     * SpriteAnimator animator(&sheet);
+     * for (u32 i = 0; i < 5000; ++i) {
+     *     animator.add(walk, randomStartTime());
+     * }
+     *
+     * // every frame
+     * animator.update(deltaTime);
+     * batch.clear();
+     * batch.add(animator, positions.data(), { 16.f, 16.f });
+     * batch.draw(renderer, window);
+     * @endcode
+     */
+    class SpriteAnimator
+    {
+    public:
+
+        /**
+         * @brief Create an animator for a sheet
+         * @param sheet Sheet whose clips are played, must outlive the animator
+         * @throws InvalidArgumentError If the sheet is null
+         */
+        explicit SpriteAnimator(const SpriteSheet *sheet);
+
+        /**
+         * @brief Get the sheet whose clips are played
+         * @return Pointer to the sheet
+         */
+        const SpriteSheet *getSheet() const;
+
+        /**
+         * @brief Add an instance playing a clip
+         * @param clip Clip index
+         * @param startTime Initial playback time in seconds, useful to desynchronize instances
+         * @return Index of the new instance
+         * @throws InvalidArgumentError If the clip is out of range
+         */
+        u32 add(u32 clip, f32 startTime = 0.f);
+
+        /**
+         * @brief Remove an instance
+         * @details The last instance is moved into the freed index.
+         * @param index Instance index
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        void remove(u32 index);
+
+        /**
+         * @brief Remove all instances
+         */
+        void clear();
+
+        /**
+         * @brief Reserve storage for a number of instances
+         * @param count Instance count to reserve for
+         */
+        void reserve(u32 count);
+
+        /**
+         * @brief Get the number of instances
+         * @return Instance count
+         */
+        u32 getCount() const;
+
+        /**
+         * @brief Switch an instance to a clip
+         * @param index Instance index
+         * @param clip Clip index
+         * @param restart Whether to restart when the instance already plays the clip
+         * @throws InvalidArgumentError If either index is out of range
+         */
+        void play(u32 index, u32 clip, bool restart = false);
+
+        /**
+         * @brief Get the clip an instance plays
+         * @param index Instance index
+         * @return Clip index
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        u32 getClip(u32 index) const;
+
+        /**
+         * @brief Set the playback speed of an instance
+         * @param index Instance index
+         * @param speed Speed multiplier, 1 for normal speed
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        void setSpeed(u32 index, f32 speed);
+
+        /**
+         * @brief Get the playback speed of an instance
+         * @param index Instance index
+         * @return Speed multiplier
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        f32 getSpeed(u32 index) const;
+
+        /**
+         * @brief Pause or resume an instance
+         * @param index Instance index
+         * @param paused Whether the instance stops advancing
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        void setPaused(u32 index, bool paused);
+
+        /**
+         * @brief Check whether an instance is paused
+         * @param index Instance index
+         * @return True if the instance is paused
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        bool isPaused(u32 index) const;
+
+        /**
+         * @brief Check whether a non-looping clip reached its end
+         * @param index Instance index
+         * @return True if the instance stopped on the last frame of its clip
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        bool isFinished(u32 index) const;
+
+        /**
+         * @brief Get the sheet frame an instance shows
+         * @param index Instance index
+         * @return Frame index in the sheet
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        u32 getFrame(u32 index) const;
+
+        /**
+         * @brief Get the UV rectangle of the frame an instance shows
+         * @param index Instance index
+         * @return UV rectangle, suitable for Sprite::textureRect
+         * @throws InvalidArgumentError If the index is out of range
+         */
+        const Rect<f32> &getUV(u32 index) const;
+
+        /**
+         * @brief Advance every instance
+         * @details Looping clips wrap around, also when played backwards with a
+         * negative speed; other clips stop on their first or last frame.
+         * @param deltaTime Elapsed time in seconds
+         */
+        void update(f32 deltaTime);
+
+    private:
+
+        friend class SpriteBatch;
+
+        static constexpr u8 pausedFlag = 1;    ///< Instance does not advance
+        static constexpr u8 finishedFlag = 2;  ///< Non-looping clip reached its end
+
+        /**
+         * @brief Raise an error if an instance index is out of range
+         */
+        void checkIndex(u32 index) const;
+
+        /**
+         * @brief Recompute the time, flags and frame of one instance after its time changed
+         */
+        void advance(u32 index, f32 deltaTime);
+
+        const SpriteSheet *m_sheet = nullptr;  ///< Sheet whose clips are played
+        std::vector<u32> m_clips {};           ///< Clip of each instance
+        std::vector<f32> m_times {};           ///< Playback time of each instance in seconds
+        std::vector<f32> m_speeds {};          ///< Speed multiplier of each instance
+        std::vector<u8> m_flags {};            ///< State flags of each instance
+        std::vector<u32> m_frames {};          ///< Current sheet frame of each instance
+    };
+
+    /**
+     * @brief Many textured quads from one texture drawn in a single call
+     *
+     * @details Quads are appended in local coordinates together with the UV
+     * rectangle they show, and all of them are submitted as one triangle mesh
+     * through the batch transform and filter pipeline. The quads persist until
+     * clear() is called, so static content can be built once and drawn every
+     * frame.
+     *
+     * @par Example Usage:
+     * @code
+     * SpriteBatch batch(&texture);
+     * batch.add({ { 0.f, 0.f }, { 16.f, 16.f } }, sheet.getFrameUV(3));
+     * batch.add(animator, positions.data(), { 16.f, 16.f });
+     * batch.draw(renderer, window);
+     * @endcode
+     */
+    class SpriteBatch : public Drawable
+    {
+    public:
+
+        /**
+         * @brief Create an empty batch without a texture
+         */
+        SpriteBatch();
+
+        /**
+         * @brief Create an empty batch for a texture
+         * @param texture Texture sampled by every quad, must outlive the batch
+         */
+        explicit SpriteBatch(Texture *texture);
+
+        /**
+         * @brief Set the texture sampled by every quad
+         * @param texture Pointer to the texture
+         */
+        void setTexture(Texture *texture);
+
+        /**
+         * @brief Get the texture sampled by every quad
+         * @return Pointer to the texture, or nullptr if none is set
+         */
+        Texture *getTexture() const;
+
+        /**
+         * @brief Set the texture sampling mode
+         * @param mode Sampling mode, nearest neighbor by default
+         */
+        void setSamplingMode(Texture::SamplingMode mode);
+
+        /**
+         * @brief Remove all quads
+         */
+        void clear();
+
+        /**
+         * @brief Reserve storage for a number of quads
+         * @param count Quad count to reserve for
+         */
+        void reserve(u32 count);
+
+        /**
+         * @brief Get the number of quads
+         * @return Quad count
+         */
+        u32 getSpriteCount() const;
+
+        /**
+         * @brief Append a quad
+         * @param destination Quad in local coordinates
+         * @param uv Region of the texture shown, in UV coordinates
+         */
+        void add(const Rect<f32> &destination, const Rect<f32> &uv);
+
+        /**
+         * @brief Append one quad per animator instance showing its current frame
+         * @param animator Animator providing the frames; its sheet should use the batch texture
+         * @param positions Top-left corner of each instance, one per animator instance
+         * @param size Size of every quad in local coordinates
+         */
+        void add(const SpriteAnimator &animator, const Vector2<f32> *positions, const Vector2<f32> &size);
+
+        /**
+         * @brief Add a filter after the texture sampler
+         * @param filter Pointer to the filter to add
+         */
+        void addFilter(BaseFilter *filter);
+
+        /**
+         * @brief Remove all filters except the texture sampler
+         */
+        void clearFilters();
+
+        /**
+         * @brief Render every quad in one draw call
+         *
+         * @param renderer The renderer to use for drawing operations
+         * @param target The render target to draw onto
+         *
+         * @throws LogicError If no texture is set
+         */
+        void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the box around every quad
+         * @return False if the batch is empty
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
+
+    private:
+
+        /**
+         * @brief Grow the tracked bounds to include a quad
+         */
+        void extendBounds(const Vector2<f32> &minimum, const Vector2<f32> &maximum);
+
+        Texture *m_texture = nullptr;                      ///< Texture sampled by every quad
+        std::vector<primitives::Vertex> m_vertices {};     ///< Six vertices per quad
+        Vector2<f32> m_boundsMin { 0.f, 0.f };             ///< Smallest corner of all quads
+        Vector2<f32> m_boundsMax { 0.f, 0.f };             ///< Largest corner of all quads
+
+        FilterPipeline<filters::VertexData, filters::VertexData> m_fragmentPipeline {};  ///< Filter pipeline for visual effects
+        filters::TextureSampler m_textureSampler { nullptr };                           ///< Texture sampling filter
+    };
+}
+
+#endif // TIL_ANIMATION_HPP
@@ -0,0 +1,56 @@
+/**
+ * @file batch_transform.hpp
+ * @brief Batch application of 2D affine matrices to arrays of points
+ * @details Provides functions that transform whole arrays of positions with a single AffineMatrix.
+ *          Interleaved (x, y, x, y, ...), structure-of-arrays and strided layouts are supported.
+ *          The implementations use SSE or AVX when the library is compiled with them
+ *          and split large arrays across OpenMP threads.
+ */
+
+#ifndef TIL_BATCH_TRANSFORM_HPP
+#define TIL_BATCH_TRANSFORM_HPP
+
+#include "affine_matrix.hpp"
+#include "vector2.hpp"
+#include "numeric_types.hpp"
+#include <cstddef>
+
+namespace til
+{
+    /**
+     * @brief Transform an interleaved array of points
+     * @param matrix Matrix applied to every point
+     * @param input Points to transform
+     * @param output Destination for the transformed points (may equal @p input)
+     * @param count Number of points
+     * @details Equivalent to `output[i] = matrix * input[i]` for every point.
+     */
+    void transformPoints(const AffineMatrix<f32>& matrix, const Vector2<f32>* input, Vector2<f32>* output, std::size_t count);
+
+    /**
+     * @brief Transform points stored as separate coordinate arrays
+     * @param matrix Matrix applied to every point
+     * @param inputX X coordinates of the points
+     * @param inputY Y coordinates of the points
+     * @param outputX Destination for the transformed X coordinates (may equal @p inputX)
+     * @param outputY Destination for the transformed Y coordinates (may equal @p inputY)
+     * @param count Number of points
+     * @details Structure-of-arrays layout maps directly onto SIMD registers and is the fastest variant.
+     */
+    void transformPoints(const AffineMatrix<f32>& matrix, const f32* inputX, const f32* inputY, f32* outputX, f32* outputY, std::size_t count);
+
+    /**
+     * @brief Transform points embedded in larger structures
+     * @param matrix Matrix applied to every point
+     * @param input Pointer to the first point
+     * @param inputStride Distance in bytes between consecutive points
+     * @param output Destination array for the transformed points
+     * @param count Number of points
+     * @details Used to transform vertex positions without copying the remaining vertex
+     *          attributes, e.g. `transformPointsStrided(m, &vertices[0].position, sizeof(Vertex), out, n)`.
+     *          Only the 8 bytes of each point are read, so any stride is safe.
+     */
+    void transformPointsStrided(const AffineMatrix<f32>& matrix, const Vector2<f32>* input, std::size_t inputStride, Vector2<f32>* output, std::size_t count);
+}
+
+#endif // TIL_BATCH_TRANSFORM_HPP
@@ -0,0 +1,189 @@
+/**
+ * @file broadcast.hpp
+ * @brief Frame broadcasting to remote viewers for Textil library
+ * @details Provides the FrameBroadcaster class, which accepts viewers over a Unix-domain
+ *          or TCP socket and sends each of them the terminal output of the application.
+ *          Every frame is encoded once and shared by all viewers; viewers that cannot keep
+ *          up skip ahead to the next keyframe instead of slowing down the main loop.
+ */
+
+#ifndef TIL_BROADCAST_HPP
+#define TIL_BROADCAST_HPP
+
+#include "numeric_types.hpp"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace til
+{
+    /**
+     * @brief Sends the same frame stream to any number of socket clients
+     *
+     * @details A network thread accepts clients and writes to them with
+     * non-blocking sockets. broadcast() only appends a shared reference to
+     * the frame to every client queue and wakes the thread, so its cost does
+     * not depend on how fast clients read.
+     *
+     * Frames are either keyframes, which redraw the whole screen, or deltas
+     * on top of the previous frames. A client that just connected, or whose
+     * queue grew beyond the buffer limit, receives nothing until the next
+     * keyframe; a frame that was partly written when the queue was dropped is
+     * completed first so the stream stays well-formed. needsKeyframe() tells
+     * the producer that such a client is waiting.
+     *
+     * Clients are read-only viewers: anything they send is discarded.
+     * The Console feeds a broadcaster with its output when one is set with
+     * Console::setBroadcaster(); character frames are always keyframes, and
+     * graphics protocol output sends a keyframe whenever a client waits.
+     *
+     * Available on Linux and macOS.
+     *
+     * @par Example Usage:
+     * @code
+     * FrameBroadcaster broadcaster;
+     * broadcaster.listenTcp(7000);
+     * framework.console.setBroadcaster(&broadcaster);
+     * // viewers: nc localhost 7000
+     * @endcode
+     */
+    class FrameBroadcaster
+    {
+    public:
+
+        /**
+         * @brief Create a broadcaster that is not listening
+         */
+        FrameBroadcaster();
+
+        /**
+         * @brief Disconnect all clients and stop listening
+         */
+        ~FrameBroadcaster();
+
+        FrameBroadcaster(const FrameBroadcaster &) = delete;
+        FrameBroadcaster &operator=(const FrameBroadcaster &) = delete;
+
+        /**
+         * @brief Listen on a Unix-domain socket
+         * @details Stops listening first. An existing socket file at the path is replaced;
+         *          any other kind of file there is left untouched.
+         * @param path Filesystem path of the socket
+         * @throws SocketError If the socket cannot be created or bound, or the path is taken by a non-socket file
+         */
+        void listenUnix(const std::string &path);
+
+        /**
+         * @brief Listen on a TCP port
+         * @details Stops listening first.
+         * @param port Port to listen on, 0 to pick a free one (see getPort())
+         * @param address IPv4 address to bind, loopback by default
+         * @throws SocketError If the socket cannot be created or bound
+         */
+        void listenTcp(u16 port, const std::string &address = "127.0.0.1");
+
+        /**
+         * @brief Disconnect all clients and stop listening
+         * @details Removes the socket file of a Unix-domain listener.
+         */
+        void close();
+
+        /**
+         * @brief Check whether the broadcaster accepts clients
+         * @return True between a successful listen call and close()
+         */
+        bool isListening() const;
+
+        /**
+         * @brief Get the TCP port being listened on
+         * @return Bound port, 0 when not listening on TCP
+         */
+        u16 getPort() const;
+
+        /**
+         * @brief Queue a frame for every client
+         * @param frame Encoded bytes of the frame
+         * @param keyframe True if the frame redraws everything without relying on earlier frames
+         */
+        void broadcast(const std::string &frame, bool keyframe);
+
+        /**
+         * @brief Check whether a client waits for a keyframe
+         * @return True if a client connected or was resynchronized since the last keyframe
+         */
+        bool needsKeyframe() const;
+
+        /**
+         * @brief Get the number of connected clients
+         * @return Clients currently connected
+         */
+        u32 getClientCount() const;
+
+        /**
+         * @brief Get how often clients were dropped back to the next keyframe
+         * @return Number of resynchronizations since listening started
+         */
+        u64 getResyncCount() const;
+
+        /**
+         * @brief Set the queue size at which a client is resynchronized
+         * @param bytes Unsent bytes a client may fall behind by, 4 MiB by default
+         */
+        void setMaxBufferedBytes(std::size_t bytes);
+
+    private:
+
+        /**
+         * @brief A connected viewer
+         */
+        struct Client
+        {
+            int fd = -1;                                            ///< Socket
+            std::deque<std::shared_ptr<const std::string>> queue {};  ///< Frames not fully sent yet
+            std::size_t offset = 0;                                 ///< Bytes of the front frame already sent
+            std::size_t bufferedBytes = 0;                          ///< Unsent bytes in the queue
+            bool waitingForKeyframe = true;                         ///< Whether deltas are withheld
+        };
+
+        /**
+         * @brief Start the network thread on a bound listener
+         */
+        void start(int listenFd);
+
+        /**
+         * @brief Body of the network thread
+         */
+        void networkLoop();
+
+        /**
+         * @brief Send queued frames until the socket would block
+         * @return False if the client disconnected
+         */
+        bool flushClient(Client &client);
+
+        /**
+         * @brief Wake the network thread
+         */
+        void wake();
+
+        int m_listenFd = -1;                  ///< Listening socket
+        int m_wakeFds[2] { -1, -1 };          ///< Pipe waking the network thread
+        std::string m_unixPath {};            ///< Socket file to remove on close
+        u16 m_port = 0;                       ///< Bound TCP port
+
+        std::vector<Client> m_clients {};     ///< Connected clients
+        std::size_t m_maxBufferedBytes = 4u << 20;  ///< Queue size that triggers a resync
+        u64 m_resyncCount = 0;                ///< Resynchronizations so far
+        bool m_stop = false;                  ///< Asks the network thread to exit
+        mutable std::mutex m_mutex;           ///< Guards the client list and queues
+
+        std::atomic<bool> m_needsKeyframe { false };  ///< Whether a client waits for a keyframe
+        std::thread m_network;                ///< Network thread
+    };
+}
+
+#endif // TIL_BROADCAST_HPP
@@ -125,6 +125,20 @@ namespace til
          *          based on the selected mode. Handles all supported BlendMode variants.
          */
         static Color applyBlend(Color destination, Color source, BlendMode blendMode);
+
+        /**
+         * @brief Signature shared by all static blending functions
+         */
+        using BlendFunction = Color (*)(Color destination, Color source);
+
+        /**
+         * @brief Look up the blending function implementing a blend mode
+         * @param blendMode Blending algorithm to look up
+         * @return Pointer to the matching static blend function
+         * @details Lets callers that blend whole runs of pixels with one mode resolve the
+         *          mode once instead of dispatching through applyBlend() for every pixel.
+         */
+        static BlendFunction getBlendFunction(BlendMode blendMode);
         
         /**
          * @brief No blending - source replaces destination
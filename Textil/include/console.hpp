@@ -29,9 +29,25 @@
 #include "filters.hpp"
 #include "character_cell.hpp"
 #include "window.hpp"
+#include "graphics_output.hpp"
+#include "frame_export.hpp"
+#include <list>
+#include <span>
+#include <string>
 
 namespace til
 {
+    /**
+     * @brief Append the terminal output for a character buffer
+     * @details Emits a 24-bit foreground color sequence whenever the color changes
+     *          between cells and moves to the start of the next line after every row.
+     *          Colors are reset at the end; cursor placement is left to the caller.
+     * @param cells Cells in row-major order, at least size.x * size.y of them
+     * @param size Buffer dimensions in cells
+     * @param output String the escape sequences and UTF-8 text are appended to
+     */
+    void encodeCharacterCells(std::span<const CharacterCell> cells, const Vector2<u32> &size, std::string &output);
+
     /**
      * @brief Low-level cross-platform terminal interface and input management
      * @details The Console class provides direct access to terminal/console functionality
@@ -82,6 +98,49 @@ namespace til
          */
         Vector2<u32> getSize() const;
 
+        /**
+         * @brief Select how windows are shown
+         * @details With GraphicsProtocol::None windows are drawn as character cells.
+         *          With Kitty or Sixel, Framework::display() sends the pixel buffer of
+         *          every window to the terminal as an image instead, placed at the
+         *          window position in cells, and only regions that changed since the
+         *          previous frame are re-sent. Encoding and writing run on the graphics
+         *          presenter's thread. Switching clears the screen.
+         * @param protocol Output protocol
+         */
+        void setGraphicsProtocol(GraphicsProtocol protocol);
+
+        /**
+         * @brief Get how windows are shown
+         * @return Current output protocol
+         */
+        GraphicsProtocol getGraphicsProtocol() const;
+
+        /**
+         * @brief Get the presenter used for graphics protocol output
+         * @return Presenter, e.g. to redirect its output with GraphicsPresenter::setSink()
+         */
+        GraphicsPresenter &getGraphicsPresenter();
+
+        /**
+         * @brief Mirror the console output to remote viewers
+         * @details Every frame written to the terminal is also broadcast, encoded
+         *          once for all viewers. Character frames redraw the whole screen
+         *          and are sent as keyframes; graphics protocol output sends deltas
+         *          and a keyframe whenever a viewer needs one.
+         * @param broadcaster Broadcaster to feed, nullptr to stop; must outlive the console or be unset
+         */
+        void setBroadcaster(FrameBroadcaster *broadcaster);
+
+        /**
+         * @brief Publish every presented frame to shared memory
+         * @details Character frames are published after they are written to the
+         *          terminal. With a graphics protocol no character frame is composed,
+         *          so frames carry only the exporter's pixel source.
+         * @param exporter Exporter to feed, nullptr to stop; must outlive the console or be unset
+         */
+        void setFrameExporter(SharedFrameExporter *exporter);
+
 #ifdef __linux__
         /**
          * @brief Find available keyboard input devices (Linux only)
@@ -171,6 +230,8 @@ namespace til
         void writeBuffer();
         void constructOutputString(const FilterableBuffer<CharacterCell> &buffer, const Vector2<u32> &size);
         void writeCharacterBuffer(const FilterableBuffer<CharacterCell> &buffer, const Vector2<u32> &size);
+        void presentGraphics(std::list<Window> &windows);
+        Vector2<u32> getCellPixelSize() const;
         void getEvents(std::vector<Event> &events);
         void getMouseEvents(std::vector<Event> &events);
         void getKeyboardEvents(std::vector<Event> &events);
@@ -232,6 +293,9 @@ namespace til
         Vector2<u32> m_screenSize { 0, 0 };
         FilterableBuffer<CharacterCell> m_characterBuffer {};
         std::string m_outputString = "";
+        GraphicsPresenter m_graphicsPresenter {};
+        FrameBroadcaster *m_broadcaster = nullptr;
+        SharedFrameExporter *m_frameExporter = nullptr;
 
 #ifdef _WIN32
         Handles m_handles;
@@ -26,7 +26,12 @@
  * represents the top-left corner of the terminal
  */
 
+#ifndef TIL_DRAWABLES_HPP
+#define TIL_DRAWABLES_HPP
+
 #include "render.hpp"
+#include "path.hpp"
+#include "triangulation.hpp"
 #include "texture.hpp"
 #include "transform.hpp"
 
@@ -95,6 +100,33 @@ namespace til
          * @warning Implementations must handle error conditions gracefully
          */
         virtual void draw(Renderer &renderer, RenderTarget &target) = 0;
+
+        /**
+         * @brief Get the bounding box of the drawable before transformation
+         * 
+         * @details The box must contain everything the drawable renders, in
+         * the local coordinates its transform is applied to. It may be
+         * larger than the exact shape, and may have zero width or height for
+         * points and straight lines.
+         * 
+         * @param bounds Receives the bounding box
+         * @return True if the drawable has bounds, false if they are unknown
+         * 
+         * @note The default implementation returns false, so drawables
+         * without bounds are treated as always visible
+         */
+        virtual bool getLocalBounds(Rect<f32> &bounds) const;
+
+        /**
+         * @brief Get the bounding box of the drawable in world coordinates
+         * 
+         * @details Transforms the corners of the local bounds by the world
+         * matrix of the transform and returns the box enclosing them.
+         * 
+         * @param bounds Receives the bounding box
+         * @return True if the drawable has bounds, false if they are unknown
+         */
+        virtual bool getBounds(Rect<f32> &bounds) const;
     };
 
     /**
@@ -139,7 +171,8 @@ namespace til
     {
     public:
 
-        Vector2<f32> size { 10.f, 10.f };  ///< Dimensions of the sprite in world units
+        Vector2<f32> size { 10.f, 10.f };                            ///< Dimensions of the sprite in world units
+        Rect<f32> textureRect { { 0.f, 0.f }, { 1.f, 1.f } };        ///< Region of the texture shown, in UV coordinates
 
     public:
 
@@ -204,6 +237,13 @@ namespace til
          */
         void draw(Renderer &renderer, RenderTarget &target) override;
 
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the quad from the origin to size
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
+
         /**
          * @brief Add a filter to the end of the filter pipeline
          * 
@@ -329,6 +369,13 @@ namespace til
          * @note Rectangles without filters may not be visible
          */
         void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the rectangle from topLeft to topLeft + size
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
     };
 
     /**
@@ -341,7 +388,8 @@ namespace til
      * 
      * The polygon system automatically handles:
      * - Concave and convex polygon rendering
-     * - Automatic triangulation using ear clipping
+     * - Automatic triangulation by monotone partition in O(n log n)
+     * - Holes inside the outline
      * - Custom UV coordinate assignment
      * - Mesh rebuilding when vertices change
      * 
@@ -352,8 +400,8 @@ namespace til
      * - Vector graphics rendering
      * 
      * @par Performance Notes:
-     * - Mesh rebuilding occurs when vertices change
-     * - Complex polygons with many vertices may impact performance
+     * - Mesh rebuilding occurs when vertices or holes change
+     * - Outlines with thousands of vertices triangulate in milliseconds
      * - UV coordinates are optional but recommended for textured polygons
      * 
      * @par Example Usage:
@@ -499,6 +547,35 @@ namespace til
          */
         void clearUVs();
 
+        /**
+         * @brief Get the polygon's holes
+         * 
+         * @return Constant reference to the hole outlines, in local coordinates
+         */
+        const std::vector<std::vector<Vector2<f32>>>& getHoles() const;
+
+        /**
+         * @brief Cut a hole out of the polygon
+         * 
+         * @details The hole outline may use either winding order. It must lie
+         * inside the polygon and must not overlap other holes, although
+         * outlines may touch at shared vertices. A polygon whose outline
+         * and holes cannot be triangulated draws nothing. Hole vertices
+         * receive UV coordinates generated from the polygon's bounding box.
+         * 
+         * @param points Hole outline in local coordinates
+         * 
+         * @note Triggers mesh rebuilding on next draw
+         */
+        void addHole(const std::vector<Vector2<f32>> &points);
+
+        /**
+         * @brief Remove all holes from the polygon
+         * 
+         * @note Triggers mesh rebuilding on next draw
+         */
+        void clearHoles();
+
         /**
          * @brief Render the polygon to the specified target
          * 
@@ -513,15 +590,34 @@ namespace til
          */
         void draw(Renderer &renderer, RenderTarget &target) override;
 
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the box enclosing the outline points
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
+
     private:
         /**
          * @brief Rebuild the internal triangle mesh
          * 
-         * @details Performs automatic triangulation of the polygon vertices
-         * using ear clipping algorithm. Also generates UV coordinates if
-         * none are provided. Called automatically when vertices change.
+         * @details Triangulates the outline and holes with triangulatePolygon(),
+         * falling back to ear clipping for outlines without holes it cannot
+         * handle. Leaves the mesh empty if triangulation with holes fails. Also
+         * generates UV coordinates if none are provided. Called automatically
+         * when vertices change.
          */
         void rebuildMesh();
+
+        /**
+         * @brief Triangulate the outline by ear clipping
+         * 
+         * @details Quadratic fallback used for self-intersecting outlines.
+         * Holes are ignored.
+         * 
+         * @param indices Receives three point indices per triangle (appended)
+         */
+        void triangulateEarClipping(std::vector<u32> &indices) const;
         
         /**
          * @brief Calculate signed area of a polygon
@@ -553,6 +649,7 @@ namespace til
         std::vector<Vector2<f32>> m_points;           ///< Polygon vertex positions
         std::vector<Vector2<f32>> m_uvs;              ///< UV coordinates for vertices
         bool m_hasCustomUVs = false;                  ///< Whether custom UVs are assigned
+        std::vector<std::vector<Vector2<f32>>> m_holes;  ///< Outlines of the holes
 
         std::vector<primitives::Vertex> m_builtVertices;  ///< Triangulated mesh vertices
         bool m_meshDirty = true;                          ///< Whether mesh needs rebuilding
@@ -611,6 +708,13 @@ namespace til
          * @param target The render target to draw onto
          */
         void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives a zero-sized box at the position
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
     };
 
     /**
@@ -623,7 +727,8 @@ namespace til
      * Lines support gradient effects through UV coordinate mapping and
      * can be styled using the filter pipeline. The line is rendered as
      * a connection between the start and end points with proper UV
-     * interpolation along its length.
+     * interpolation along its length. Lines thicker than one unit are
+     * rendered as a filled quad around the segment.
      * 
      * @par Use Cases:
      * - Wireframe rendering
@@ -658,18 +763,36 @@ namespace til
         Vector2<f32> end { 1.f, 1.f };        ///< Ending point of the line
         Vector2<f32> uvStart { 0.f, 0.f };    ///< UV coordinate at line start
         Vector2<f32> uvEnd { 1.f, 0.f };      ///< UV coordinate at line end
+        f32 thickness = 1.f;                  ///< Line width in local units; values up to 1 draw a single-pixel line
 
         /**
          * @brief Render the line to the specified target
          * 
          * @details Draws a line segment from start to end points with
          * UV coordinate interpolation. The line uses the transformation
-         * matrix for positioning and scaling.
+         * matrix for positioning and scaling. Thick lines are tessellated
+         * into two triangles with butt ends, which are kept until start,
+         * end or thickness change.
          * 
          * @param renderer The renderer to use for drawing operations
          * @param target The render target to draw onto
          */
         void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the box enclosing both end points, widened by half the thickness
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
+
+    private:
+        std::vector<PathContour> m_contours;              ///< Single open contour reused between rebuilds
+        std::vector<primitives::Vertex> m_builtVertices;  ///< Tessellated stroke triangles, uv.x running along the line
+        bool m_meshValid = false;                         ///< Whether the cached mesh was built at all
+        Vector2<f32> m_builtStart {};                     ///< Start point the mesh was built from
+        Vector2<f32> m_builtEnd {};                       ///< End point the mesh was built from
+        f32 m_builtThickness = 0.f;                       ///< Thickness the mesh was built with
     };
 
     /**
@@ -734,5 +857,239 @@ namespace til
          * @param target The render target to draw onto
          */
         void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the box enclosing the ellipse
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief A drawable stroked vector path
+     * 
+     * @details The PathDrawable class renders the outline of a Path as a
+     * stroke of configurable width, joins and caps. Curves are flattened
+     * with a tolerance measured in screen pixels, so the number of
+     * generated triangles follows the on-screen size of the path rather
+     * than the number of control points.
+     * 
+     * The tessellated mesh is cached and only rebuilt when the path, the
+     * stroke style or the tolerance changes, or when the transform's scale
+     * moves to a different quarter octave.
+     * 
+     * @par Use Cases:
+     * - Chart series and axes with thick strokes
+     * - Bezier curves and rounded outlines
+     * - Vector icons and diagrams
+     * 
+     * @par Example Usage:
+     * @code
+     * PathDrawable curve;
+     * curve.path.moveTo({0, 20});
+     * curve.path.cubicTo({20, 0}, {40, 40}, {60, 20});
+     * curve.stroke.width = 3.f;
+     * curve.stroke.join = LineJoin::Round;
+     * curve.stroke.cap = LineCap::Round;
+     * 
+     * filters::SolidColor color(Color(255, 200, 0));
+     * curve.fragmentPipeline.addFilter(&color);
+     * curve.fragmentPipeline.build();
+     * 
+     * curve.draw(renderer, target);
+     * @endcode
+     */
+    class PathDrawable : public Drawable
+    {
+    public:
+
+        FilterPipeline<filters::VertexData, filters::VertexData> fragmentPipeline {};  ///< Filter pipeline for visual effects
+
+        Path path {};             ///< Outline to stroke, in local coordinates
+        StrokeStyle stroke {};    ///< Width, joins and caps of the stroke, in local units
+        f32 tolerance = 0.25f;    ///< Maximum on-screen deviation of curves and round joins, in pixels
+
+        /**
+         * @brief Render the stroked path to the specified target
+         * 
+         * @details Rebuilds the stroke mesh if it is out of date and submits
+         * it as a triangle mesh using the current transformation.
+         * 
+         * @param renderer The renderer to use for drawing operations
+         * @param target The render target to draw onto
+         */
+        void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the bounds of the path, widened by the furthest the stroke can reach
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
+
+    private:
+
+        std::vector<PathContour> m_contours;              ///< Flattened path reused between rebuilds
+        std::vector<primitives::Vertex> m_builtVertices;  ///< Tessellated stroke triangles
+
+        bool m_meshValid = false;                         ///< Whether the cached mesh was built at all
+        u64 m_builtVersion = 0;                           ///< Path version the mesh was built from
+        StrokeStyle m_builtStroke {};                     ///< Stroke style the mesh was built with
+        f32 m_builtTolerance = 0.f;                       ///< Tolerance the mesh was built with
+        i32 m_builtScaleLevel = 0;                        ///< Quantized transform scale the mesh was built for
+    };
+
+    /**
+     * @brief A drawable that replays the captured output of another drawable
+     * 
+     * @details A CachedDrawable wraps any Drawable and records the fragments it
+     * blends into a target in a FragmentRecording. As long as the wrapped
+     * drawable's world transform, the content generation and the target are
+     * unchanged, later frames replay the recording instead of drawing the
+     * drawable, which skips tessellation, rasterization and the fragment
+     * pipeline entirely. Replayed colors are blended again, so the result is
+     * the same as drawing the drawable on whatever lies underneath.
+     * 
+     * The cache cannot see changes to the wrapped drawable other than its
+     * transform: after changing its points, size, texture or filters, call
+     * invalidate(). Filters animated over time should not be cached.
+     * 
+     * Capturing starts only once the same key is seen on two consecutive
+     * draws, so drawables that move every frame are drawn directly and never
+     * pay for capturing. A capture that exceeds the memory limit is abandoned
+     * and the drawable is drawn directly until the key changes.
+     * 
+     * The CachedDrawable's own transform is not used. Cached drawables cannot
+     * be nested inside each other.
+     * 
+     * @par Example Usage:
+     * @code
+     * Polygon coastline;
+     * // ... thousands of points and a multi-filter pipeline ...
+     * 
+     * CachedDrawable cachedCoastline(&coastline);
+     * 
+     * // every frame
+     * cachedCoastline.draw(renderer, window);
+     * 
+     * // after editing the polygon
+     * cachedCoastline.invalidate();
+     * @endcode
+     */
+    class CachedDrawable : public Drawable
+    {
+    public:
+
+        /**
+         * @brief Create a cache without a drawable
+         */
+        CachedDrawable() = default;
+
+        /**
+         * @brief Create a cache for a drawable
+         * 
+         * @param drawable Drawable to cache, must outlive the cache
+         * @param memoryLimit Maximum number of bytes the recording may use
+         */
+        explicit CachedDrawable(Drawable *drawable, std::size_t memoryLimit = FragmentRecording::defaultMemoryLimit);
+
+        /**
+         * @brief Get the cached drawable
+         * @return Pointer to the drawable, or nullptr if none is set
+         */
+        Drawable *getDrawable() const;
+
+        /**
+         * @brief Replace the cached drawable
+         * 
+         * @details Discards the recording.
+         * 
+         * @param drawable Drawable to cache, must outlive the cache
+         */
+        void setDrawable(Drawable *drawable);
+
+        /**
+         * @brief Mark the drawable's content as changed
+         * 
+         * @details Advances the content generation, so the next draws capture
+         * the drawable again.
+         */
+        void invalidate();
+
+        /**
+         * @brief Get the content generation
+         * @return Number of invalidate() calls since the drawable was set
+         */
+        u64 getGeneration() const;
+
+        /**
+         * @brief Check whether draws currently replay the recording
+         * @return True if a complete recording matches the last drawn key
+         */
+        bool isCached() const;
+
+        /**
+         * @brief Get the memory limit of the recording
+         * @return Maximum number of bytes
+         */
+        std::size_t getMemoryLimit() const;
+
+        /**
+         * @brief Set the memory limit of the recording
+         * @param memoryLimit Maximum number of bytes, applied to the next capture
+         */
+        void setMemoryLimit(std::size_t memoryLimit);
+
+        /**
+         * @brief Get the memory held by the recording
+         * @return Allocated bytes
+         */
+        std::size_t getMemoryUsage() const;
+
+        /**
+         * @brief Draw the wrapped drawable, replaying the recording when possible
+         * 
+         * @param renderer The renderer to use for drawing operations
+         * @param target The render target to draw onto
+         */
+        void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the local bounds of the cached drawable
+         * @param bounds Receives the bounding box
+         * @return False if no drawable is set or its bounds are unknown
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
+
+        /**
+         * @brief Get the world bounds of the cached drawable
+         * @details Uses the cached drawable's transform, like draw().
+         * @param bounds Receives the bounding box
+         * @return False if no drawable is set or its bounds are unknown
+         */
+        bool getBounds(Rect<f32> &bounds) const override;
+
+    private:
+
+        /**
+         * @brief Inputs the recorded output depends on
+         */
+        struct CacheKey
+        {
+            const RenderTarget *target = nullptr;                         ///< Target drawn into, null if unset
+            AffineMatrix<f32> matrix = AffineMatrix<f32>::identity();     ///< World matrix of the drawable
+            u64 generation = 0;                                           ///< Content generation
+
+            bool operator==(const CacheKey &other) const;
+        };
+
+        Drawable *m_drawable = nullptr;     ///< Drawable being cached
+        FragmentRecording m_recording {};   ///< Captured output of the drawable
+        CacheKey m_recordedKey {};          ///< Key the recording was captured with
+        CacheKey m_lastKey {};              ///< Key of the previous draw
+        u64 m_generation = 0;               ///< Current content generation
+    };
+}
+
+#endif // TIL_DRAWABLES_HPP
@@ -183,6 +183,39 @@ namespace til
         }
     };
 
+    /**
+     * @brief Error for socket failures
+     * @details Used when a listening socket cannot be created, bound or accepted on,
+     *          for example because the address is in use or the path is not writable.
+     */
+    class SocketError : public Error
+    {
+    public:
+        /**
+         * @brief Constructor setting socket-specific error identification
+         */
+        SocketError() {
+            name = "Socket Error";
+            description = "An error occurred with a socket";
+        }
+    };
+
+    /**
+     * @brief Error for shared memory failures
+     * @details Used when a shared memory object cannot be created, sized or mapped.
+     */
+    class SharedMemoryError : public Error
+    {
+    public:
+        /**
+         * @brief Constructor setting shared-memory-specific error identification
+         */
+        SharedMemoryError() {
+            name = "Shared Memory Error";
+            description = "An error occurred with shared memory";
+        }
+    };
+
     /**
      * @brief Error for logic and programming errors
      * @details Indicates programming errors, invalid state conditions, or violation of logical preconditions.
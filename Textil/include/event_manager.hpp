@@ -103,6 +103,15 @@ namespace til
         template<typename... Callbacks>
         void handleEvents(Callbacks&&... callbacks);
         
+        /**
+         * @brief Append an event to the end of the queue
+         * @param event Event to enqueue
+         * @details Lets applications inject synthetic input, for example when replaying
+         *          recorded sessions or driving the event loop from tests and benchmarks.
+         *          The event is delivered with the next polled or handled events.
+         */
+        void pushEvent(const Event &event);
+
         /**
          * @brief Clear all pending events from queue
          * @details Removes all events from the queue without processing them.
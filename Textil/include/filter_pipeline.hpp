@@ -270,6 +270,13 @@ namespace til
          */
         FilterPipeline &clearFilters();
 
+        /**
+         * @brief Get the number of filters in the pipeline
+         * 
+         * @return Number of filters; an empty pipeline leaves its buffers untouched when run
+         */
+        u32 getFilterCount() const;
+
         /**
          * @brief Add a typed buffer to the pipeline's buffer pool
          * 
@@ -507,6 +514,11 @@ namespace til
         return *this;
     }
 
+    template<typename InputType, typename OutputType>
+    u32 FilterPipeline<InputType, OutputType>::getFilterCount() const {
+        return static_cast<u32>(m_filters.size());
+    }
+
     template<typename InputType, typename OutputType>
     template<typename T>
     u32 FilterPipeline<InputType, OutputType>::addBuffer(FilterableBuffer<T> *buffer) {
@@ -38,6 +38,7 @@
 #include "character_cell.hpp"
 #include <random>
 #include "texture.hpp"
+#include "rect.hpp"
 
 namespace til
 {
@@ -57,6 +58,7 @@ namespace til
         {
             f32 time = 0.f;                ///< Current time in seconds for time-based effects
             bool buffer_resized = false;   ///< Flag indicating if buffers were resized this frame
+            Vector2<u32> bufferSize { 0u, 0u };  ///< Width and height of the processed image, for filters working on whole images
         };
     }
 
@@ -904,6 +906,91 @@ namespace til
              */
             TextureSampler(Texture *texture);
         };
+
+        /**
+         * @brief Point light for the Lighting filter
+         */
+        struct PointLight
+        {
+            Vector2<f32> position { 0.f, 0.f };     ///< Position in pixels
+            Color color { 255, 255, 255, 255 };     ///< Light color, alpha is ignored
+            f32 radius = 32.f;                      ///< Distance in pixels at which the light fades out
+            f32 intensity = 1.f;                    ///< Brightness multiplier
+        };
+
+        /**
+         * @brief Line segment that blocks light for the Lighting filter
+         */
+        struct Occluder
+        {
+            Vector2<f32> start { 0.f, 0.f };  ///< First endpoint in pixels
+            Vector2<f32> end { 0.f, 0.f };    ///< Second endpoint in pixels
+        };
+
+        /**
+         * @brief Data for the 2D lighting pass
+         * 
+         * @details Lights and occluders are given in pixel coordinates of the
+         * processed image and can be changed freely between frames.
+         */
+        struct LightingData : public BaseData
+        {
+            std::vector<PointLight> lights {};            ///< Lights added to the ambient light
+            std::vector<Occluder> occluders {};           ///< Segments casting shadows
+            Color ambientColor { 40, 40, 48, 255 };       ///< Light reaching every pixel
+            f32 resolutionScale = 0.5f;                   ///< Size of the light buffer relative to the image, in (0, 1]
+            u32 shadowMapResolution = 256;                ///< Angular steps of each light's shadow map
+
+            /**
+             * @brief Add the four edges of a rectangle as occluders
+             * @param rect Rectangle in pixels
+             */
+            void addRectangleOccluder(const Rect<f32> &rect);
+
+        private:
+
+            mutable std::vector<f32> m_shadowMaps {};     ///< Nearest occluder distance per light and angle
+            mutable std::vector<f32> m_lightBuffer {};    ///< Accumulated light, three channels per texel
+            mutable Vector2<u32> m_lightBufferSize {};    ///< Dimensions of the light buffer
+
+        friend struct Lighting;
+        };
+
+        /**
+         * @brief Post-processing filter lighting the image with shadowed point lights
+         * 
+         * @details Light is accumulated in a buffer at resolutionScale of the
+         * image size, so its cost follows the light buffer rather than the
+         * window. Each light first builds a 1D shadow map holding the distance
+         * to the nearest occluder in each direction; the light buffer texels
+         * then sum the ambient color and every light that reaches them
+         * unblocked, with quadratic falloff over the light radius. Shadow maps
+         * are built for all lights in parallel and the buffer is filled row by
+         * row in parallel. Finally the buffer is bilinearly upsampled and
+         * multiplied into the image.
+         * 
+         * Requires BaseData::bufferSize, which render targets provide; the
+         * filter does nothing if it does not match the buffer.
+         * 
+         * @par Example Usage:
+         * @code
+         * filters::Lighting lighting;
+         * lighting.data.resolutionScale = 0.25f;
+         * lighting.data.lights.push_back({ { 40.f, 20.f }, { 255, 200, 120, 255 }, 60.f });
+         * lighting.data.addRectangleOccluder({ { 30.f, 30.f }, { 10.f, 6.f } });
+         * window.postProcessPipeline.addFilter(&lighting).build();
+         * @endcode
+         */
+        struct Lighting : public Filter<Color, Color, LightingData>
+        {
+            /**
+             * @brief Default constructor
+             * 
+             * @details Creates a lighting filter with no lights, leaving only
+             * the ambient color.
+             */
+            Lighting();
+        };
     };
 
     template<typename T>
@@ -959,6 +1046,7 @@ namespace til
     void Filter<InputType, OutputType, FilterData>::setBaseData(const filters::BaseData &baseData) {
         data.time = baseData.time;
         data.buffer_resized = baseData.buffer_resized;
+        data.bufferSize = baseData.bufferSize;
     }
 
     template<typename InputType, typename OutputType, typename FilterData>
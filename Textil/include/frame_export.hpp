@@ -0,0 +1,113 @@
+/**
+ * @file frame_export.hpp
+ * @brief Shared-memory frame export for Textil library
+ * @details Provides the SharedFrameExporter class, which publishes presented frames into a
+ *          POSIX shared-memory ring that other local processes read with SharedFrameReader.
+ */
+
+#ifndef TIL_FRAME_EXPORT_HPP
+#define TIL_FRAME_EXPORT_HPP
+
+#include "shared_frame.hpp"
+#include "character_cell.hpp"
+#include "render.hpp"
+#include <span>
+
+namespace til
+{
+    /**
+     * @brief Publishes frames into a shared-memory ring
+     *
+     * @details Each published frame goes into the next slot of a ring of
+     * slotCount slots, guarded by a per-slot seqlock, and then becomes the
+     * latest frame. Publishing never waits for readers; a reader still using a
+     * slot when the writer comes around again detects it through the seqlock.
+     * Layout and reader are in shared_frame.hpp.
+     *
+     * Frames hold the composed character cells and, if a pixel source is set,
+     * a copy of that target's pixel buffer. Both are clipped to the capacity
+     * given to open(). The Console publishes every presented frame when an
+     * exporter is set with Console::setFrameExporter().
+     *
+     * Available on Linux and macOS.
+     *
+     * @par Example Usage:
+     * @code
+     * SharedFrameExporter exporter;
+     * exporter.open("/textil-frames", { 320, 100 }, { 320, 100 });
+     * exporter.setPixelSource(&window);
+     * framework.console.setFrameExporter(&exporter);
+     * @endcode
+     */
+    class SharedFrameExporter
+    {
+    public:
+
+        SharedFrameExporter() = default;
+
+        /**
+         * @brief Unmap and remove the shared memory object
+         */
+        ~SharedFrameExporter();
+
+        SharedFrameExporter(const SharedFrameExporter &) = delete;
+        SharedFrameExporter &operator=(const SharedFrameExporter &) = delete;
+
+        /**
+         * @brief Create the shared memory ring
+         * @details Closes any open ring first. An existing frame ring with the same name, such as
+         *          one left behind by a crashed exporter, is replaced; any other object is kept.
+         * @param name Shared memory object name, starting with a slash
+         * @param maxCells Largest frame in character cells
+         * @param maxPixels Largest pixel buffer, zero to export cells only
+         * @param slotCount Number of frames kept in the ring
+         * @throws InvalidArgumentError If slotCount is zero
+         * @throws SharedMemoryError If the shared memory object cannot be created or mapped, or the name is taken by an object that is not a frame ring
+         */
+        void open(const std::string &name, const Vector2<u32> &maxCells, const Vector2<u32> &maxPixels = { 0u, 0u }, u32 slotCount = 4);
+
+        /**
+         * @brief Unmap and remove the shared memory object
+         */
+        void close();
+
+        /**
+         * @brief Check whether a ring is open
+         * @return True between a successful open() and close()
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Set the render target whose pixels accompany each frame
+         * @param target Target to copy, nullptr for cells only; must outlive the exporter or be unset
+         */
+        void setPixelSource(RenderTarget *target);
+
+        /**
+         * @brief Publish a frame
+         * @param cells Character cells in row-major order, at least size.x * size.y of them
+         * @param size Width and height of the frame in cells
+         * @throws InvalidArgumentError If cells holds fewer than size.x * size.y cells
+         * @throws LogicError If the pixel source's pixels are locked
+         */
+        void publish(std::span<const CharacterCell> cells, const Vector2<u32> &size);
+
+        /**
+         * @brief Get the sequence of the last published frame
+         * @return Sequence number, 0 before the first frame
+         */
+        u64 getSequence() const;
+
+    private:
+
+        std::string m_name {};                 ///< Shared memory object name
+        u8 *m_memory = nullptr;                ///< Mapped ring
+        std::size_t m_size = 0;                ///< Mapped bytes
+        Vector2<u32> m_maxCells { 0u, 0u };    ///< Cell capacity per frame
+        Vector2<u32> m_maxPixels { 0u, 0u };   ///< Pixel capacity per frame
+        u64 m_sequence = 0;                    ///< Last published sequence
+        RenderTarget *m_pixelSource = nullptr; ///< Target copied with each frame
+    };
+}
+
+#endif // TIL_FRAME_EXPORT_HPP
@@ -0,0 +1,256 @@
+/**
+ * @file graphics_output.hpp
+ * @brief Pixel graphics output through terminal image protocols for Textil library
+ * @details Provides encoders for the kitty graphics protocol and for sixel, and the
+ *          GraphicsPresenter, which sends the changed regions of windows to the terminal
+ *          as images from a background thread. Terminals such as kitty, WezTerm and foot
+ *          display these at full pixel resolution instead of one color per character cell.
+ */
+
+#ifndef TIL_GRAPHICS_OUTPUT_HPP
+#define TIL_GRAPHICS_OUTPUT_HPP
+
+#include "window.hpp"
+#include "rect.hpp"
+#include "broadcast.hpp"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace til
+{
+    /**
+     * @brief Terminal protocol used to display window pixels
+     */
+    enum class GraphicsProtocol
+    {
+        None,   ///< Character cells produced by the character pipeline
+        Kitty,  ///< Kitty graphics protocol with raw RGBA data
+        Sixel   ///< Sixel with a fixed 252-color palette
+    };
+
+    /**
+     * @brief Pixels of one window to be sent to the terminal
+     */
+    struct GraphicsUpdate
+    {
+        u32 imageId = 0;                     ///< Terminal image id, the window id
+        Vector2<i32> cellPosition { 0, 0 };  ///< Screen cell of the image's top-left corner
+        Vector2<u32> imageSize { 0u, 0u };   ///< Full image dimensions in pixels
+        Rect<u32> region {};                 ///< Region of the image carried by pixels
+        bool replace = true;                 ///< Transmit and place the whole image instead of editing it
+        std::vector<Color> pixels {};        ///< Region pixels in row-major order
+    };
+
+    /**
+     * @brief Append the kitty graphics commands for an update
+     * @details A replacing update moves the cursor to the image cell and transmits
+     *          the whole image with a=T, replacing any image and placement with the
+     *          same id. Other updates edit the displayed frame in place with a=f,
+     *          overwriting only the region. Data is base64 encoded and split into
+     *          chunks of at most 4096 bytes; responses are suppressed with q=2.
+     * @param update Update to encode
+     * @param output String the escape sequences are appended to
+     */
+    void encodeKittyGraphics(const GraphicsUpdate &update, std::string &output);
+
+    /**
+     * @brief Append the sixel image for an update
+     * @details Colors are quantized to a 6x7x6 RGB cube. Only palette registers
+     *          used by the region are defined, transparent pixels are left unset so
+     *          the terminal keeps what was there, and bands of six rows are encoded
+     *          in parallel with run-length compression.
+     * @param update Update to encode; region must start on a cell boundary unless it starts at the image origin
+     * @param cellPixelSize Size of a terminal cell in pixels, used to position the region
+     * @param output String the escape sequences are appended to
+     */
+    void encodeSixelGraphics(const GraphicsUpdate &update, const Vector2<u32> &cellPixelSize, std::string &output);
+
+    /**
+     * @brief Sends window pixels to the terminal as images
+     *
+     * @details submit() adds a window to the next frame. present() takes a
+     * snapshot of the part of each submitted window that changed since it was
+     * last presented, using the window's dirty region, clears the dirty
+     * region and hands the snapshots to the presenter thread, which
+     * encodes them and passes the bytes to the sink while the caller renders
+     * the next frame. At most one frame is in flight: present() first waits for
+     * the previous one.
+     *
+     * A window whose position or size changed, or that was not seen before, is
+     * sent whole. With sixel, a changed layout or a vanished window clears the
+     * screen and resends every window, since sixel pixels cannot be removed
+     * individually; with kitty, images of vanished windows are deleted.
+     * Sixel edits are widened to whole cells and need the cell size in pixels;
+     * while it is unknown every sixel update covers the whole window.
+     *
+     * A frame is a keyframe when it does not depend on earlier frames: the
+     * first frame after setProtocol() or invalidate(), and any frame presented
+     * while the broadcaster set with setBroadcaster() waits for one. A keyframe
+     * clears the screen (and deletes all kitty images) and sends every window
+     * whole. Each encoded frame is also passed to the broadcaster.
+     *
+     * The sink receives the encoded bytes of one frame at a time and writes
+     * them to standard output by default. A custom sink makes the presenter
+     * usable without a terminal, for example to compare output byte for byte.
+     *
+     * @par Example Usage:
+     * @code
+     * std::string bytes;
+     * GraphicsPresenter presenter;
+     * presenter.setProtocol(GraphicsProtocol::Kitty);
+     * presenter.setSink([&bytes](const std::string &frame) { bytes += frame; });
+     *
+     * presenter.submit(window);
+     * presenter.present();
+     * presenter.finish();  // bytes now holds the frame
+     * @endcode
+     */
+    class GraphicsPresenter
+    {
+    public:
+
+        /**
+         * @brief Signature of the output sink
+         */
+        using Sink = std::function<void(const std::string &)>;
+
+        /**
+         * @brief Create a presenter with no protocol, writing to standard output
+         */
+        GraphicsPresenter();
+
+        /**
+         * @brief Finish the frame in flight and stop the presenter thread
+         */
+        ~GraphicsPresenter();
+
+        GraphicsPresenter(const GraphicsPresenter &) = delete;
+        GraphicsPresenter &operator=(const GraphicsPresenter &) = delete;
+
+        /**
+         * @brief Select the protocol
+         * @details Finishes the frame in flight and forgets every known image,
+         *          so the next frame sends all windows whole.
+         * @param protocol Protocol of subsequent frames
+         */
+        void setProtocol(GraphicsProtocol protocol);
+
+        /**
+         * @brief Get the selected protocol
+         * @return Current protocol
+         */
+        GraphicsProtocol getProtocol() const;
+
+        /**
+         * @brief Set the size of a terminal cell in pixels
+         * @param size Cell width and height, zero if unknown
+         */
+        void setCellPixelSize(const Vector2<u32> &size);
+
+        /**
+         * @brief Get the size of a terminal cell in pixels
+         * @return Cell width and height, zero if unknown
+         */
+        const Vector2<u32> &getCellPixelSize() const;
+
+        /**
+         * @brief Replace the output sink
+         * @details Finishes the frame in flight first. The sink is called on the presenter thread.
+         * @param sink Function receiving the bytes of each frame
+         */
+        void setSink(Sink sink);
+
+        /**
+         * @brief Also send every encoded frame to a broadcaster
+         * @details Finishes the frame in flight first.
+         * @param broadcaster Broadcaster to feed, nullptr to stop; must outlive the presenter or be unset
+         */
+        void setBroadcaster(FrameBroadcaster *broadcaster);
+
+        /**
+         * @brief Make the next frame a keyframe
+         */
+        void invalidate();
+
+        /**
+         * @brief Add a window to the next frame
+         * @details The window must stay alive until present().
+         * @param window Window to send
+         */
+        void submit(Window &window);
+
+        /**
+         * @brief Snapshot the submitted windows and send them to the presenter thread
+         * @details Clears the dirty region of every submitted window. Windows with
+         *          no changes and an unchanged layout add nothing to the frame.
+         *          Windows that were presented before but not submitted since are
+         *          considered closed. Does nothing if the protocol is None.
+         * @throws LogicError If the pixels of a submitted window are locked
+         */
+        void present();
+
+        /**
+         * @brief Wait until the frame in flight was written to the sink
+         */
+        void finish();
+
+    private:
+
+        /**
+         * @brief What was last sent for a window
+         */
+        struct ImageState
+        {
+            Vector2<i32> cellPosition { 0, 0 };  ///< Screen cell of the image
+            Vector2<u32> size { 0u, 0u };        ///< Image dimensions in pixels
+        };
+
+        /**
+         * @brief Body of the presenter thread
+         */
+        void presentLoop();
+
+        /**
+         * @brief Copy a region of a window into an update
+         */
+        static GraphicsUpdate takeSnapshot(Window &window, const Rect<u32> &region, bool replace);
+
+        /**
+         * @brief Widen a region to whole terminal cells, clipped to the image
+         */
+        Rect<u32> alignToCells(const Rect<u32> &region, const Vector2<u32> &imageSize) const;
+
+        /**
+         * @brief Encode the frame in flight into m_encoded
+         */
+        void encodeFrame();
+
+        GraphicsProtocol m_protocol = GraphicsProtocol::None;  ///< Selected protocol
+        Vector2<u32> m_cellPixelSize { 0u, 0u };                ///< Cell size in pixels, zero if unknown
+        std::unordered_map<u32, ImageState> m_images {};        ///< Images on screen by window id
+        std::vector<Window *> m_submitted {};                   ///< Windows of the next frame
+        bool m_keyframePending = true;                          ///< Whether the next frame must be a keyframe
+        FrameBroadcaster *m_broadcaster = nullptr;              ///< Receives every encoded frame
+
+        std::vector<GraphicsUpdate> m_inFlight {};  ///< Updates of the frame being encoded
+        std::vector<u32> m_deletedImages {};        ///< Kitty images to delete in the frame being encoded
+        GraphicsProtocol m_frameProtocol = GraphicsProtocol::None;  ///< Protocol of the frame being encoded
+        Vector2<u32> m_frameCellPixelSize { 0u, 0u };               ///< Cell size of the frame being encoded
+        bool m_clearScreen = false;                 ///< Whether the frame being encoded starts with a screen clear
+        bool m_keyframe = false;                    ///< Whether the frame being encoded is a keyframe
+        bool m_busy = false;                        ///< Whether a frame is in flight
+        bool m_stop = false;                        ///< Asks the presenter thread to exit
+        std::string m_encoded {};                   ///< Bytes of the frame being encoded
+        Sink m_sink;                                ///< Destination of the encoded bytes
+        std::mutex m_mutex;                         ///< Guards the in-flight state above
+        std::condition_variable m_condition;        ///< Signals new frames and finished frames
+        std::thread m_presenter;                    ///< Presenter thread
+    };
+}
+
+#endif // TIL_GRAPHICS_OUTPUT_HPP
@@ -0,0 +1,210 @@
+/**
+ * @file path.hpp
+ * @brief Vector paths with adaptive curve flattening and stroke tessellation
+ * @details Provides the Path class for describing outlines made of lines, Bezier curves and
+ *          circular arcs, and the functions that turn such outlines into renderable geometry.
+ *          Curves are flattened into polylines with a segment count derived from a distance
+ *          tolerance, and polylines are stroked into triangle meshes with configurable joins and caps.
+ */
+
+#ifndef TIL_PATH_HPP
+#define TIL_PATH_HPP
+
+#include "render.hpp"
+#include "vector2.hpp"
+#include "numeric_types.hpp"
+#include <vector>
+
+namespace til
+{
+    /**
+     * @brief Shape used where two stroked segments meet
+     */
+    enum class LineJoin : u8
+    {
+        Miter,  ///< Extend the outer edges until they meet, falling back to Bevel past the miter limit
+        Bevel,  ///< Connect the outer corners with a straight edge
+        Round   ///< Connect the outer corners with a circular arc
+    };
+
+    /**
+     * @brief Shape used at the open ends of a stroked contour
+     */
+    enum class LineCap : u8
+    {
+        Butt,   ///< End the stroke exactly at the end point
+        Square, ///< Extend the stroke by half its width past the end point
+        Round   ///< Close the stroke with a half disc around the end point
+    };
+
+    /**
+     * @brief Parameters controlling how a path is stroked
+     */
+    struct StrokeStyle
+    {
+        f32 width = 1.f;                 ///< Stroke width in path units
+        LineJoin join = LineJoin::Miter; ///< Join between consecutive segments
+        LineCap cap = LineCap::Butt;     ///< Cap at both ends of open contours
+        f32 miterLimit = 4.f;            ///< Maximum ratio of miter length to half the width before a miter is beveled
+
+        bool operator==(const StrokeStyle &other) const = default;
+    };
+
+    /**
+     * @brief Polyline produced by flattening one subpath
+     */
+    struct PathContour
+    {
+        std::vector<Vector2<f32>> points; ///< Polyline vertices without consecutive duplicates
+        bool closed = false;              ///< Whether the last point connects back to the first
+    };
+
+    /**
+     * @brief Outline built from lines, quadratic and cubic Bezier curves and arcs
+     *
+     * @details A path is a sequence of subpaths, each started by moveTo() and
+     * optionally closed by close(). The path only records commands; curves
+     * are approximated by straight segments when the path is flattened, so the
+     * same path can be tessellated at whatever precision the current on-screen
+     * size requires.
+     *
+     * Every modification assigns the path a new version number, which lets
+     * consumers cache geometry derived from the path until it changes.
+     *
+     * @par Example Usage:
+     * @code
+     * Path path;
+     * path.moveTo({0, 0});
+     * path.lineTo({40, 0});
+     * path.quadTo({60, 0}, {60, 20});
+     * path.cubicTo({60, 40}, {20, 40}, {0, 20});
+     * path.close();
+     * @endcode
+     */
+    class Path
+    {
+    public:
+
+        /**
+         * @brief Start a new subpath
+         * @param point First point of the subpath
+         */
+        void moveTo(const Vector2<f32> &point);
+
+        /**
+         * @brief Add a straight segment from the current point
+         * @param point End point of the segment
+         * @details Starts a new subpath at @p point if there is no current point.
+         */
+        void lineTo(const Vector2<f32> &point);
+
+        /**
+         * @brief Add a quadratic Bezier curve from the current point
+         * @param control Control point of the curve
+         * @param point End point of the curve
+         */
+        void quadTo(const Vector2<f32> &control, const Vector2<f32> &point);
+
+        /**
+         * @brief Add a cubic Bezier curve from the current point
+         * @param control1 First control point of the curve
+         * @param control2 Second control point of the curve
+         * @param point End point of the curve
+         */
+        void cubicTo(const Vector2<f32> &control1, const Vector2<f32> &control2, const Vector2<f32> &point);
+
+        /**
+         * @brief Add a circular arc tangent to two lines
+         * @param corner Corner point shared by both tangent lines
+         * @param point Point defining the direction of the second tangent line
+         * @param radius Radius of the arc
+         * @details Follows the HTML canvas arcTo() semantics: the arc is tangent to the
+         *          line from the current point to @p corner and to the line from @p corner
+         *          to @p point. A straight segment joins the current point to the start of
+         *          the arc and the arc's end becomes the new current point. Degenerate input
+         *          (zero radius or collinear points) adds a straight segment to @p corner.
+         */
+        void arcTo(const Vector2<f32> &corner, const Vector2<f32> &point, f32 radius);
+
+        /**
+         * @brief Close the current subpath
+         * @details Connects the current point back to the first point of the subpath.
+         *          A following drawing command without moveTo() continues from that point.
+         */
+        void close();
+
+        /**
+         * @brief Remove all commands from the path
+         */
+        void clear();
+
+        /**
+         * @brief Check whether the path has any commands
+         * @return True if no command was added since construction or the last clear()
+         */
+        bool isEmpty() const;
+
+        /**
+         * @brief Get the version number of the path
+         * @return Number that changes whenever the path is modified
+         * @details Versions are unique across all paths, so a cache keyed by the version
+         *          also notices when one path is replaced by another.
+         */
+        u64 getVersion() const;
+
+        /**
+         * @brief Get a box enclosing the path
+         * @return Box enclosing all points, control points and arcs, empty if the path is empty
+         * @details Curves lie inside the hull of their control points, so the box
+         *          encloses the flattened path at any tolerance without flattening it.
+         */
+        Rect<f32> getBounds() const;
+
+        /**
+         * @brief Approximate the path with polylines
+         * @param tolerance Maximum distance between a curve and its approximation, in path units
+         * @param contours Receives one contour per subpath (cleared first)
+         * @details The number of segments per curve is computed in closed form from the
+         *          tolerance (Wang's formula for Bezier curves, the sagitta for arcs), so the
+         *          work depends on the size of the curve rather than on its control points.
+         */
+        void flatten(f32 tolerance, std::vector<PathContour> &contours) const;
+
+    private:
+
+        enum class Verb : u8
+        {
+            MoveTo,
+            LineTo,
+            QuadTo,
+            CubicTo,
+            Arc,
+            Close
+        };
+
+        void addVerb(Verb verb);
+        void ensureSubpath();
+
+        std::vector<Verb> m_verbs {};           ///< Recorded commands
+        std::vector<Vector2<f32>> m_points {};  ///< Command operands, consumed in command order
+        Vector2<f32> m_currentPoint {};         ///< End point of the last command
+        Vector2<f32> m_subpathStart {};         ///< First point of the current subpath
+        bool m_hasCurrentPoint = false;         ///< Whether a subpath has been started
+        bool m_subpathClosed = false;           ///< Whether the current subpath was closed
+        u64 m_version = 0;                      ///< Version number of the current contents
+    };
+
+    /**
+     * @brief Tessellate polylines into a stroke triangle mesh
+     * @param contours Polylines to stroke
+     * @param style Width, joins and caps of the stroke
+     * @param tolerance Maximum deviation of round joins and caps from true circles, in path units
+     * @param vertices Receives the triangles of the stroke, three vertices each (appended)
+     * @details Every segment becomes a quad, and joins and caps are added as separate
+     *          triangles, so overlapping parts of the stroke are covered more than once.
+     *          UV x runs from 0 to 1 along each contour and UV y from 0 to 1 across the stroke.
+     */
+    void strokePath(const std::vector<PathContour> &contours, const StrokeStyle &style, f32 tolerance, std::vector<primitives::Vertex> &vertices);
+}
+
+#endif // TIL_PATH_HPP
@@ -0,0 +1,227 @@
+/**
+ * @file raycaster.hpp
+ * @brief Grid raycasting renderer for Textil library
+ * @details Provides the Raycaster class, which renders a first-person view of a 2D grid map
+ *          in the style of classic raycasting engines: textured walls found with a DDA walk,
+ *          textured floor and ceiling, and billboard sprites clipped against a per-column
+ *          depth buffer. Rays are cast in SIMD packets, columns and rows are processed in
+ *          parallel, and pixels are written straight into the render target.
+ */
+
+#ifndef TIL_RAYCASTER_HPP
+#define TIL_RAYCASTER_HPP
+
+#include "render.hpp"
+#include "texture.hpp"
+#include "vector2.hpp"
+#include <vector>
+
+namespace til
+{
+    /**
+     * @brief First-person renderer for grid maps
+     *
+     * @details The map is a grid of cell ids: 0 is empty space, any other id is
+     * a solid wall drawn with the texture or color assigned to that id. Map
+     * coordinates place cell (x, y) at [x, x + 1) x [y, y + 1); positions
+     * outside the map are empty and rays leaving the map hit nothing.
+     *
+     * render() fills the whole target in two passes. First every column casts
+     * one ray, four columns at a time with SSE when available, and records the
+     * wall it hits. Then rows are filled in parallel: wall texels where a
+     * column's wall covers the row, and floor or ceiling texels elsewhere. The
+     * perpendicular wall distance of every column is kept as a depth buffer,
+     * which renderSprite() uses to hide sprites behind walls.
+     *
+     * Textures are sampled with nearest-neighbor filtering and are expected
+     * to stay alive and unchanged in size while they are assigned.
+     *
+     * @par Example Usage:
+     * @code
+     * Raycaster raycaster;
+     * raycaster.setMap({ 16, 16 }, level);
+     * raycaster.setWallTexture(1, &brick);
+     * raycaster.setWallColor(2, { 60, 190, 210, 255 });
+     * raycaster.floorTexture = &stone;
+     *
+     * Raycaster::Camera camera = Raycaster::Camera::fromAngle(player.position, player.angle);
+     * raycaster.render(window, camera);
+     * raycaster.renderSprite(window, camera, barrel.position, barrelTexture);
+     * @endcode
+     */
+    class Raycaster
+    {
+    public:
+
+        /**
+         * @brief Viewpoint of a rendered frame
+         */
+        struct Camera
+        {
+            Vector2<f32> position { 0.f, 0.f };   ///< Eye position in map coordinates
+            Vector2<f32> direction { 1.f, 0.f };  ///< View direction, its length sets the focal distance
+            Vector2<f32> plane { 0.f, 0.66f };    ///< Half-width of the image plane, perpendicular to direction
+
+            /**
+             * @brief Create a camera looking along an angle
+             * @param position Eye position in map coordinates
+             * @param angle View angle in radians, 0 looks along +x
+             * @param planeScale Ratio of image plane half-width to focal distance, 0.66 gives about 66 degrees
+             * @return Camera with a unit direction
+             */
+            static Camera fromAngle(const Vector2<f32> &position, f32 angle, f32 planeScale = 0.66f);
+        };
+
+        /**
+         * @brief Result of a single ray cast
+         */
+        struct RayHit
+        {
+            f32 distance = 0.f;                ///< Distance along the ray in ray direction lengths
+            u32 cell = 0;                      ///< Id of the cell that was hit
+            Vector2<i32> mapPosition { 0, 0 }; ///< Coordinates of the cell that was hit
+            bool side = false;                 ///< True if a horizontal (y) face was hit
+            f32 wallX = 0.f;                   ///< Hit position along the face, in [0, 1)
+        };
+
+        Texture *floorTexture = nullptr;            ///< Floor texture repeated per cell, or nullptr for floorColor
+        Texture *ceilingTexture = nullptr;          ///< Ceiling texture repeated per cell, or nullptr for ceilingColor
+        Color floorColor { 55, 48, 38, 255 };       ///< Floor color when no floor texture is set
+        Color ceilingColor { 30, 60, 120, 255 };    ///< Ceiling color when no ceiling texture is set
+
+        f32 distanceFalloff = 0.18f;   ///< Brightness falloff with distance, 0 disables distance shading
+        f32 minimumBrightness = 0.18f; ///< Darkest brightness distance shading reaches
+        f32 sideBrightness = 0.75f;    ///< Extra brightness factor for horizontal wall faces
+
+        /**
+         * @brief Create a raycaster with an empty map
+         */
+        Raycaster() = default;
+
+        /**
+         * @brief Replace the map
+         * @param size Map dimensions in cells
+         * @param cells Cell ids in row-major order
+         * @throws InvalidArgumentError If the cell count does not match the size
+         */
+        void setMap(const Vector2<u32> &size, const std::vector<u32> &cells);
+
+        /**
+         * @brief Get the map dimensions
+         * @return Width and height in cells
+         */
+        const Vector2<u32> &getMapSize() const;
+
+        /**
+         * @brief Get the id of a cell
+         * @param x Cell column
+         * @param y Cell row
+         * @return Cell id, 0 for cells outside the map
+         */
+        u32 getCell(i32 x, i32 y) const;
+
+        /**
+         * @brief Set the id of a cell
+         * @param position Cell coordinates
+         * @param cell New cell id, 0 for empty space
+         * @throws InvalidArgumentError If the position is outside the map
+         */
+        void setCell(const Vector2<u32> &position, u32 cell);
+
+        /**
+         * @brief Assign a texture to a wall id
+         * @param cell Wall id, must not be 0
+         * @param texture Texture drawn on every face of the wall, or nullptr to use its color
+         * @throws InvalidArgumentError If the id is 0
+         */
+        void setWallTexture(u32 cell, Texture *texture);
+
+        /**
+         * @brief Assign a flat color to a wall id
+         * @details Used for walls without a texture.
+         * @param cell Wall id, must not be 0
+         * @param color Wall color
+         * @throws InvalidArgumentError If the id is 0
+         */
+        void setWallColor(u32 cell, const Color &color);
+
+        /**
+         * @brief Cast a single ray through the map
+         * @param origin Ray start in map coordinates
+         * @param direction Ray direction, need not be normalized
+         * @param hit Receives the hit when one is found
+         * @return True if the ray hit a wall before leaving the map
+         */
+        bool castRay(const Vector2<f32> &origin, const Vector2<f32> &direction, RayHit &hit) const;
+
+        /**
+         * @brief Render walls, floor and ceiling over the whole target
+         * @param target The render target to draw onto
+         * @param camera Viewpoint of the frame
+         * @throws LogicError If the target pixels are already locked
+         */
+        void render(RenderTarget &target, const Camera &camera);
+
+        /**
+         * @brief Render a billboard sprite standing on the floor
+         * @details Must follow render() for the same target size and camera.
+         * Sprite columns behind the wall of their screen column are skipped and
+         * texels with zero alpha are transparent. Draw sprites far to near.
+         * @param target The render target to draw onto
+         * @param camera Viewpoint used for the last render()
+         * @param position Sprite position in map coordinates
+         * @param texture Sprite image
+         * @param scale Sprite height relative to a wall
+         * @throws LogicError If the target pixels are already locked or the last render() used another width
+         */
+        void renderSprite(RenderTarget &target, const Camera &camera, const Vector2<f32> &position, const Texture &texture, f32 scale = 1.f);
+
+        /**
+         * @brief Get the wall distance of every column from the last render()
+         * @return Perpendicular distance per column, infinity where no wall was hit
+         */
+        const std::vector<f32> &getDepthBuffer() const;
+
+    private:
+
+        /**
+         * @brief Appearance of a wall id
+         */
+        struct WallMaterial
+        {
+            Texture *texture = nullptr;           ///< Texture of the wall, or nullptr for color
+            Color color { 210, 210, 210, 255 };   ///< Color used without a texture
+        };
+
+        /**
+         * @brief Cast the rays of columns [first, first + count) and store their hits
+         */
+        void castColumns(const Camera &camera, u32 first, u32 count, u32 width);
+
+        /**
+         * @brief Store the hit of one column, or no hit
+         */
+        void storeColumn(u32 column, const Vector2<f32> &origin, const Vector2<f32> &direction, bool hit, u32 cell, bool side, f32 distance);
+
+        /**
+         * @brief Get the material of a wall id, growing the table if needed
+         */
+        WallMaterial &getMaterial(u32 cell);
+
+        /**
+         * @brief Brightness for a distance
+         */
+        f32 getBrightness(f32 distance) const;
+
+        Vector2<u32> m_mapSize { 0u, 0u };          ///< Map dimensions in cells
+        std::vector<u32> m_cells {};                ///< Cell ids in row-major order
+        std::vector<WallMaterial> m_materials {};   ///< Material of each wall id
+
+        std::vector<f32> m_depth {};                ///< Perpendicular wall distance per column
+        std::vector<u32> m_columnCells {};          ///< Wall id per column, 0 for no hit
+        std::vector<f32> m_columnWallX {};          ///< Texture coordinate along the wall per column
+        std::vector<f32> m_columnBrightness {};     ///< Wall shading per column
+    };
+}
+
+#endif // TIL_RAYCASTER_HPP
@@ -0,0 +1,156 @@
+/**
+ * @file rect.hpp
+ * @brief Axis-aligned rectangles for Textil library
+ * @details Provides a templated Rect class describing a region by its top-left corner and
+ *          size, used for pixel regions, clipping and bounding boxes.
+ */
+
+#ifndef TIL_RECT_HPP
+#define TIL_RECT_HPP
+
+#include <algorithm>
+#include "numeric_types.hpp"
+#include "vector2.hpp"
+
+namespace til
+{
+    /**
+     * @brief An axis-aligned rectangle
+     * @tparam T The numeric type for coordinates (must satisfy arithmetic concept)
+     * @details The rectangle covers the half-open range [position, position + size) on
+     *          both axes, so rectangles sharing an edge do not intersect and a rectangle
+     *          with a zero width or height is empty.
+     */
+    template<arithmetic T>
+    class Rect
+    {
+    public:
+        Vector2<T> position; ///< Top-left corner
+        Vector2<T> size;     ///< Width and height
+
+        /**
+         * @brief Default constructor creating an empty rectangle at the origin
+         */
+        Rect() = default;
+
+        /**
+         * @brief Construct rectangle from its corner and size
+         * @param position Top-left corner
+         * @param size Width and height
+         */
+        Rect(const Vector2<T> &position, const Vector2<T> &size);
+
+        /**
+         * @brief Check whether the rectangle covers no area
+         * @return True if the width or height is not positive
+         */
+        bool isEmpty() const;
+
+        /**
+         * @brief Get the corner opposite to position
+         * @return position + size, just outside the covered range
+         */
+        Vector2<T> getEnd() const;
+
+        /**
+         * @brief Check whether a point lies inside the rectangle
+         * @param point Point to test
+         * @return True if position <= point < position + size on both axes
+         */
+        bool contains(const Vector2<T> &point) const;
+
+        /**
+         * @brief Check whether two rectangles overlap
+         * @param other Rectangle to test against
+         * @return True if the rectangles share a region of positive area
+         */
+        bool intersects(const Rect<T> &other) const;
+
+        /**
+         * @brief Get the overlapping region of two rectangles
+         * @param other Rectangle to intersect with
+         * @return The shared region, or an empty rectangle if they do not overlap
+         */
+        Rect<T> getIntersection(const Rect<T> &other) const;
+
+        /**
+         * @brief Get the smallest rectangle enclosing both rectangles
+         * @param other Rectangle to enclose
+         * @return Bounding rectangle of both; empty rectangles are ignored
+         */
+        Rect<T> getUnion(const Rect<T> &other) const;
+
+        /**
+         * @brief Equality comparison operator
+         * @param other Rectangle to compare with
+         * @return True if both corner and size are equal
+         */
+        bool operator==(const Rect<T> &other) const;
+
+        /**
+         * @brief Inequality comparison operator
+         * @param other Rectangle to compare with
+         * @return True if corner or size differ
+         */
+        bool operator!=(const Rect<T> &other) const;
+    };
+
+    template<arithmetic T>
+    Rect<T>::Rect(const Vector2<T> &position, const Vector2<T> &size) : position(position), size(size) {}
+
+    template<arithmetic T>
+    bool Rect<T>::isEmpty() const {
+        return size.x <= T(0) || size.y <= T(0);
+    }
+
+    template<arithmetic T>
+    Vector2<T> Rect<T>::getEnd() const {
+        return position + size;
+    }
+
+    template<arithmetic T>
+    bool Rect<T>::contains(const Vector2<T> &point) const {
+        return point.x >= position.x && point.y >= position.y &&
+               point.x < position.x + size.x && point.y < position.y + size.y;
+    }
+
+    template<arithmetic T>
+    bool Rect<T>::intersects(const Rect<T> &other) const {
+        return !getIntersection(other).isEmpty();
+    }
+
+    template<arithmetic T>
+    Rect<T> Rect<T>::getIntersection(const Rect<T> &other) const {
+        const Vector2<T> start { std::max(position.x, other.position.x), std::max(position.y, other.position.y) };
+        const Vector2<T> end { std::min(position.x + size.x, other.position.x + other.size.x), std::min(position.y + size.y, other.position.y + other.size.y) };
+
+        if (end.x <= start.x || end.y <= start.y) {
+            return Rect<T>();
+        }
+
+        return Rect<T>(start, end - start);
+    }
+
+    template<arithmetic T>
+    Rect<T> Rect<T>::getUnion(const Rect<T> &other) const {
+        if (isEmpty()) return other;
+        if (other.isEmpty()) return *this;
+
+        const Vector2<T> start { std::min(position.x, other.position.x), std::min(position.y, other.position.y) };
+        const Vector2<T> end { std::max(position.x + size.x, other.position.x + other.size.x), std::max(position.y + size.y, other.position.y + other.size.y) };
+
+        return Rect<T>(start, end - start);
+    }
+
+    template<arithmetic T>
+    bool Rect<T>::operator==(const Rect<T> &other) const {
+        return position == other.position && size == other.size;
+    }
+
+    template<arithmetic T>
+    bool Rect<T>::operator!=(const Rect<T> &other) const {
+        return !(*this == other);
+    }
+}
+
+#endif // TIL_RECT_HPP
@@ -8,7 +8,7 @@
  * and filter pipelines for advanced visual effects.
  * 
  * The rendering architecture consists of:
- * - Primitive types for basic geometry (Vertex, Line, Ellipse, TriangleMesh)
+ * - Primitive types for basic geometry (Vertex, Line, LineList, LineStrip, Ellipse, TriangleMesh)
  * - Draw call management with depth sorting
  * - Render targets for output abstraction
  * - Renderer class for primitive processing
@@ -32,15 +32,21 @@
 #include "numeric_types.hpp"
 #include "vector2.hpp"
 #include <vector>
-#include <variant>
 #include <span>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 #include "filters.hpp"
 #include "transform.hpp"
+#include "affine_matrix.hpp"
+#include "rect.hpp"
+#include "batch_transform.hpp"
 #include "filter_pipeline.hpp"
 
 namespace til
 {
     class Renderer;
+    class FragmentRecording;
 
     /**
      * @brief Enumeration of supported primitive types for rendering
@@ -54,7 +60,26 @@ namespace til
         Vertex,        ///< Single point/vertex primitive
         Line,          ///< Line segment between two points
         Ellipse,       ///< Elliptical/circular shape with automatic tessellation
-        TriangleMesh   ///< Collection of triangles from vertex buffer
+        TriangleMesh,  ///< Collection of triangles from vertex buffer
+        LineList,      ///< Independent line segments from vertex buffer
+        LineStrip,     ///< Connected polyline from vertex buffer
+        FragmentPass,  ///< Every pixel of a screen-space region, without rasterization
+        BeginRecording,///< Start capturing blended fragments into a FragmentRecording
+        EndRecording,  ///< Stop capturing blended fragments
+        Replay         ///< Blend the fragments of a finished FragmentRecording
+    };
+
+    /**
+     * @brief Enumeration of triangle rasterization strategies
+     * 
+     * @details Selects how the renderer decides which pixels a triangle
+     * covers. Both modes sample at integer pixel positions and apply a
+     * top-left fill rule; they differ in the arithmetic used to do so.
+     */
+    enum class RasterizationMode : u8
+    {
+        FloatingPoint, ///< Float edge functions evaluated independently for every pixel
+        FixedPoint     ///< Vertices snapped to 28.4 fixed point, integer edge functions stepped incrementally
     };
 
     /**
@@ -132,55 +157,503 @@ namespace til
             u32 firstVertex = 0;   ///< Index of the first vertex in the mesh
             u32 vertexCount = 0;   ///< Number of vertices in the mesh
         };
+
+        /**
+         * @brief List of independent line segments referencing vertex buffer
+         * 
+         * @details Every consecutive pair of vertices in the referenced range
+         * forms one segment, so the range must hold an even number of vertices.
+         * All segments are rasterized together in a single pipeline run, which
+         * makes this the primitive of choice for large numbers of lines.
+         */
+        struct LineList
+        {
+            u32 firstVertex = 0;   ///< Index of the first vertex in the list
+            u32 vertexCount = 0;   ///< Number of vertices in the list (two per segment)
+        };
+
+        /**
+         * @brief Connected polyline referencing vertex buffer
+         * 
+         * @details Each vertex in the referenced range is joined to the next
+         * one, so N vertices form N - 1 segments. Pixels shared by consecutive
+         * segments are produced only once.
+         */
+        struct LineStrip
+        {
+            u32 firstVertex = 0;   ///< Index of the first vertex in the strip
+            u32 vertexCount = 0;   ///< Number of vertices in the strip (at least two)
+        };
+
+        /**
+         * @brief Screen-space pass producing one fragment per pixel
+         * 
+         * @details Runs the fragment pipeline over every pixel of the target,
+         * or of a pixel region, without any geometry. Fragment positions are
+         * pixel coordinates, UVs run from 0 at the region's top-left corner
+         * towards 1 at its bottom-right corner, and the fragment size is the
+         * region size. Transforms do not apply to passes. This is the
+         * cheapest way to run full-screen effects and procedural backgrounds.
+         */
+        struct FragmentPass
+        {
+            Rect<i32> region {};      ///< Pixel region to shade, used when fullTarget is false
+            bool fullTarget = true;   ///< Whether to shade the whole target instead of region
+        };
+
+        /**
+         * @brief Reference to a fragment recording
+         * 
+         * @details Payload of the BeginRecording, EndRecording and Replay
+         * draw calls. The recording must outlive the render() call that
+         * processes them.
+         */
+        struct Recording
+        {
+            FragmentRecording *recording = nullptr;  ///< Recording to capture into or replay
+        };
     }
 
     /**
-     * @brief Variant type for primitive data payloads
+     * @brief Fixed-size header preceding every encoded draw command
      * 
-     * @details Type-safe union that can hold any of the supported primitive
-     * types. Used in draw call data structures to store geometry information
-     * in a uniform way while maintaining type safety.
+     * @details Each command stored in a DrawCommandBuffer starts with this
+     * header, followed by the precomputed affine matrix of the draw call and
+     * finally the primitive payload itself. The header carries everything
+     * needed to order and dispatch the command without touching the payload.
      */
-    using DrawPayload = std::variant<
-        primitives::Vertex,
-        primitives::Line,
-        primitives::Ellipse,
-        primitives::TriangleMesh
-    >;
+    struct DrawCommandHeader
+    {
+        u64 sortKey = 0;                                                                        ///< Ordering key combining depth and submission order
+        FilterPipeline<filters::VertexData, filters::VertexData> *fragmentPipeline = nullptr;  ///< Filter pipeline for visual effects
+        u32 size = 0;                                                                           ///< Encoded size of the whole command in bytes
+        u32 drawId = 0;                                                                         ///< Id written to the target's ID buffer
+        BlendMode blendMode = BlendMode::Alpha;                                                 ///< How to blend with existing pixels
+        DrawCallType type = DrawCallType::Vertex;                                               ///< Type of primitive stored in the payload
+    };
 
     /**
-     * @brief Complete data for a single draw call
+     * @brief Packed, variable-length buffer of deferred draw commands
+     * 
+     * @details Stores draw calls back to back in a single byte buffer. Every
+     * command consists of a DrawCommandHeader, the affine matrix computed at
+     * submission time and the primitive payload, padded to 8 bytes. Only the
+     * bytes a primitive actually needs are stored, and no Transform has to be
+     * evaluated again when the command is replayed.
+     * 
+     * Sorting operates on a small array of (key, offset) pairs. Afterwards the
+     * commands are gathered into a second buffer in key order, so the replay
+     * walks memory strictly front to back. When submission order already
+     * matches key order (for example when every call uses the same depth), the
+     * gather step is skipped entirely.
      * 
-     * @details Contains all the information needed to render a primitive,
-     * including geometry, transformation, blending, and effects. This
-     * structure is stored in the render target's draw call pool.
+     * @par Example Usage:
+     * @code
+     * DrawCommandBuffer commands;
+     * commands.push(DrawCallType::Vertex, vertex, AffineMatrix<f32>::identity(), &pipeline, 0.f, BlendMode::Alpha);
      * 
-     * Draw call data is collected during the frame and processed during
-     * the render phase, allowing for depth sorting and batching optimizations.
+     * commands.sort();
+     * commands.forEach([](const DrawCommandHeader &header, const AffineMatrix<f32> &matrix, const std::byte *payload) {
+     *     auto vertex = DrawCommandBuffer::readPayload<primitives::Vertex>(payload);
+     *     // ...
+     * });
+     * @endcode
      */
-    struct DrawCallData
+    class DrawCommandBuffer
     {
-        DrawCallType type;                                                            ///< Type of primitive to render
-        DrawPayload payload;                                                          ///< Geometry data for the primitive
-        Transform transform;                                                          ///< Transformation matrix
-        BlendMode blendMode;                                                          ///< How to blend with existing pixels
-        FilterPipeline<filters::VertexData, filters::VertexData> *fragmentPipeline;  ///< Filter pipeline for visual effects
+    public:
+
+        /**
+         * @brief Encode a draw command at the end of the buffer
+         * 
+         * @tparam Primitive Trivially copyable primitive type
+         * @param type Type tag matching the primitive
+         * @param primitive Primitive payload to store
+         * @param matrix Precomputed transformation matrix
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param depth Depth value for sorting (higher values are replayed first)
+         * @param blendMode How to blend with existing pixels
+         * @param drawId Id written to the ID buffer of the target (default: 0)
+         */
+        template<typename Primitive>
+        void push(DrawCallType type, const Primitive &primitive, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> *fragmentPipeline, f32 depth, BlendMode blendMode, u32 drawId = 0);
+
+        /**
+         * @brief Order the encoded commands by their sort keys
+         * 
+         * @details Commands with higher depth come first. Commands sharing the
+         * same depth keep their submission order.
+         */
+        void sort();
+
+        /**
+         * @brief Visit every command in replay order
+         * 
+         * @tparam Function Callable taking (const DrawCommandHeader &, const AffineMatrix<f32> &, const std::byte *)
+         * @param function Visitor invoked once per command with its header, matrix and payload
+         */
+        template<typename Function>
+        void forEach(Function &&function) const;
+
+        /**
+         * @brief Remove all commands from the buffer
+         * 
+         * @details Keeps the allocated memory so the next frame can reuse it.
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of encoded commands
+         * 
+         * @return Command count
+         */
+        u32 getCommandCount() const;
+
+        /**
+         * @brief Decode a primitive payload
+         * 
+         * @tparam Primitive Primitive type recorded in the command header
+         * @param payload Pointer to the payload passed to the forEach() visitor
+         * @return Copy of the stored primitive
+         */
+        template<typename Primitive>
+        static Primitive readPayload(const std::byte *payload);
+
+        /**
+         * @brief Build the sort key for a command
+         * 
+         * @details The upper 32 bits hold the depth mapped to an unsigned
+         * integer so that higher depths produce smaller keys, the lower 32
+         * bits hold the submission index to keep the ordering stable.
+         * 
+         * @param depth Depth value of the command
+         * @param sequence Submission index of the command
+         * @return Key whose ascending order is the replay order
+         */
+        static u64 makeSortKey(f32 depth, u32 sequence);
+
+    private:
+
+        struct SortEntry
+        {
+            u64 key = 0;     ///< Sort key copied from the command header
+            u32 offset = 0;  ///< Byte offset of the command in the unsorted buffer
+        };
+
+        static constexpr std::size_t commandAlignment = 8;  ///< Alignment of every encoded command
+        static constexpr std::size_t matrixOffset = (sizeof(DrawCommandHeader) + commandAlignment - 1) / commandAlignment * commandAlignment;  ///< Offset of the matrix inside a command
+        static constexpr std::size_t payloadOffset = (matrixOffset + sizeof(AffineMatrix<f32>) + commandAlignment - 1) / commandAlignment * commandAlignment;  ///< Offset of the payload inside a command
+
+        std::vector<std::byte> m_commands {};        ///< Commands in submission order
+        std::vector<std::byte> m_sortedCommands {};  ///< Commands gathered in key order
+        std::vector<SortEntry> m_sortEntries {};     ///< Keys and offsets used for sorting
+        bool m_useSortedCommands = false;            ///< Whether forEach() replays the gathered buffer
     };
 
+    class RenderTarget;
+
     /**
-     * @brief Lightweight draw call reference with depth information
+     * @brief Scoped direct access to the pixels of a render target
+     * 
+     * @details A PixelLock is obtained from RenderTarget::lockPixels() and
+     * exposes a region of the target's pixel buffer as a strided span, so
+     * custom rasterizers, effects and emulators can write pixels with plain
+     * indexing instead of one function call per pixel. Rows of the region are
+     * getStride() pixels apart; pixel (x, y) of the region lives at
+     * getPixels()[y * getStride() + x]. Distinct rows can be written from
+     * different threads.
      * 
-     * @details A minimal structure that references draw call data and
-     * includes depth information for sorting. This separation allows
-     * efficient sorting without moving large data structures.
+     * While a lock is held the target cannot be rendered, filled or resized.
+     * When the lock is released, its modified region (the whole locked region
+     * unless narrowed with setModifiedRegion()) is added to the target's dirty
+     * region.
      * 
-     * Draw calls are sorted by depth before rendering to ensure
-     * proper visibility and transparency handling.
+     * @par Example Usage:
+     * @code
+     * {
+     *     PixelLock lock = window.lockPixels();
+     *     std::span<Color> pixels = lock.getPixels();
+     * 
+     *     #pragma omp parallel for
+     *     for (i32 y = 0; y < static_cast<i32>(lock.getSize().y); ++y) {
+     *         for (u32 x = 0; x < lock.getSize().x; ++x) {
+     *             pixels[y * lock.getStride() + x] = plasma(x, y, time);
+     *         }
+     *     }
+     * }  // unlocked here
+     * @endcode
      */
-    struct DrawCall
+    class PixelLock
     {
-        f32 depth = 0.f;        ///< Depth value used for sorting (higher values processed first during rendering)
-        u32 data_index = 0;     ///< Index into the draw call data pool
+    public:
+
+        PixelLock(const PixelLock &) = delete;
+        PixelLock &operator=(const PixelLock &) = delete;
+
+        /**
+         * @brief Take over a lock, leaving @p other released
+         * @param other Lock to move from
+         */
+        PixelLock(PixelLock &&other) noexcept;
+
+        /**
+         * @brief Release the current lock and take over another
+         * @param other Lock to move from
+         * @return Reference to this lock
+         */
+        PixelLock &operator=(PixelLock &&other) noexcept;
+
+        /**
+         * @brief Release the lock if it is still held
+         */
+        ~PixelLock();
+
+        /**
+         * @brief Get the locked pixels
+         * @return Span from the first to the last pixel of the region, rows getStride() apart;
+         *         empty once the lock is released
+         */
+        std::span<Color> getPixels() const;
+
+        /**
+         * @brief Get one row of the locked region
+         * @param y Row index relative to the region
+         * @return The getSize().x pixels of the row
+         */
+        std::span<Color> getRow(u32 y) const;
+
+        /**
+         * @brief Get the distance between consecutive rows
+         * @return Row stride in pixels (the width of the target)
+         */
+        u32 getStride() const;
+
+        /**
+         * @brief Get the size of the locked region
+         * @return Width and height in pixels
+         */
+        Vector2<u32> getSize() const;
+
+        /**
+         * @brief Get the locked region in target coordinates
+         * @return Region covered by getPixels()
+         */
+        const Rect<u32> &getRegion() const;
+
+        /**
+         * @brief Narrow the region reported as modified on release
+         * @param region Modified region in target coordinates, clipped to the locked region;
+         *               an empty region marks the lock as read-only
+         */
+        void setModifiedRegion(const Rect<u32> &region);
+
+        /**
+         * @brief Release the lock before the end of its scope
+         * @details Adds the modified region to the target's dirty region. Further calls do nothing.
+         */
+        void unlock();
+
+    private:
+
+        friend class RenderTarget;
+
+        PixelLock(RenderTarget &target, const Rect<u32> &region);
+
+        RenderTarget *m_target = nullptr;  ///< Locked target, null once released
+        Color *m_pixels = nullptr;         ///< First pixel of the region
+        u32 m_stride = 0;                  ///< Row stride in pixels
+        Rect<u32> m_region {};             ///< Locked region in target coordinates
+        Rect<u32> m_modifiedRegion {};     ///< Region marked dirty on release
+    };
+
+    /**
+     * @brief Captured output of a sequence of draw calls
+     * 
+     * @details A FragmentRecording stores the shaded colors that draw calls
+     * blended into a render target, together with the pixel each color went
+     * to and the blend mode used. Replaying the recording blends the same
+     * colors into the same pixels again without rasterizing or running any
+     * filter pipeline, which makes it the cheapest way to redraw content that
+     * did not change. Because the colors are blended again on replay, the
+     * result is exact on any background.
+     * 
+     * Recordings are filled between Renderer::beginRecording() and
+     * Renderer::endRecording() while the target renders, and are bound to the
+     * buffer size of that target. Memory is bounded by a limit; a capture that
+     * would exceed it is abandoned and its memory released.
+     * 
+     * @par Example Usage:
+     * @code
+     * FragmentRecording recording;
+     * renderer.beginRecording(window, recording);
+     * polygon.draw(renderer, window);
+     * renderer.endRecording(window, recording);
+     * window.render();
+     * 
+     * // later frames, as long as the polygon and the window size are unchanged
+     * if (recording.isValidFor(window)) {
+     *     renderer.draw(window, recording);
+     * }
+     * @endcode
+     * 
+     * @see CachedDrawable for automatic capture and invalidation
+     */
+    class FragmentRecording
+    {
+    public:
+
+        /**
+         * @brief A run of consecutive pixels blended with one blend mode
+         */
+        struct Run
+        {
+            u32 index = 0;                          ///< Linear index of the first pixel
+            u32 count = 0;                          ///< Number of pixels in the run
+            BlendMode blendMode = BlendMode::Alpha; ///< How the colors are blended
+        };
+
+        static constexpr std::size_t defaultMemoryLimit = 8u << 20;  ///< Default memory limit in bytes
+
+        /**
+         * @brief Create an empty recording with the default memory limit
+         */
+        FragmentRecording() = default;
+
+        /**
+         * @brief Create an empty recording
+         * @param memoryLimit Maximum number of bytes a capture may use
+         */
+        explicit FragmentRecording(std::size_t memoryLimit);
+
+        /**
+         * @brief Discard the captured content and release its memory
+         */
+        void clear();
+
+        /**
+         * @brief Check whether a capture finished within the memory limit
+         * @return True if the recording can be replayed
+         */
+        bool isComplete() const;
+
+        /**
+         * @brief Check whether the last capture was abandoned
+         * @return True if the last capture exceeded the memory limit
+         */
+        bool hasOverflowed() const;
+
+        /**
+         * @brief Check whether the recording can be replayed into a target
+         * @param target Target to replay into
+         * @return True if the recording is complete and was captured at the target's buffer size
+         */
+        bool isValidFor(const RenderTarget &target) const;
+
+        /**
+         * @brief Get the buffer size the recording was captured at
+         * @return Width and height in pixels
+         */
+        const Vector2<u32> &getBufferSize() const;
+
+        /**
+         * @brief Get the region covered by the captured fragments
+         * @return Bounding rectangle in pixel coordinates, empty if nothing was captured
+         */
+        const Rect<u32> &getBounds() const;
+
+        /**
+         * @brief Get the captured runs in blend order
+         * @return Runs whose colors are stored consecutively in getColors()
+         */
+        std::span<const Run> getRuns() const;
+
+        /**
+         * @brief Get the captured colors in blend order
+         * @return One color per captured fragment
+         */
+        std::span<const Color> getColors() const;
+
+        /**
+         * @brief Get the memory held by the recording
+         * @return Allocated bytes
+         */
+        std::size_t getMemoryUsage() const;
+
+        /**
+         * @brief Get the memory limit
+         * @return Maximum number of bytes a capture may use
+         */
+        std::size_t getMemoryLimit() const;
+
+        /**
+         * @brief Set the memory limit
+         * @param memoryLimit Maximum number of bytes a capture may use
+         * @details Applies to the next capture.
+         */
+        void setMemoryLimit(std::size_t memoryLimit);
+
+    private:
+
+        friend class RenderTarget;
+        friend class Renderer;
+
+        /**
+         * @brief State of the recording
+         */
+        enum class State : u8
+        {
+            Empty,      ///< Nothing captured
+            Recording,  ///< Capture in progress
+            Complete,   ///< Capture finished and replayable
+            Overflowed  ///< Capture abandoned because of the memory limit
+        };
+
+        /**
+         * @brief Discard the content and start capturing
+         * @param bufferSize Buffer size of the target being captured
+         */
+        void begin(const Vector2<u32> &bufferSize);
+
+        /**
+         * @brief Finish capturing
+         */
+        void end();
+
+        /**
+         * @brief Append colors blended into consecutive pixels
+         * @param index Linear index of the first pixel
+         * @param count Number of pixels
+         * @param blendMode Blend mode of the pixels
+         * @return Storage for @p count colors, or nullptr if nothing should be stored
+         * @details Runs continuing the previous run with the same blend mode
+         *          are merged into it.
+         */
+        Color *appendRun(u32 index, u32 count, BlendMode blendMode);
+
+        /**
+         * @brief Append the colors of shaded fragments blended into consecutive pixels
+         * @param index Linear index of the first pixel
+         * @param fragments Shaded fragments, one per pixel
+         * @param count Number of pixels
+         * @param blendMode Blend mode of the pixels
+         */
+        void record(u32 index, const filters::VertexData *fragments, u32 count, BlendMode blendMode);
+
+        /**
+         * @brief Append colors blended into consecutive pixels
+         * @param index Linear index of the first pixel
+         * @param colors Source colors, one per pixel
+         * @param count Number of pixels
+         * @param blendMode Blend mode of the pixels
+         */
+        void record(u32 index, const Color *colors, u32 count, BlendMode blendMode);
+
+        std::vector<Run> m_runs {};                              ///< Captured runs in blend order
+        std::vector<Color> m_colors {};                          ///< Captured colors in blend order
+        Vector2<u32> m_bufferSize { 0u, 0u };                    ///< Buffer size of the captured target
+        Rect<u32> m_bounds {};                                   ///< Region covered by the runs
+        std::size_t m_memoryLimit = defaultMemoryLimit;          ///< Maximum bytes per capture
+        State m_state = State::Empty;                            ///< Current state
     };
 
     /**
@@ -234,9 +707,9 @@ namespace til
          * @brief Process all submitted draw calls and render to pixel buffer
          * 
          * @details Executes the complete rendering pipeline:
-         * 1. Sorts draw calls by depth
-         * 2. Processes each draw call through the renderer
-         * 3. Applies transformations and filter pipelines
+         * 1. Sorts the command buffer by depth
+         * 2. Replays each command through the renderer in order
+         * 3. Applies the precomputed matrices and filter pipelines
          * 4. Writes results to the pixel buffer
          * 
          * This method should be called once per frame after all draw
@@ -277,19 +750,148 @@ namespace til
          */
         void fill(const Color &color);
 
-    protected:
-
         /**
          * @brief Get the current pixel buffer dimensions
          * 
          * @details Returns the size of the pixel buffer in pixels.
-         * This is used by derived classes to understand the output
-         * resolution and for bounds checking.
+         * Derived classes use it for bounds checking, and drawables use it
+         * to cull content outside the visible area.
          * 
          * @return Buffer dimensions as width and height
          */
         const Vector2<u32> &getBufferSize() const;
-        
+
+        /**
+         * @brief Lock the whole pixel buffer for direct access
+         * 
+         * @return Lock exposing every pixel of the target
+         * 
+         * @throws LogicError If the pixels are already locked
+         */
+        PixelLock lockPixels();
+
+        /**
+         * @brief Lock a region of the pixel buffer for direct access
+         * 
+         * @param region Region to expose, clipped to the buffer
+         * @return Lock exposing the clipped region
+         * 
+         * @throws LogicError If the pixels are already locked
+         */
+        PixelLock lockPixels(const Rect<u32> &region);
+
+        /**
+         * @brief Get the region modified since the last clearDirtyRegion()
+         * 
+         * @details Every write to the pixel buffer grows the dirty region:
+         * rendering, fills, immediate draws, post-processing and released
+         * pixel locks. Consumers can use it to upload or encode only what
+         * changed.
+         * 
+         * @return Bounding rectangle of all modified pixels, empty if nothing changed
+         */
+        const Rect<u32> &getDirtyRegion() const;
+
+        /**
+         * @brief Reset the dirty region to empty
+         */
+        void clearDirtyRegion();
+
+        /**
+         * @brief Get the content version of the pixel buffer
+         * 
+         * @return Number that increases whenever pixels are modified
+         */
+        u64 getContentVersion() const;
+
+        /**
+         * @brief Enable or disable the ID buffer
+         * 
+         * @details The ID buffer holds one u32 per pixel: the draw id of the
+         * draw call that last covered the pixel. It is filled by the
+         * rasterizers in the same pass as the colors, so after render() it
+         * reflects exactly what is visible, in depth order, and pick()
+         * answers which draw call produced a pixel with a single lookup.
+         * 
+         * Fragments with zero alpha do not claim a pixel unless they are
+         * drawn with BlendMode::None. fill() resets every id to 0.
+         * Enabling the buffer clears it to 0; disabling it releases it.
+         * 
+         * @param enabled Whether pixel writes should record draw ids
+         */
+        void setIdBufferEnabled(bool enabled);
+
+        /**
+         * @brief Check whether the ID buffer is enabled
+         * @return True if pixel writes record draw ids
+         */
+        bool isIdBufferEnabled() const;
+
+        /**
+         * @brief Set the draw id of subsequent draw calls
+         * 
+         * @details Deferred draw calls registered after this call remember
+         * the id and write it when the target renders; immediate draws write
+         * it right away. Id 0 is reserved for "nothing", so unlabeled
+         * content still hides labeled content behind it.
+         * 
+         * @param id Draw id to write into the ID buffer
+         * 
+         * @par Example Usage:
+         * @code
+         * window.setIdBufferEnabled(true);
+         * 
+         * window.setDrawId(1);
+         * circle.draw(renderer, window);
+         * window.setDrawId(2);
+         * square.draw(renderer, window);
+         * window.setDrawId(0);
+         * 
+         * window.render();
+         * u32 hovered = window.pick(cursor);  // 1, 2 or 0
+         * @endcode
+         */
+        void setDrawId(u32 id);
+
+        /**
+         * @brief Get the draw id of subsequent draw calls
+         * @return Current draw id
+         */
+        u32 getDrawId() const;
+
+        /**
+         * @brief Get the draw id of the content at a pixel
+         * 
+         * @param position Pixel coordinates
+         * @return Id of the draw call that last covered the pixel, or 0 if
+         *         none did, the position is outside the target or the ID
+         *         buffer is disabled
+         */
+        u32 pick(const Vector2<u32> &position) const;
+
+        /**
+         * @brief Get the whole ID buffer
+         * @return One draw id per pixel in row-major order, empty if the ID buffer is disabled
+         */
+        std::span<const u32> getIdBuffer() const;
+
+    protected:
+
+        /**
+         * @brief Add a region to the dirty region
+         * 
+         * @details Not thread-safe; writers running in parallel mark their
+         * whole area once before or after the parallel section.
+         * 
+         * @param region Modified region in pixel coordinates
+         */
+        void markDirty(const Rect<u32> &region);
+
+        /**
+         * @brief Mark the whole pixel buffer as modified
+         */
+        void markDirty();
+
         /**
          * @brief Set the pixel buffer dimensions
          * 
@@ -342,48 +944,150 @@ namespace til
         void setPixel(const Vector2<u32> &position, const Color &color);
         
         /**
-         * @brief Set a pixel with blending at linear index
-         * 
-         * @details Sets a pixel value using the specified blend mode
-         * to combine with the existing pixel value.
-         * 
-         * @param index Linear index into the pixel buffer
-         * @param color Color value to blend
-         * @param blendMode How to combine with existing pixel
+         * @brief Set a pixel with blending at linear index
+         * 
+         * @details Sets a pixel value using the specified blend mode
+         * to combine with the existing pixel value.
+         * 
+         * @param index Linear index into the pixel buffer
+         * @param color Color value to blend
+         * @param blendMode How to combine with existing pixel
+         */
+        void setPixelWithBlend(u32 index, const Color &color, BlendMode blendMode);
+        
+        /**
+         * @brief Set a pixel with blending at 2D position
+         * 
+         * @details Sets a pixel value using the specified blend mode
+         * to combine with the existing pixel value. The pixel is recorded
+         * but not marked dirty; callers mark the region they drew once.
+         * 
+         * @param position 2D pixel coordinates
+         * @param color Color value to blend
+         * @param blendMode How to combine with existing pixel
+         */
+        void setPixelWithBlend(const Vector2<u32> &position, const Color &color, BlendMode blendMode);
+
+        /**
+         * @brief Blend a horizontal run of fragments into the pixel buffer
+         * 
+         * @details Blends the colors of @p count consecutive fragments into
+         * consecutive pixels starting at @p index. The blend mode is resolved
+         * once for the whole run instead of once per pixel.
+         * 
+         * @param index Linear index of the first pixel of the run
+         * @param fragments Shaded fragments, one per pixel
+         * @param count Number of pixels in the run
+         * @param blendMode How to combine with existing pixels
+         */
+        void blendSpan(u32 index, const filters::VertexData *fragments, u32 count, BlendMode blendMode);
+
+        /**
+         * @brief Blend fragments at arbitrary pixel positions
+         * 
+         * @details Blends the color of each shaded fragment into the pixel
+         * given by the position of the matching unshaded fragment. The blend
+         * mode is resolved once for all fragments.
+         * 
+         * @param positions Fragments providing the integer pixel positions
+         * @param fragments Shaded fragments providing the colors
+         * @param count Number of fragments
+         * @param blendMode How to combine with existing pixels
+         */
+        void blendFragments(const filters::VertexData *positions, const filters::VertexData *fragments, u32 count, BlendMode blendMode);
+
+        /**
+         * @brief Blend a rectangle of fragments into the pixel buffer
+         * 
+         * @details Rows are blended in parallel and the region is marked
+         * dirty once.
+         * 
+         * @param region Pixel region, inside the buffer
+         * @param fragments Shaded fragments in row-major order, one per pixel of the region
+         * @param blendMode How to combine with existing pixels
+         */
+        void blendRect(const Rect<u32> &region, const filters::VertexData *fragments, BlendMode blendMode);
+
+        /**
+         * @brief Fill a run of pixels with one color
+         * 
+         * @details Blends @p color into @p count pixels starting at @p index
+         * and advancing by @p stride, so the run can be a row (stride 1) or a
+         * column (stride equal to the buffer width). Unblended rows are filled
+         * with a single memory fill.
+         * 
+         * @param index Linear index of the first pixel of the run
+         * @param stride Distance between consecutive pixels of the run
+         * @param count Number of pixels in the run
+         * @param color Color to blend
+         * @param blendMode How to combine with existing pixels
+         */
+        void fillSpan(u32 index, u32 stride, u32 count, const Color &color, BlendMode blendMode);
+
+        /**
+         * @brief Fill a run of pixels with a linear gradient
+         * 
+         * @details Pixel i of the run receives the gradient color at step
+         * @p firstStep + i of @p stepCount, where step 0 is @p startColor and
+         * step @p stepCount is @p endColor. Starting past step 0 lets clipped
+         * runs keep the colors of the unclipped gradient.
+         * 
+         * @param index Linear index of the first pixel of the run
+         * @param stride Distance between consecutive pixels of the run
+         * @param count Number of pixels in the run
+         * @param startColor Gradient color at step 0
+         * @param endColor Gradient color at step @p stepCount
+         * @param firstStep Gradient step of the first pixel
+         * @param stepCount Number of steps between the gradient ends
+         * @param blendMode How to combine with existing pixels
          */
-        void setPixelWithBlend(u32 index, const Color &color, BlendMode blendMode);
-        
+        void fillGradientSpan(u32 index, u32 stride, u32 count, const Color &startColor, const Color &endColor, u32 firstStep, u32 stepCount, BlendMode blendMode);
+
         /**
-         * @brief Set a pixel with blending at 2D position
+         * @brief Blend a row of colors into consecutive pixels
          * 
-         * @details Sets a pixel value using the specified blend mode
-         * to combine with the existing pixel value.
+         * @details Unblended rows are written with a single memory copy.
          * 
-         * @param position 2D pixel coordinates
-         * @param color Color value to blend
-         * @param blendMode How to combine with existing pixel
+         * @param index Linear index of the first pixel of the row
+         * @param colors Source colors, one per pixel
+         * @param count Number of pixels in the row
+         * @param blendMode How to combine with existing pixels
          */
-        void setPixelWithBlend(const Vector2<u32> &position, const Color &color, BlendMode blendMode);
+        void blendColors(u32 index, const Color *colors, u32 count, BlendMode blendMode);
 
-    /**
-     * @brief Sort all draw calls by depth value
-     * 
-      * @details Sorts the draw call list in descending depth order. Higher
-      * depth values are processed first, so draw calls with smaller depth
-      * values are blended last and therefore appear in front.
-     */
-        void sortDrawCalls();
+        /**
+         * @brief Record the active draw id for a run of written pixels
+         * 
+         * @details Pixels whose source color is fully transparent keep their
+         * id unless @p blendMode is BlendMode::None. Safe to call for
+         * distinct runs from different threads.
+         * 
+         * @tparam ColorAt Callable returning the source color of pixel i of the run
+         * @param index Linear index of the first pixel of the run
+         * @param stride Distance between consecutive pixels of the run
+         * @param count Number of pixels in the run
+         * @param blendMode Blend mode the pixels were written with
+         * @param colorAt Source color lookup
+         */
+        template<typename ColorAt>
+        void writeIds(u32 index, u32 stride, u32 count, BlendMode blendMode, ColorAt colorAt);
 
         /**
          * @brief Register a new draw call for rendering
          * 
-         * @details Adds a draw call to the pending list for processing
+         * @details Encodes the draw call into the command buffer for processing
          * during the next render() call. Used internally by the renderer.
          * 
-         * @param drawCallData Complete draw call information
+         * @tparam Primitive Primitive type of the draw call
+         * @param type Type tag matching the primitive
+         * @param primitive Primitive payload
+         * @param matrix Precomputed transformation matrix
+         * @param fragmentPipeline Filter pipeline for effects
          * @param depth Depth value for sorting
+         * @param blendMode How to blend with existing pixels
          */
-        void registerDrawCall(const DrawCallData &drawCallData, f32 depth);
+        template<typename Primitive>
+        void registerDrawCall(DrawCallType type, const Primitive &primitive, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode);
         
         /**
          * @brief Clear all pending draw calls
@@ -397,15 +1101,27 @@ namespace til
 
         Vector2<u32> m_bufferSize { 0u, 0u };        ///< Current pixel buffer dimensions
 
-        std::vector<DrawCall> m_drawCalls {};        ///< Pending draw calls for rendering
-        std::vector<DrawCallData> m_drawCallDataPool {}; ///< Storage pool for draw call data
+        DrawCommandBuffer m_drawCommands {};         ///< Pending draw calls encoded for rendering
 
         filters::BaseData m_baseData;                ///< Current frame context data
 
         Renderer *m_renderer = nullptr;              ///< Associated renderer for processing
 
+        Rect<u32> m_dirtyRegion {};                  ///< Pixels modified since the last clearDirtyRegion()
+        u64 m_contentVersion = 0;                    ///< Incremented on every pixel modification
+        bool m_pixelsLocked = false;                 ///< Whether a PixelLock currently holds the buffer
+
+        FragmentRecording *m_recording = nullptr;    ///< Recording capturing blended fragments during render()
+
+        std::vector<u32> m_idBuffer {};              ///< Draw id per pixel, empty while disabled
+        bool m_idBufferEnabled = false;              ///< Whether pixel writes record draw ids
+        u32 m_drawId = 0;                            ///< Draw id assigned to new draw calls
+        u32 m_activeDrawId = 0;                      ///< Draw id written by pixel writes, the replayed call's id during render()
+
     friend class Renderer;
     friend class Framework;
+    friend class PixelLock;
+    friend class FragmentRecording;
     };
 
     /**
@@ -522,6 +1238,81 @@ namespace til
          */
         void draw(RenderTarget &renderTarget, const primitives::TriangleMesh &mesh, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth = 0.f, BlendMode blendMode = BlendMode::Alpha);
 
+        /**
+         * @brief Submit a line list for deferred rendering
+         * 
+         * @param renderTarget Target to render onto
+         * @param lines Line list primitive to render
+         * @param transform Transformation to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param depth Depth value for sorting (default: 0.0)
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void draw(RenderTarget &renderTarget, const primitives::LineList &lines, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth = 0.f, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Submit a line strip for deferred rendering
+         * 
+         * @param renderTarget Target to render onto
+         * @param strip Line strip primitive to render
+         * @param transform Transformation to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param depth Depth value for sorting (default: 0.0)
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void draw(RenderTarget &renderTarget, const primitives::LineStrip &strip, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth = 0.f, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Submit a fragment pass for deferred rendering
+         * 
+         * @details The pass is sorted by depth together with all other draw
+         * calls, so it can serve as a background or as an overlay.
+         * 
+         * @param renderTarget Target to render onto
+         * @param pass Region to shade
+         * @param fragmentPipeline Filter pipeline computing the pixel colors
+         * @param depth Depth value for sorting (default: 0.0)
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void draw(RenderTarget &renderTarget, const primitives::FragmentPass &pass, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth = 0.f, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Start capturing the draw calls that follow into a recording
+         * 
+         * @details When the target renders, everything blended between this
+         * call and the matching endRecording() is captured into
+         * @p recording, replacing its previous content. Draw calls are
+         * captured in the order they render, so the recorded draw calls
+         * should share the depth passed here.
+         * 
+         * @param renderTarget Target the draw calls are submitted to
+         * @param recording Recording to capture into, must outlive the next render()
+         * @param depth Depth value for sorting (default: 0.0)
+         */
+        void beginRecording(RenderTarget &renderTarget, FragmentRecording &recording, f32 depth = 0.f);
+
+        /**
+         * @brief Stop capturing into a recording
+         * 
+         * @param renderTarget Target the draw calls are submitted to
+         * @param recording Recording passed to beginRecording()
+         * @param depth Depth value for sorting (default: 0.0)
+         */
+        void endRecording(RenderTarget &renderTarget, FragmentRecording &recording, f32 depth = 0.f);
+
+        /**
+         * @brief Submit a recording for deferred replay
+         * 
+         * @details Replays a recording that is complete when the target
+         * renders; incomplete recordings and recordings captured at a
+         * different buffer size are skipped.
+         * 
+         * @param renderTarget Target to render onto
+         * @param recording Recording to replay, must outlive the next render()
+         * @param depth Depth value for sorting (default: 0.0)
+         */
+        void draw(RenderTarget &renderTarget, FragmentRecording &recording, f32 depth = 0.f);
+
         /**
          * @brief Render a vertex primitive immediately
          * 
@@ -575,6 +1366,138 @@ namespace til
          */
         void drawImmediate(RenderTarget &renderTarget, const primitives::TriangleMesh &mesh, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
 
+        /**
+         * @brief Render a line list immediately
+         * 
+         * @details Rasterizes all segments of the list in parallel and runs
+         * the fragment pipeline once for all of them.
+         * 
+         * @param renderTarget Target to render onto
+         * @param lines Line list primitive to render
+         * @param transform Transformation to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::LineList &lines, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Render a line strip immediately
+         * 
+         * @details Rasterizes all segments of the strip in parallel and runs
+         * the fragment pipeline once for all of them.
+         * 
+         * @param renderTarget Target to render onto
+         * @param strip Line strip primitive to render
+         * @param transform Transformation to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::LineStrip &strip, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Render a vertex primitive immediately with a precomputed matrix
+         * 
+         * @details Same as the Transform overload, but uses an already computed
+         * affine matrix. This is the path used when replaying deferred draw calls.
+         * 
+         * @param renderTarget Target to render onto
+         * @param vertex Vertex primitive to render
+         * @param matrix Transformation matrix to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::Vertex &vertex, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Render a line primitive immediately with a precomputed matrix
+         * 
+         * @param renderTarget Target to render onto
+         * @param line Line primitive to render
+         * @param matrix Transformation matrix to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::Line &line, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Render an ellipse primitive immediately with a precomputed matrix
+         * 
+         * @param renderTarget Target to render onto
+         * @param ellipse Ellipse primitive to render
+         * @param matrix Transformation matrix to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::Ellipse &ellipse, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Render a triangle mesh immediately with a precomputed matrix
+         * 
+         * @param renderTarget Target to render onto
+         * @param mesh Triangle mesh primitive to render
+         * @param matrix Transformation matrix to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::TriangleMesh &mesh, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Render a line list immediately with a precomputed matrix
+         * 
+         * @param renderTarget Target to render onto
+         * @param lines Line list primitive to render
+         * @param matrix Transformation matrix to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::LineList &lines, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Render a line strip immediately with a precomputed matrix
+         * 
+         * @param renderTarget Target to render onto
+         * @param strip Line strip primitive to render
+         * @param matrix Transformation matrix to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::LineStrip &strip, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Run a fragment pass immediately
+         * 
+         * @details Generates the fragments of the pass directly from the
+         * target dimensions, row by row in parallel, runs them through the
+         * pipeline and blends the result. Compared with drawing a full-screen
+         * Rectangle this skips triangle setup, edge tests and coverage
+         * compaction entirely.
+         * 
+         * @param renderTarget Target to render onto
+         * @param pass Region to shade
+         * @param fragmentPipeline Filter pipeline computing the pixel colors
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         * 
+         * @par Example Usage:
+         * @code
+         * filters::UVGradient gradient;
+         * FilterPipeline<filters::VertexData, filters::VertexData> pipeline;
+         * pipeline.addFilter(&gradient).build();
+         * renderer.drawImmediate(window, primitives::FragmentPass{}, pipeline, BlendMode::None);
+         * @endcode
+         */
+        void drawImmediate(RenderTarget &renderTarget, const primitives::FragmentPass &pass, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Replay a recording immediately
+         * 
+         * @details Blends the recorded colors with their recorded blend
+         * modes. Does nothing unless the recording is valid for the target.
+         * 
+         * @param renderTarget Target to render onto
+         * @param recording Recording to replay
+         */
+        void drawImmediate(RenderTarget &renderTarget, const FragmentRecording &recording);
+
         /**
          * @brief Draw a single pixel immediately
          * 
@@ -589,6 +1512,116 @@ namespace til
          */
         void drawImmediatePixel(RenderTarget &renderTarget, const Vector2<u32> &position, const Color &color, BlendMode blendMode = BlendMode::Alpha);
         
+        /**
+         * @brief Fill a rectangle immediately
+         * 
+         * @details Fills whole rows at a time with the blend mode resolved
+         * once, so large areas are written at memory speed. The rectangle is
+         * clipped to the target and may lie partially outside it.
+         * 
+         * @param renderTarget Target to render onto
+         * @param position Pixel coordinates of the top-left corner
+         * @param size Width and height in pixels
+         * @param color Fill color
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediateRect(RenderTarget &renderTarget, const Vector2<i32> &position, const Vector2<u32> &size, const Color &color, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Fill a horizontal run of pixels immediately
+         * 
+         * @param renderTarget Target to render onto
+         * @param start Pixel coordinates of the leftmost pixel
+         * @param length Number of pixels
+         * @param color Fill color
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediateHorizontalSpan(RenderTarget &renderTarget, const Vector2<i32> &start, u32 length, const Color &color, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Fill a horizontal run of pixels with a gradient immediately
+         * 
+         * @details The first pixel receives @p startColor and the last pixel
+         * @p endColor, with channels interpolated linearly in between. Clipping
+         * does not shift the gradient.
+         * 
+         * @param renderTarget Target to render onto
+         * @param start Pixel coordinates of the leftmost pixel
+         * @param length Number of pixels
+         * @param startColor Color of the leftmost pixel
+         * @param endColor Color of the rightmost pixel
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediateHorizontalSpan(RenderTarget &renderTarget, const Vector2<i32> &start, u32 length, const Color &startColor, const Color &endColor, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Fill a vertical run of pixels immediately
+         * 
+         * @param renderTarget Target to render onto
+         * @param start Pixel coordinates of the topmost pixel
+         * @param length Number of pixels
+         * @param color Fill color
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediateVerticalSpan(RenderTarget &renderTarget, const Vector2<i32> &start, u32 length, const Color &color, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Fill a vertical run of pixels with a gradient immediately
+         * 
+         * @details The first pixel receives @p startColor and the last pixel
+         * @p endColor, with channels interpolated linearly in between. Clipping
+         * does not shift the gradient.
+         * 
+         * @param renderTarget Target to render onto
+         * @param start Pixel coordinates of the topmost pixel
+         * @param length Number of pixels
+         * @param startColor Color of the topmost pixel
+         * @param endColor Color of the bottommost pixel
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediateVerticalSpan(RenderTarget &renderTarget, const Vector2<i32> &start, u32 length, const Color &startColor, const Color &endColor, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Copy an array of colors onto the target immediately
+         * 
+         * @details Copies the pixels row by row, clipped to the target. With
+         * BlendMode::None each row is a single memory copy.
+         * 
+         * @param renderTarget Target to render onto
+         * @param position Pixel coordinates of the top-left corner
+         * @param size Width and height of the source in pixels
+         * @param pixels Source colors in row-major order, size.x * size.y entries
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediatePixels(RenderTarget &renderTarget, const Vector2<i32> &position, const Vector2<u32> &size, const Color *pixels, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Copy a texture onto the target immediately
+         * 
+         * @details Copies texels one to one without sampling or filtering.
+         * 
+         * @param renderTarget Target to render onto
+         * @param position Pixel coordinates of the top-left corner
+         * @param texture Source texture
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediateTexture(RenderTarget &renderTarget, const Vector2<i32> &position, const Texture &texture, BlendMode blendMode = BlendMode::Alpha);
+
+        /**
+         * @brief Copy part of a texture onto the target immediately
+         * 
+         * @details Copies texels one to one without sampling or filtering.
+         * The source rectangle is clipped to the texture.
+         * 
+         * @param renderTarget Target to render onto
+         * @param position Pixel coordinates of the top-left corner
+         * @param texture Source texture
+         * @param sourcePosition Top-left texel of the copied region
+         * @param sourceSize Size of the copied region in texels
+         * @param blendMode How to blend with existing pixels (default: Alpha)
+         */
+        void drawImmediateTexture(RenderTarget &renderTarget, const Vector2<i32> &position, const Texture &texture, const Vector2<u32> &sourcePosition, const Vector2<u32> &sourceSize, BlendMode blendMode = BlendMode::Alpha);
+
         /**
          * @brief Draw a simple line immediately
          * 
@@ -603,6 +1636,32 @@ namespace til
          */
         void drawImmediateLine(RenderTarget &renderTarget, const Vector2<u32> &start, const Vector2<u32> &end, const Color &color, BlendMode blendMode = BlendMode::Alpha);
 
+        /**
+         * @brief Select how triangles are rasterized
+         * 
+         * @details In FixedPoint mode vertex positions are snapped to 1/16 of a
+         * pixel and coverage is decided with exact 64-bit integer edge functions,
+         * advanced by one addition per pixel. Triangles sharing an edge then
+         * cover every pixel along it exactly once, regardless of how large the
+         * coordinates are. FloatingPoint mode keeps the original per-pixel float
+         * evaluation and is the default.
+         * 
+         * @param mode Rasterization mode used by subsequent triangle draws
+         * 
+         * @par Example Usage:
+         * @code
+         * framework.renderer.setRasterizationMode(RasterizationMode::FixedPoint);
+         * @endcode
+         */
+        void setRasterizationMode(RasterizationMode mode);
+
+        /**
+         * @brief Get the current triangle rasterization mode
+         * 
+         * @return Active rasterization mode
+         */
+        RasterizationMode getRasterizationMode() const;
+
         /**
          * @brief Add a triangle mesh to the vertex buffer
          * 
@@ -669,11 +1728,122 @@ namespace til
          */
         bool clipLineToRect(Vector2<f32>& start, Vector2<f32>& end, const Vector2<u32>& rectSize) const;
 
+        /**
+         * @brief Horizontal run of fragments covering consecutive pixels of one row
+         */
+        struct FragmentSpan {
+            u32 x, y;          ///< Position of the leftmost pixel
+            u32 length;        ///< Number of pixels in the run
+            u32 firstFragment; ///< Index of the run's first fragment in the fragment buffers
+        };
+
+        /**
+         * @brief Clipped line segment prepared for integer rasterization
+         */
+        struct LineSegment {
+            Vector2<i32> start;                ///< First pixel of the clipped segment
+            Vector2<i32> delta;                ///< Offset from the first to the last pixel
+            Vector2<f32> uvStart, uvEnd;       ///< Texture coordinates at the clipped end points
+            Vector2<f32> size, inverseSize;    ///< Extent of the clipped segment passed to the filters
+            u32 firstStep;                     ///< 1 when the first pixel was already produced by the previous strip segment
+            u32 length;                        ///< Number of fragments produced by the segment
+            u32 firstFragment;                 ///< Index of the segment's first fragment in the fragment buffers
+        };
+
+        /**
+         * @brief Rasterize a batch of line segments in one pipeline run
+         * 
+         * @details Transforms and clips all segments, then rasterizes them in
+         * parallel with an integer DDA whose minor axis coordinate is computed
+         * in closed form, so each segment produces exactly one fragment per
+         * step along its major axis.
+         * 
+         * @param renderTarget Target to render onto
+         * @param vertices Segment end points
+         * @param segmentCount Number of segments
+         * @param strip True if segments share end points (vertex i to i + 1), false for independent pairs
+         * @param matrix Transformation matrix to apply
+         * @param fragmentPipeline Filter pipeline for effects
+         * @param blendMode How to blend with existing pixels
+         */
+        void drawSegments(RenderTarget &renderTarget, const primitives::Vertex *vertices, u32 segmentCount, bool strip, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode);
+
+        /**
+         * @brief Copy a block of colors onto the target, clipped
+         * 
+         * @param renderTarget Target to render onto
+         * @param position Pixel coordinates of the top-left corner
+         * @param size Width and height of the block in pixels
+         * @param pixels First color of the block
+         * @param sourceStride Distance between source rows in pixels
+         * @param blendMode How to blend with existing pixels
+         */
+        void blitPixels(RenderTarget &renderTarget, const Vector2<i32> &position, const Vector2<u32> &size, const Color *pixels, u32 sourceStride, BlendMode blendMode);
+
         std::vector<primitives::Vertex> m_meshVertices {};          ///< Vertex buffer for triangle meshes
+        std::vector<Vector2<f32>> m_transformedPositions {};        ///< Scratch buffer of mesh positions after transformation
 
         FilterableBuffer<filters::VertexData> m_fragmentInputBuffer {};  ///< Input buffer for filter pipelines
         FilterableBuffer<filters::VertexData> m_fragmentOutputBuffer {}; ///< Output buffer for filter pipelines
+        std::vector<FragmentSpan> m_fragmentSpans {};                   ///< Spans of the fragments in the input buffer
+        std::vector<u32> m_rowOffsets {};                               ///< First span slot of every triangle of the mesh being drawn
+        std::vector<LineSegment> m_lineSegments {};                     ///< Segments of the line batch being drawn
+
+        RasterizationMode m_rasterizationMode = RasterizationMode::FloatingPoint; ///< Strategy used to rasterize triangles
     };
+
+    template<typename Primitive>
+    void DrawCommandBuffer::push(DrawCallType type, const Primitive &primitive, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> *fragmentPipeline, f32 depth, BlendMode blendMode, u32 drawId) {
+        static_assert(std::is_trivially_copyable_v<Primitive>, "Draw command payloads must be trivially copyable");
+
+        const std::size_t offset = m_commands.size();
+        const std::size_t size = (payloadOffset + sizeof(Primitive) + commandAlignment - 1) / commandAlignment * commandAlignment;
+
+        DrawCommandHeader header;
+        header.sortKey = makeSortKey(depth, static_cast<u32>(m_sortEntries.size()));
+        header.fragmentPipeline = fragmentPipeline;
+        header.size = static_cast<u32>(size);
+        header.drawId = drawId;
+        header.blendMode = blendMode;
+        header.type = type;
+
+        m_commands.resize(offset + size);
+        std::byte *command = m_commands.data() + offset;
+        std::memcpy(command, &header, sizeof(header));
+        std::memcpy(command + matrixOffset, &matrix, sizeof(matrix));
+        std::memcpy(command + payloadOffset, &primitive, sizeof(Primitive));
+
+        m_sortEntries.push_back({ header.sortKey, static_cast<u32>(offset) });
+        m_useSortedCommands = false;
+    }
+
+    template<typename Function>
+    void DrawCommandBuffer::forEach(Function &&function) const {
+        const std::vector<std::byte> &commands = m_useSortedCommands ? m_sortedCommands : m_commands;
+
+        DrawCommandHeader header;
+        AffineMatrix<f32> matrix;
+
+        for (std::size_t offset = 0; offset < commands.size(); offset += header.size) {
+            const std::byte *command = commands.data() + offset;
+            std::memcpy(&header, command, sizeof(header));
+            std::memcpy(&matrix, command + matrixOffset, sizeof(matrix));
+
+            function(static_cast<const DrawCommandHeader &>(header), static_cast<const AffineMatrix<f32> &>(matrix), command + payloadOffset);
+        }
+    }
+
+    template<typename Primitive>
+    Primitive DrawCommandBuffer::readPayload(const std::byte *payload) {
+        Primitive primitive;
+        std::memcpy(&primitive, payload, sizeof(Primitive));
+        return primitive;
+    }
+
+    template<typename Primitive>
+    void RenderTarget::registerDrawCall(DrawCallType type, const Primitive &primitive, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode) {
+        m_drawCommands.push(type, primitive, matrix, &fragmentPipeline, depth, blendMode, m_drawId);
+    }
 }
 
 #endif // TEXTIL_RENDER_HPP
\ No newline at end of file
@@ -0,0 +1,215 @@
+/**
+ * @file scene.hpp
+ * @brief Spatial index of drawables for culling and picking
+ * @details Provides the Scene class, which keeps drawables in a uniform grid over their world
+ *          bounding boxes. Drawing a scene submits only the drawables overlapping the view, and
+ *          point and rectangle queries find drawables without testing every one of them.
+ */
+
+#ifndef TIL_SCENE_HPP
+#define TIL_SCENE_HPP
+
+#include "drawables.hpp"
+#include "rect.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace til
+{
+    /**
+     * @brief A collection of drawables indexed by their world bounds
+     * @details Drawables are bucketed into the square cells of a uniform grid that
+     *          their world bounding box (Drawable::getBounds()) overlaps. Queries
+     *          visit only the cells they touch, so their cost depends on the number
+     *          of nearby drawables rather than on the size of the scene.
+     *
+     *          Drawables whose bounds are unknown, or that span more than
+     *          maxCellsPerDrawable cells, are kept in a separate list that every
+     *          query checks directly. Drawables with unknown bounds are always drawn
+     *          but never returned by queries.
+     *
+     *          Drawables are drawn and returned in the order they were added, so
+     *          later drawables appear on top. Bounds tests treat boxes as closed, so
+     *          points and straight lines with zero-sized boxes can still be found.
+     *
+     *          The scene does not observe its drawables. After moving a drawable or
+     *          changing its shape, call update() for it, or updateAll() once per frame
+     *          to re-index everything; only drawables whose covered cells changed are
+     *          moved in the grid.
+     *
+     * @par Example Usage:
+     * @code
+     * Scene scene(32.f);
+     * for (Sprite &tree : trees) {
+     *     scene.add(&tree);
+     * }
+     *
+     * // every frame
+     * player.transform.move(velocity);
+     * scene.update(&player);
+     * scene.draw(renderer, window, { { 0.f, 0.f }, { 160.f, 90.f } });
+     *
+     * Drawable *hovered = scene.pick(mousePosition);
+     * @endcode
+     */
+    class Scene
+    {
+    public:
+
+        static constexpr u32 maxCellsPerDrawable = 64;  ///< Cell count above which a drawable is not bucketed
+
+        /**
+         * @brief Create an empty scene
+         * @param cellSize Edge length of the grid cells in world units
+         * @throws InvalidArgumentError If the cell size is not positive
+         */
+        explicit Scene(f32 cellSize = 64.f);
+
+        /**
+         * @brief Add a drawable to the scene
+         * @param drawable Drawable to add, must outlive its membership
+         * @throws InvalidArgumentError If the drawable is null or already in the scene
+         */
+        void add(Drawable *drawable);
+
+        /**
+         * @brief Remove a drawable from the scene
+         * @param drawable Drawable to remove
+         * @throws InvalidArgumentError If the drawable is not in the scene
+         */
+        void remove(Drawable *drawable);
+
+        /**
+         * @brief Check whether a drawable is in the scene
+         * @param drawable Drawable to look for
+         * @return True if the drawable was added and not removed
+         */
+        bool contains(const Drawable *drawable) const;
+
+        /**
+         * @brief Remove all drawables
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of drawables in the scene
+         * @return Drawable count
+         */
+        u32 getDrawableCount() const;
+
+        /**
+         * @brief Get the grid cell size
+         * @return Edge length of the cells in world units
+         */
+        f32 getCellSize() const;
+
+        /**
+         * @brief Re-index a drawable after its transform or shape changed
+         * @param drawable Drawable to re-index
+         * @throws InvalidArgumentError If the drawable is not in the scene
+         */
+        void update(Drawable *drawable);
+
+        /**
+         * @brief Re-index every drawable
+         * @details Recomputes all bounds; drawables whose covered cells did not
+         *          change stay where they are in the grid.
+         */
+        void updateAll();
+
+        /**
+         * @brief Draw the drawables overlapping a view
+         * @param renderer The renderer to use for drawing operations
+         * @param target The render target to draw onto
+         * @param view Visible region in world coordinates
+         */
+        void draw(Renderer &renderer, RenderTarget &target, const Rect<f32> &view);
+
+        /**
+         * @brief Find the drawables whose bounds overlap a rectangle
+         * @param region Region in world coordinates
+         * @param result Receives the drawables in the order they were added (cleared first)
+         */
+        void queryRect(const Rect<f32> &region, std::vector<Drawable *> &result) const;
+
+        /**
+         * @brief Find the drawables whose bounds contain a point
+         * @param point Point in world coordinates
+         * @param result Receives the drawables in the order they were added (cleared first)
+         */
+        void queryPoint(const Vector2<f32> &point, std::vector<Drawable *> &result) const;
+
+        /**
+         * @brief Find the topmost drawable whose bounds contain a point
+         * @param point Point in world coordinates
+         * @return The most recently added drawable containing the point, or nullptr
+         */
+        Drawable *pick(const Vector2<f32> &point) const;
+
+    private:
+
+        /**
+         * @brief A drawable and where it is indexed
+         */
+        struct Entry
+        {
+            Drawable *drawable = nullptr;     ///< Indexed drawable
+            u64 order = 0;                    ///< Insertion order, higher is drawn later
+            Rect<f32> bounds {};              ///< World bounds at the last update
+            Vector2<i32> firstCell { 0, 0 };  ///< First covered cell, inclusive
+            Vector2<i32> lastCell { -1, -1 }; ///< Last covered cell, inclusive
+            bool bucketed = false;            ///< Whether the entry is stored in grid cells
+            bool bounded = false;             ///< Whether the bounds are known
+            mutable u64 visitStamp = 0;       ///< Query stamp preventing duplicates
+        };
+
+        /**
+         * @brief Pack cell coordinates into a hash key
+         */
+        static u64 cellKey(i32 x, i32 y);
+
+        /**
+         * @brief Recompute the bounds and covered cells of an entry
+         */
+        void computeEntry(Entry &entry) const;
+
+        /**
+         * @brief Store an entry index in the cells or list its entry belongs to
+         */
+        void link(u32 index);
+
+        /**
+         * @brief Remove an entry index from the cells or list its entry belongs to
+         */
+        void unlink(u32 index);
+
+        /**
+         * @brief Get the entry index of a drawable, raising an error if it is not in the scene
+         */
+        u32 findEntry(const Drawable *drawable) const;
+
+        /**
+         * @brief Recompute an entry and move it in the grid if its cells changed
+         */
+        void updateEntry(u32 index);
+
+        /**
+         * @brief Gather the entries overlapping a region that satisfy a predicate
+         * @details Fills m_queryIndices sorted by insertion order.
+         */
+        template<typename Predicate>
+        void collect(const Rect<f32> &region, Predicate predicate) const;
+
+        f32 m_cellSize = 64.f;                                   ///< Edge length of the grid cells
+        f32 m_inverseCellSize = 1.f / 64.f;                      ///< Reciprocal of the cell size
+        std::vector<Entry> m_entries {};                         ///< All drawables, in no particular order
+        std::unordered_map<const Drawable *, u32> m_indices {};  ///< Entry index of each drawable
+        std::unordered_map<u64, std::vector<u32>> m_cells {};    ///< Entry indices per occupied cell
+        std::vector<u32> m_unbucketed {};                        ///< Entries checked by every query
+        u64 m_nextOrder = 0;                                     ///< Order assigned to the next added drawable
+        mutable u64 m_visitStamp = 0;                            ///< Stamp of the running query
+        mutable std::vector<u32> m_queryIndices {};              ///< Scratch list of matching entries
+    };
+}
+
+#endif // TIL_SCENE_HPP
@@ -0,0 +1,258 @@
+/**
+ * @file shared_frame.hpp
+ * @brief Shared-memory frame layout and reader for Textil library
+ * @details Defines the layout of the POSIX shared-memory ring written by SharedFrameExporter
+ *          and provides SharedFrameReader, a header-only reader for other processes. This
+ *          header depends only on numeric_types.hpp and the standard library, so recorders and
+ *          compositors can include it without linking Textil.
+ */
+
+#ifndef TIL_SHARED_FRAME_HPP
+#define TIL_SHARED_FRAME_HPP
+
+#include "numeric_types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace til
+{
+    inline constexpr u32 sharedFrameMagic = 0x52464C54;  ///< "TLFR" in memory
+    inline constexpr u32 sharedFrameVersion = 1;         ///< Layout version
+
+    static_assert(std::atomic<u64>::is_always_lock_free, "Shared frames need lock-free 64-bit atomics");
+
+    /**
+     * @brief One character cell as stored in shared memory
+     * @details Same layout as CharacterCell.
+     */
+    struct SharedFrameCell
+    {
+        u32 codepoint;  ///< Unicode codepoint
+        u8 r;           ///< Red component
+        u8 g;           ///< Green component
+        u8 b;           ///< Blue component
+        u8 a;           ///< Alpha component
+    };
+
+    /**
+     * @brief Header at the start of the shared memory object
+     * @details Followed by slotCount slots of slotStride bytes each.
+     */
+    struct alignas(64) SharedFrameHeader
+    {
+        u32 magic;                       ///< sharedFrameMagic
+        u32 version;                     ///< sharedFrameVersion
+        u32 slotCount;                   ///< Number of slots in the ring
+        u32 slotStride;                  ///< Bytes from one slot to the next
+        u32 maxCells;                    ///< Cell capacity of a slot
+        u32 maxPixels;                   ///< Pixel capacity of a slot
+        std::atomic<u64> latestSequence; ///< Sequence of the newest complete frame, 0 before the first
+    };
+
+    /**
+     * @brief Header of a ring slot
+     * @details Followed by columns * rows SharedFrameCell entries and then
+     *          pixelWidth * pixelHeight RGBA pixels of 4 bytes each.
+     *          Frame n is stored in slot n % slotCount.
+     */
+    struct alignas(64) SharedFrameSlot
+    {
+        std::atomic<u64> lock;  ///< Seqlock, odd while the slot is written
+        u64 sequence;           ///< Sequence of the stored frame
+        u64 timestamp;          ///< Steady clock time of publishing in nanoseconds
+        u32 columns;            ///< Frame width in cells
+        u32 rows;               ///< Frame height in cells
+        u32 pixelWidth;         ///< Pixel buffer width, 0 if none
+        u32 pixelHeight;        ///< Pixel buffer height, 0 if none
+    };
+
+    /**
+     * @brief Zero-copy access to a frame in shared memory
+     * @details The pointers refer directly into the ring. The writer overwrites
+     *          a slot again slotCount frames later; SharedFrameReader::isValid()
+     *          tells whether that happened while the frame was being used.
+     */
+    struct SharedFrameView
+    {
+        u64 sequence = 0;                   ///< Frame sequence number
+        u64 timestamp = 0;                  ///< Steady clock time of publishing in nanoseconds
+        u32 columns = 0;                    ///< Width in cells
+        u32 rows = 0;                       ///< Height in cells
+        u32 pixelWidth = 0;                 ///< Pixel buffer width
+        u32 pixelHeight = 0;                ///< Pixel buffer height
+        const SharedFrameCell *cells = nullptr;  ///< Cells in row-major order
+        const u8 *pixels = nullptr;              ///< RGBA pixels in row-major order
+        const SharedFrameSlot *slot = nullptr;   ///< Slot holding the frame
+        u64 lock = 0;                            ///< Seqlock value when the view was acquired
+    };
+
+    /**
+     * @brief Reads frames published by SharedFrameExporter from another process
+     *
+     * @details The reader maps the shared memory object read-only and never
+     * blocks the writer. Frames are read through a seqlock: acquire() returns
+     * the newest complete frame in place, and isValid() afterwards confirms it
+     * was not overwritten while in use. Readers that need to keep a frame copy
+     * it between acquire() and isValid().
+     *
+     * Available on Linux and macOS.
+     *
+     * @par Example Usage:
+     * @code
+     * SharedFrameReader reader;
+     * if (!reader.open("/textil-frames")) return 1;
+     *
+     * SharedFrameView frame;
+     * if (reader.acquire(frame)) {
+     *     std::vector<SharedFrameCell> copy(frame.cells, frame.cells + frame.columns * frame.rows);
+     *     if (reader.isValid(frame)) record(frame.sequence, copy);
+     * }
+     * @endcode
+     */
+    class SharedFrameReader
+    {
+    public:
+
+        SharedFrameReader() = default;
+
+        /**
+         * @brief Unmap the shared memory
+         */
+        ~SharedFrameReader() {
+            close();
+        }
+
+        SharedFrameReader(const SharedFrameReader &) = delete;
+        SharedFrameReader &operator=(const SharedFrameReader &) = delete;
+
+        /**
+         * @brief Map a shared memory ring
+         * @param name Shared memory object name passed to SharedFrameExporter::open()
+         * @return False if the object does not exist or is not a compatible ring
+         */
+        bool open(const std::string &name) {
+            close();
+
+#if defined(__linux__) || defined(__APPLE__)
+            const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0) return false;
+
+            struct stat info;
+            if (fstat(fd, &info) < 0 || static_cast<std::size_t>(info.st_size) < sizeof(SharedFrameHeader)) {
+                ::close(fd);
+                return false;
+            }
+
+            void *memory = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (memory == MAP_FAILED) return false;
+
+            m_memory = static_cast<const u8 *>(memory);
+            m_size = static_cast<std::size_t>(info.st_size);
+
+            const SharedFrameHeader *header = getHeader();
+            if (
+                header->magic != sharedFrameMagic || header->version != sharedFrameVersion || header->slotCount == 0 ||
+                sizeof(SharedFrameHeader) + static_cast<std::size_t>(header->slotCount) * header->slotStride > m_size
+            ) {
+                close();
+                return false;
+            }
+            return true;
+#else
+            (void)name;
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Unmap the shared memory
+         */
+        void close() {
+#if defined(__linux__) || defined(__APPLE__)
+            if (m_memory) {
+                munmap(const_cast<u8 *>(m_memory), m_size);
+            }
+#endif
+            m_memory = nullptr;
+            m_size = 0;
+        }
+
+        /**
+         * @brief Check whether a ring is mapped
+         * @return True after a successful open()
+         */
+        bool isOpen() const {
+            return m_memory != nullptr;
+        }
+
+        /**
+         * @brief Get the sequence of the newest complete frame
+         * @return Sequence number, 0 if nothing was published yet
+         */
+        u64 getLatestSequence() const {
+            return m_memory ? getHeader()->latestSequence.load(std::memory_order_acquire) : 0;
+        }
+
+        /**
+         * @brief Get the newest complete frame without copying it
+         * @param view Receives the frame
+         * @return False if nothing was published or the slot is being rewritten
+         */
+        bool acquire(SharedFrameView &view) const {
+            const u64 sequence = getLatestSequence();
+            if (sequence == 0) return false;
+
+            const SharedFrameHeader *header = getHeader();
+            const u8 *slotMemory = m_memory + sizeof(SharedFrameHeader) + (sequence % header->slotCount) * header->slotStride;
+            const SharedFrameSlot *slot = reinterpret_cast<const SharedFrameSlot *>(slotMemory);
+
+            const u64 lock = slot->lock.load(std::memory_order_acquire);
+            if (lock & 1) return false;
+
+            view.sequence = slot->sequence;
+            view.timestamp = slot->timestamp;
+            view.columns = slot->columns;
+            view.rows = slot->rows;
+            view.pixelWidth = slot->pixelWidth;
+            view.pixelHeight = slot->pixelHeight;
+            view.cells = reinterpret_cast<const SharedFrameCell *>(slotMemory + sizeof(SharedFrameSlot));
+            view.pixels = slotMemory + sizeof(SharedFrameSlot) + static_cast<std::size_t>(header->maxCells) * sizeof(SharedFrameCell);
+            view.slot = slot;
+            view.lock = lock;
+
+            return isValid(view) && view.sequence == sequence &&
+                   static_cast<u64>(view.columns) * view.rows <= header->maxCells &&
+                   static_cast<u64>(view.pixelWidth) * view.pixelHeight <= header->maxPixels;
+        }
+
+        /**
+         * @brief Check that a frame was not overwritten since acquire()
+         * @param view Frame returned by acquire()
+         * @return True if everything read from the view so far is consistent
+         */
+        bool isValid(const SharedFrameView &view) const {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return view.slot && view.slot->lock.load(std::memory_order_relaxed) == view.lock;
+        }
+
+    private:
+
+        const SharedFrameHeader *getHeader() const {
+            return reinterpret_cast<const SharedFrameHeader *>(m_memory);
+        }
+
+        const u8 *m_memory = nullptr;  ///< Mapped ring
+        std::size_t m_size = 0;        ///< Mapped bytes
+    };
+}
+
+#endif // TIL_SHARED_FRAME_HPP
@@ -127,6 +127,12 @@ namespace til
          */
         void setRawData(const Vector2<u32> &size, std::vector<Color> &&data);
 
+        /**
+         * @brief Get read-only access to the texel array
+         * @return Texels in row-major order, getSize().x * getSize().y entries
+         */
+        const std::vector<Color> &getRawData() const;
+
         /**
          * @brief Load texture from image file
          * @param filepath Path to image file
@@ -0,0 +1,85 @@
+/**
+ * @file texture_target.hpp
+ * @brief Offscreen render target backed by a texture
+ * @details Provides the TextureTarget class, which renders into an offscreen pixel buffer
+ *          whose contents are exposed as a Texture. Content that is expensive to draw but
+ *          rarely changes can be rendered once and then drawn every frame as a Sprite.
+ */
+
+#ifndef TIL_TEXTURE_TARGET_HPP
+#define TIL_TEXTURE_TARGET_HPP
+
+#include "render.hpp"
+#include "texture.hpp"
+
+namespace til
+{
+    /**
+     * @brief Render target whose result is available as a texture
+     * @details A TextureTarget accepts the same draw calls as a Window. After
+     *          render(), getTexture() returns a texture holding the rendered
+     *          pixels, which can be assigned to any number of sprites in any
+     *          number of windows. The texture is refreshed from the pixel buffer
+     *          only when getTexture() is called after the pixels changed, so
+     *          reusing unchanged content costs nothing beyond drawing the sprite.
+     *
+     *          The texture object itself stays the same for the lifetime of the
+     *          target, so sprites may keep pointing at it across refreshes.
+     *
+     * @par Example Usage:
+     * @code
+     * TextureTarget minimap({ 64, 32 });
+     * minimap.setRenderer(&framework.renderer);
+     * mapDrawable.draw(framework.renderer, minimap);
+     * minimap.render();
+     *
+     * Sprite sprite(&minimap.getTexture());
+     * sprite.size = { 64.f, 32.f };
+     * // every frame: sprite.draw(framework.renderer, window);
+     * @endcode
+     */
+    class TextureTarget : public RenderTarget
+    {
+    public:
+
+        /**
+         * @brief Create an empty target
+         * @details The target has zero size until setSize() is called.
+         */
+        TextureTarget() = default;
+
+        /**
+         * @brief Create a target of the given size, cleared to transparent black
+         * @param size Width and height in pixels
+         */
+        TextureTarget(const Vector2<u32> &size);
+
+        /**
+         * @brief Get the target dimensions
+         * @return Width and height in pixels
+         */
+        const Vector2<u32> &getSize() const;
+
+        /**
+         * @brief Resize the target and clear it to transparent black
+         * @param size New width and height in pixels
+         * @throws LogicError If the pixels are locked
+         */
+        void setSize(const Vector2<u32> &size);
+
+        /**
+         * @brief Get the rendered pixels as a texture
+         * @return Texture holding the current pixel buffer contents
+         * @details Copies the pixel buffer into the texture if it changed since
+         *          the previous call, which is detected through the content version.
+         */
+        Texture &getTexture();
+
+    private:
+
+        Texture m_texture {};        ///< Texture mirroring the pixel buffer
+        u64 m_textureVersion = 0;    ///< Content version copied into m_texture
+    };
+}
+
+#endif // TIL_TEXTURE_TARGET_HPP
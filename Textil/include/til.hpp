@@ -78,14 +78,26 @@
  * 
  * @subsection core_types Core Mathematical Types
  * - `Vector2<T>`: 2D vector operations and transformations
+ * - `Rect<T>`: Axis-aligned rectangles for regions, clipping and bounds
  * - `Matrix3<T>`: 3x3 matrices for 2D transformations  
+ * - `AffineMatrix<T>`: compact 2x3 matrices for stored and batched transformations
  * - `Color`: RGBA color with blending operations
  * - Type aliases in `numeric_types.hpp` for consistent numeric types
  * 
  * @subsection rendering_subsystem Rendering Subsystem
  * - `Renderer`: Core graphics pipeline and primitive rendering
  * - `Texture`: Image storage, loading, and sampling
- * - `RenderTarget`: Configurable rendering destinations
+ * - `RenderTarget`: Configurable rendering destinations with dirty-region tracking and an optional ID buffer for picking
+ * - `PixelLock`: Scoped direct access to a render target's pixels
+ * - `TextureTarget`: Offscreen render target whose result is drawn as a texture
+ * - `FragmentRecording` / `CachedDrawable`: Replay of captured output for drawables that did not change
+ * - `Scene`: Uniform grid over drawable bounds for view culling and picking
+ * - `TileMap`: Chunked tile grid drawn from a texture atlas with per-chunk mesh caching and culling
+ * - `SpriteSheet` / `SpriteAnimator` / `SpriteBatch`: Shared clip tables, batched animation updates and single-call sprite drawing
+ * - `Raycaster`: SIMD grid raycaster with textured walls, floor and ceiling, and depth-tested billboards
+ * - `VideoSprite`: Streaming y4m and raw RGBA playback with background decoding and frame dropping
+ * - `Path`: Vector outlines with adaptive curve flattening and stroke tessellation
+ * - `triangulatePolygon()`: O(n log n) triangulation of polygons with holes
  * - Filter pipeline for customizable visual effects
  * 
  * @subsection input_subsystem Input Subsystem  
@@ -98,6 +110,9 @@
  * - `Window`: Independent rendering contexts with transforms
  * - `WindowManager`: Multi-window coordination and depth sorting
  * - `Console`: Low-level terminal interface abstraction
+ * - `GraphicsPresenter`: Kitty graphics and sixel output of changed window regions from a background thread
+ * - `FrameBroadcaster`: Encode-once mirroring of the output to Unix-domain or TCP viewers with keyframe resync
+ * - `SharedFrameExporter` / `SharedFrameReader`: Seqlocked shared-memory frame ring for local recorders and compositors
  * 
  * @subsection text_subsystem Text Rendering
  * - `BitmapFont`: BDF font loading and glyph management
@@ -150,8 +165,11 @@
 
 // Core mathematical types and utilities
 #include "vector2.hpp"
+#include "rect.hpp"
 #include "numeric_types.hpp"
 #include "matrix3.hpp"
+#include "affine_matrix.hpp"
+#include "batch_transform.hpp"
 #include "color.hpp"
 
 // Platform abstraction and system interfaces  
@@ -170,12 +188,24 @@
 #include "transform.hpp"
 #include "texture.hpp"
 #include "render.hpp"
+#include "path.hpp"
+#include "triangulation.hpp"
+#include "texture_target.hpp"
 #include "drawables.hpp"
+#include "scene.hpp"
+#include "tilemap.hpp"
+#include "animation.hpp"
+#include "raycaster.hpp"
+#include "video.hpp"
 
 // Windowing and display management
 #include "character_cell.hpp"
 #include "window.hpp"
 #include "window_manager.hpp"
+#include "broadcast.hpp"
+#include "graphics_output.hpp"
+#include "shared_frame.hpp"
+#include "frame_export.hpp"
 
 // Text rendering and fonts
 #include "text.hpp"
@@ -0,0 +1,201 @@
+/**
+ * @file tilemap.hpp
+ * @brief Chunked tile map drawable for Textil library
+ * @details Provides the TileMap class, which draws a grid of tiles from a texture atlas. Tiles
+ *          are grouped into chunks whose meshes are built once and reused until one of their
+ *          tiles changes, and only chunks inside the render target are submitted, so drawing
+ *          cost follows the visible area rather than the size of the map.
+ */
+
+#ifndef TIL_TILEMAP_HPP
+#define TIL_TILEMAP_HPP
+
+#include "drawables.hpp"
+#include <vector>
+
+namespace til
+{
+    /**
+     * @brief A grid of textured tiles drawn in chunks
+     *
+     * @details Each cell of the map stores a tile id. Id 0 is empty; id n > 0
+     * selects the n-th tile of the atlas, counting left to right and top to
+     * bottom in steps of the atlas tile size. Ids past the end of the atlas
+     * are drawn as empty.
+     *
+     * The map is split into chunks of chunkSize x chunkSize tiles. Every chunk
+     * caches the mesh of its non-empty tiles and is rebuilt only after one of
+     * its tiles changes, or when tileSize or the atlas change. When drawn,
+     * the map finds the tiles covered by the render target through the
+     * inverse of its transform and submits the cached meshes of the
+     * intersecting chunks as a single draw call.
+     *
+     * Tiles are sampled with nearest-neighbor filtering so neighboring atlas
+     * tiles never bleed into each other.
+     *
+     * @par Example Usage:
+     * @code
+     * Texture atlas("tiles.png");              // 8x8 texel tiles
+     * TileMap map({ 1000, 1000 }, &atlas, { 8, 8 });
+     * map.tileSize = { 4.f, 4.f };             // drawn 4x4 pixels each
+     *
+     * map.fill(1);                             // grass everywhere
+     * map.setTile({ 10, 12 }, 5);              // one rock; only its chunk is rebuilt
+     *
+     * map.transform.setPosition(-camera);
+     * map.draw(renderer, window);
+     * @endcode
+     */
+    class TileMap : public Drawable
+    {
+    public:
+
+        static constexpr u32 chunkSize = 32;  ///< Edge length of a chunk in tiles
+
+        Vector2<f32> tileSize { 1.f, 1.f };   ///< Size of one tile in local units
+
+        /**
+         * @brief Create an empty map without an atlas
+         */
+        TileMap();
+
+        /**
+         * @brief Create a map with every tile empty
+         *
+         * @param size Map dimensions in tiles
+         * @param atlas Texture holding the tile images, must outlive the map
+         * @param atlasTileSize Size of one tile in the atlas, in texels
+         *
+         * @throws InvalidArgumentError If the atlas is null or the atlas tile size is zero
+         */
+        TileMap(const Vector2<u32> &size, Texture *atlas, const Vector2<u32> &atlasTileSize);
+
+        /**
+         * @brief Get the map dimensions
+         * @return Width and height in tiles
+         */
+        const Vector2<u32> &getSize() const;
+
+        /**
+         * @brief Resize the map and clear every tile to empty
+         * @param size New width and height in tiles
+         */
+        void setSize(const Vector2<u32> &size);
+
+        /**
+         * @brief Set the tile atlas
+         *
+         * @details Rebuilds every chunk on the next draw. Call it again after
+         * resizing the atlas texture.
+         *
+         * @param atlas Texture holding the tile images, must outlive the map
+         * @param atlasTileSize Size of one tile in the atlas, in texels
+         *
+         * @throws InvalidArgumentError If the atlas is null or the atlas tile size is zero
+         */
+        void setAtlas(Texture *atlas, const Vector2<u32> &atlasTileSize);
+
+        /**
+         * @brief Get the tile atlas
+         * @return Pointer to the atlas, or nullptr if none is set
+         */
+        Texture *getAtlas() const;
+
+        /**
+         * @brief Get the size of one atlas tile
+         * @return Width and height in texels
+         */
+        const Vector2<u32> &getAtlasTileSize() const;
+
+        /**
+         * @brief Get the tile id at a cell
+         * @param position Cell coordinates
+         * @return Tile id, 0 for empty
+         * @throws InvalidArgumentError If the position is outside the map
+         */
+        u32 getTile(const Vector2<u32> &position) const;
+
+        /**
+         * @brief Set the tile id at a cell
+         *
+         * @details Marks only the chunk containing the cell for rebuilding,
+         * and only if the id actually changes.
+         *
+         * @param position Cell coordinates
+         * @param tile Tile id, 0 for empty
+         * @throws InvalidArgumentError If the position is outside the map
+         */
+        void setTile(const Vector2<u32> &position, u32 tile);
+
+        /**
+         * @brief Set every cell to the same tile id
+         * @param tile Tile id, 0 for empty
+         */
+        void fill(u32 tile);
+
+        /**
+         * @brief Add a filter after the atlas sampler
+         * @param filter Pointer to the filter to add
+         */
+        void addFilter(BaseFilter *filter);
+
+        /**
+         * @brief Remove all filters except the atlas sampler
+         */
+        void clearFilters();
+
+        /**
+         * @brief Render the visible chunks of the map
+         *
+         * @param renderer The renderer to use for drawing operations
+         * @param target The render target to draw onto
+         *
+         * @throws LogicError If no atlas is set
+         */
+        void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the box from the origin to size * tileSize
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
+
+    private:
+
+        /**
+         * @brief Cached mesh of one chunk
+         */
+        struct Chunk
+        {
+            std::vector<primitives::Vertex> vertices {};  ///< Two triangles per non-empty tile, in local coordinates
+            bool dirty = true;                            ///< Whether the tiles changed since the mesh was built
+        };
+
+        /**
+         * @brief Rebuild the mesh of a chunk from its tiles
+         * @param chunkPosition Chunk coordinates
+         */
+        void rebuildChunk(const Vector2<u32> &chunkPosition);
+
+        /**
+         * @brief Mark every chunk for rebuilding
+         */
+        void invalidateChunks();
+
+        Vector2<u32> m_size { 0u, 0u };                  ///< Map dimensions in tiles
+        std::vector<u32> m_tiles {};                     ///< Tile ids in row-major order
+        Vector2<u32> m_chunkCount { 0u, 0u };            ///< Number of chunks along each axis
+        std::vector<Chunk> m_chunks {};                  ///< Chunks in row-major order
+
+        Texture *m_atlas = nullptr;                      ///< Texture holding the tile images
+        Vector2<u32> m_atlasTileSize { 1u, 1u };         ///< Size of one atlas tile in texels
+        Vector2<u32> m_builtAtlasSize { 0u, 0u };        ///< Atlas size the chunk meshes were built for
+        Vector2<f32> m_builtTileSize { 0.f, 0.f };       ///< Tile size the chunk meshes were built for
+
+        FilterPipeline<filters::VertexData, filters::VertexData> m_fragmentPipeline {};  ///< Filter pipeline for visual effects
+        filters::TextureSampler m_textureSampler { nullptr };                           ///< Atlas sampling filter
+    };
+}
+
+#endif // TIL_TILEMAP_HPP
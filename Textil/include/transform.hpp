@@ -10,10 +10,12 @@
 #define TIL_TRANSFORM_HPP
 
 #include "matrix3.hpp"
+#include "affine_matrix.hpp"
 #include "vector2.hpp"
 #include "numeric_types.hpp"
 #include <cmath>
 #include <numbers>
+#include <vector>
 
 namespace til
 {
@@ -34,6 +36,15 @@ namespace til
     *          - Rotation is stored internally in radians (positive values rotate clockwise)
     *            but `setRotation()` expects degrees for convenience
     *          - Origin (0,0) is typically top-left corner
+    * 
+    *          The resulting matrix is cached as a 2x3 AffineMatrix and only rebuilt after one
+    *          of the parameters changes. Transforms can be linked into parent/child hierarchies:
+    *          a child's matrix is its parent's matrix composed with its own local matrix.
+    *          Changing a transform marks its subtree dirty, and matrices are recomputed lazily
+    *          the next time they are requested, so untouched subtrees never do any work.
+    * 
+    *          Copies duplicate the transformation parameters and the parent link, but not the
+    *          children. Moving a transform hands its parent and children over to the target.
      */
     class Transform
     {
@@ -58,18 +69,95 @@ namespace til
          */
         Transform(const Vector2<f32>& position, const Vector2<f32>& scale, f32 rotation, const Vector2<f32>& origin);
 
+        /**
+         * @brief Copy constructor
+         * @param other Transform to copy
+         * @details Copies the transformation parameters and attaches the copy to the same parent.
+         *          Children of @p other are not copied.
+         */
+        Transform(const Transform& other);
+
+        /**
+         * @brief Move constructor
+         * @param other Transform to move from
+         * @details Takes over the parameters, the parent and the children of @p other,
+         *          which is left detached.
+         */
+        Transform(Transform&& other) noexcept;
+
+        /**
+         * @brief Copy assignment
+         * @param other Transform to copy
+         * @return Reference to this transform
+         * @details Copies the transformation parameters and the parent link. The children of
+         *          this transform stay attached to it.
+         */
+        Transform& operator=(const Transform& other);
+
+        /**
+         * @brief Move assignment
+         * @param other Transform to move from
+         * @return Reference to this transform
+         * @details Detaches this transform from its current hierarchy, then takes over the
+         *          parameters, the parent and the children of @p other.
+         */
+        Transform& operator=(Transform&& other) noexcept;
+
+        /**
+         * @brief Destructor detaching the transform from its hierarchy
+         * @details Removes the transform from its parent. Children become root transforms.
+         */
+        ~Transform();
+
         /**
          * @brief Generate transformation matrix for graphics operations
          * @return 3x3 transformation matrix representing this transform
-         * @details Converts the transformation parameters into a Matrix3 suitable for
-         *          applying to points and vectors. The matrix encodes the complete
-         *          transformation including origin offset, scaling, rotation, and translation.
+         * @details Expands the cached affine matrix from getAffineMatrix() into a Matrix3.
+         *          The matrix encodes the complete transformation including origin offset,
+         *          scaling, rotation, translation and all parent transforms.
          *          
-         *          Matrix composition order: T * R * S * -O
+         *          Matrix composition order: Parent * T * R * S * -O
          *          Where: T=translation, R=rotation, S=scale, O=origin offset
          */
         Matrix3<f32> getMatrix() const;
 
+        /**
+         * @brief Get the cached matrix including all parent transforms
+         * @return Reference to the world affine matrix
+         * @details Recomputes the matrix only if this transform or one of its ancestors
+         *          changed since the last call.
+         */
+        const AffineMatrix<f32>& getAffineMatrix() const;
+
+        /**
+         * @brief Get the cached matrix of this transform alone
+         * @return Reference to the local affine matrix (T * R * S * -O)
+         * @details Recomputes the matrix, including its sine and cosine, only if one of the
+         *          transformation parameters changed since the last call.
+         */
+        const AffineMatrix<f32>& getLocalAffineMatrix() const;
+
+        /**
+         * @brief Attach this transform to a parent
+         * @param parent New parent transform, or nullptr to make this a root transform
+         * @throws InvalidArgumentError if the parent is this transform or one of its descendants
+         * @details The parent must outlive the link or be detached first. Its destructor
+         *          detaches remaining children automatically.
+         */
+        void setParent(Transform* parent);
+
+        /**
+         * @brief Get the parent transform
+         * @return Pointer to the parent, or nullptr for a root transform
+         */
+        Transform* getParent() const;
+
+        /**
+         * @brief Get the direct children of this transform
+         * @return Transforms whose parent is this transform
+         */
+        const std::vector<Transform*>& getChildren() const;
+
         /**
          * @brief Get current position/translation
          * @return Position vector in world coordinates
@@ -164,11 +252,41 @@ namespace til
         static float radiansToDegrees(float radians);
 
     private:
+        /**
+         * @brief Mark the local matrix and the world matrices of the subtree as outdated
+         */
+        void invalidateLocal();
+
+        /**
+         * @brief Mark the world matrices of this transform and its subtree as outdated
+         * @details Stops at transforms that are already dirty, whose subtrees are dirty as well.
+         */
+        void invalidateWorld();
+
+        /**
+         * @brief Unlink this transform from its parent's child list
+         */
+        void detachFromParent();
+
+        /**
+         * @brief Take over the parent and children of another transform
+         * @param other Transform whose links are transferred; left without links
+         */
+        void adoptLinks(Transform& other);
+
         Vector2<f32> m_position { 0.f, 0.f }; ///< Object position in world coordinates
         Vector2<f32> m_scale { 1.f, 1.f };    ///< Scaling factors for X and Y axes
         f32          m_rotation { 0.f };      ///< Rotation angle in radians
         Vector2<f32> m_origin { 0.f, 0.f };   ///< Origin point for rotation and scaling
 
+        Transform*              m_parent { nullptr }; ///< Parent transform, nullptr for roots
+        std::vector<Transform*> m_children {};        ///< Direct children of this transform
+
+        mutable AffineMatrix<f32> m_localMatrix { AffineMatrix<f32>::identity() }; ///< Cached T * R * S * -O
+        mutable AffineMatrix<f32> m_worldMatrix { AffineMatrix<f32>::identity() }; ///< Cached parent * local
+        mutable bool m_localDirty { true };  ///< Whether m_localMatrix must be rebuilt
+        mutable bool m_worldDirty { true };  ///< Whether m_worldMatrix must be rebuilt
+
     friend class Framework; ///< Framework needs access for internal operations
     };
 }
@@ -0,0 +1,34 @@
+/**
+ * @file triangulation.hpp
+ * @brief Polygon triangulation for filled shapes in Textil library
+ * @details Provides an O(n log n) triangulator for simple polygons with holes. The polygon is
+ *          split into y-monotone pieces with a sweep line, and each piece is triangulated in
+ *          linear time, which keeps outlines with thousands of points fast to fill.
+ */
+
+#ifndef TIL_TRIANGULATION_HPP
+#define TIL_TRIANGULATION_HPP
+
+#include "vector2.hpp"
+#include "numeric_types.hpp"
+#include <vector>
+
+namespace til
+{
+    /**
+     * @brief Triangulate a polygon with holes
+     * @param outline Outer boundary of the polygon, in either winding order
+     * @param holes Boundaries of the holes, in either winding order
+     * @param indices Receives three indices per triangle (cleared first)
+     * @return True if the triangles cover the polygon, false if the input could not be fully triangulated
+     * @details Indices refer to the points of @p outline followed by the points of each hole in
+     *          order, so attributes stored alongside the points can be looked up directly.
+     *          Triangles are emitted with the winding the renderer fills. Holes must lie inside
+     *          the outline and must not overlap each other; boundaries may touch each other or themselves at shared vertices.
+     *          Consecutive duplicate points and rings with fewer than three distinct points are
+     *          ignored. On failure @p indices holds the triangles found so far.
+     */
+    bool triangulatePolygon(const std::vector<Vector2<f32>> &outline, const std::vector<std::vector<Vector2<f32>>> &holes, std::vector<u32> &indices);
+}
+
+#endif // TIL_TRIANGULATION_HPP
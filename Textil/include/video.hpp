@@ -0,0 +1,289 @@
+/**
+ * @file video.hpp
+ * @brief Streaming video playback drawable for Textil library
+ * @details Provides the VideoSprite class, which plays uncompressed video from YUV4MPEG2 (.y4m)
+ *          files or raw RGBA frame streams. Frames are read ahead and converted on a background
+ *          thread into a small ring of textures, and presentation follows the caller's clock,
+ *          dropping frames that can no longer be shown on time.
+ */
+
+#ifndef TIL_VIDEO_HPP
+#define TIL_VIDEO_HPP
+
+#include "drawables.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace til
+{
+    /**
+     * @brief A sprite showing the frames of an uncompressed video
+     *
+     * @details Playback is split into a pipeline. A decoder thread reads frames
+     * sequentially, converts them to RGBA and stores them in a ring of
+     * ringSize textures. update() advances the playback clock, picks the
+     * newest decoded frame that is due, and shows it; due frames that were
+     * overtaken are dropped without being shown. When the decoder itself
+     * falls behind the clock, it skips over late frames in the file without
+     * converting them, so slow playback catches up instead of lagging.
+     *
+     * Supported inputs:
+     * - YUV4MPEG2 files with 4:2:0, 4:2:2, 4:4:4 or monochrome chroma,
+     *   converted with BT.601 limited-range coefficients
+     * - Raw streams of back-to-back RGBA frames of a known size
+     *
+     * The sprite draws like Sprite: a quad of @c size units textured with the
+     * current frame, through the sprite transform and filters. Nothing is
+     * drawn until the first frame has been presented.
+     *
+     * @par Example Usage:
+     * @code
+     * VideoSprite video;
+     * video.open("camera.y4m");
+     * video.size = { 160.f, 90.f };
+     * video.setLooping(true);
+     * video.play();
+     *
+     * while (running) {
+     *     video.update(getDurationInSeconds(framework.getLastUpdateDuration()));
+     *     video.draw(framework.renderer, window);
+     *     framework.display();
+     *     framework.update();
+     * }
+     * @endcode
+     */
+    class VideoSprite : public Drawable
+    {
+    public:
+
+        static constexpr u32 ringSize = 4;  ///< Number of decoded frames kept in flight
+
+        Vector2<f32> size { 10.f, 10.f };   ///< Dimensions of the sprite in world units
+
+        /**
+         * @brief Create a sprite with no video
+         */
+        VideoSprite();
+
+        /**
+         * @brief Stop the decoder thread and close the file
+         */
+        ~VideoSprite();
+
+        VideoSprite(const VideoSprite &) = delete;
+        VideoSprite &operator=(const VideoSprite &) = delete;
+
+        /**
+         * @brief Open a YUV4MPEG2 file
+         * @details Closes any open video. Playback starts paused at the first frame.
+         * @param filepath Path to the .y4m file
+         * @throws InvalidArgumentError If the file cannot be opened or its header is not supported
+         */
+        void open(const std::string &filepath);
+
+        /**
+         * @brief Open a raw stream of RGBA frames
+         * @details Closes any open video. Playback starts paused at the first frame.
+         * @param filepath Path to the file holding back-to-back frames, 4 bytes per pixel
+         * @param frameSize Width and height of every frame in pixels
+         * @param framesPerSecond Playback rate
+         * @throws InvalidArgumentError If the file cannot be opened or the size or rate is zero
+         */
+        void openRaw(const std::string &filepath, const Vector2<u32> &frameSize, f32 framesPerSecond);
+
+        /**
+         * @brief Stop decoding and release the video
+         */
+        void close();
+
+        /**
+         * @brief Check whether a video is open
+         * @return True between a successful open and close()
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Start or resume playback
+         */
+        void play();
+
+        /**
+         * @brief Pause playback, keeping the current frame
+         */
+        void pause();
+
+        /**
+         * @brief Set whether playback restarts after the last frame
+         * @param looping True to loop, false to stop on the last frame
+         */
+        void setLooping(bool looping);
+
+        /**
+         * @brief Check whether playback restarts after the last frame
+         * @return True if looping
+         */
+        bool isLooping() const;
+
+        /**
+         * @brief Check whether playback is running
+         * @return True after play() until pause() or the end of a non-looping video
+         */
+        bool isPlaying() const;
+
+        /**
+         * @brief Check whether a non-looping video showed its last frame
+         * @return True once the decoder reached the end and every decoded frame was presented
+         */
+        bool isFinished() const;
+
+        /**
+         * @brief Advance the playback clock and present the frame that is due
+         * @param deltaTime Elapsed time in seconds, usually the framework's last update duration
+         */
+        void update(f32 deltaTime);
+
+        /**
+         * @brief Get the frame dimensions
+         * @return Width and height in pixels
+         */
+        const Vector2<u32> &getFrameSize() const;
+
+        /**
+         * @brief Get the playback rate
+         * @return Frames per second
+         */
+        f32 getFrameRate() const;
+
+        /**
+         * @brief Get the index of the presented frame
+         * @return Frame index counted from the start of playback, including loops
+         */
+        u64 getCurrentFrame() const;
+
+        /**
+         * @brief Get the number of frames skipped to keep up with the clock
+         * @return Frames dropped by the decoder or by update()
+         */
+        u64 getDroppedFrameCount() const;
+
+        /**
+         * @brief Get the texture of the presented frame
+         * @return Pointer to the frame texture, or nullptr before the first frame
+         */
+        const Texture *getTexture() const;
+
+        /**
+         * @brief Add a filter after the frame sampler
+         * @param filter Pointer to the filter to add
+         */
+        void addFilter(BaseFilter *filter);
+
+        /**
+         * @brief Remove all filters except the frame sampler
+         */
+        void clearFilters();
+
+        /**
+         * @brief Render the presented frame
+         * @param renderer The renderer to use for drawing operations
+         * @param target The render target to draw onto
+         */
+        void draw(Renderer &renderer, RenderTarget &target) override;
+
+        /**
+         * @brief Get the bounding box before transformation
+         * @param bounds Receives the box from the origin to size
+         * @return Always true
+         */
+        bool getLocalBounds(Rect<f32> &bounds) const override;
+
+    private:
+
+        /**
+         * @brief Layout of the frames in the file
+         */
+        enum class Format
+        {
+            Rgba,     ///< Four bytes per pixel
+            Yuv420,   ///< Full luma plane, chroma planes halved in both directions
+            Yuv422,   ///< Full luma plane, chroma planes halved horizontally
+            Yuv444,   ///< Three full planes
+            Mono      ///< Luma plane only
+        };
+
+        /**
+         * @brief A decoded frame slot of the ring
+         */
+        struct Slot
+        {
+            Texture texture {};   ///< Decoded frame
+            u64 frame = 0;        ///< Frame index of the decoded content
+        };
+
+        /**
+         * @brief Start the decoder thread on an opened file
+         */
+        void start();
+
+        /**
+         * @brief Body of the decoder thread
+         */
+        void decodeLoop();
+
+        /**
+         * @brief Skip or read the next frame of the file
+         * @return False at the end of the file
+         */
+        bool readFrame(bool skip);
+
+        /**
+         * @brief Convert the frame in m_frameBytes to RGBA
+         */
+        void convertFrame(std::vector<Color> &pixels) const;
+
+        /**
+         * @brief Size of the pixel data of one frame in the file
+         */
+        std::size_t getFrameByteCount() const;
+
+        std::ifstream m_file;                      ///< Video file, read only by the decoder thread
+        std::streampos m_firstFrame {};            ///< File position of the first frame
+        std::streampos m_fileSize {};              ///< Length of the file in bytes
+        Format m_format = Format::Rgba;            ///< Layout of the frames
+        Vector2<u32> m_frameSize { 0u, 0u };       ///< Frame dimensions in pixels
+        f32 m_framesPerSecond = 0.f;               ///< Playback rate
+        bool m_open = false;                       ///< Whether a video is open
+        std::vector<u8> m_frameBytes {};           ///< Raw bytes of the frame being decoded
+        std::vector<Color> m_decodeScratch {};     ///< Converted pixels moved into the ring
+
+        std::array<Slot, ringSize> m_slots {};     ///< Decoded frame ring
+        std::deque<u32> m_ready {};                ///< Decoded slots in frame order
+        std::vector<u32> m_free {};                ///< Slots the decoder may fill
+        i32 m_presented = -1;                      ///< Slot shown by the sprite, -1 for none
+        bool m_endOfStream = false;                ///< Whether the decoder reached the end of a non-looping video
+        bool m_stop = false;                       ///< Asks the decoder thread to exit
+        std::mutex m_mutex;                        ///< Guards the ring state above
+        std::condition_variable m_condition;       ///< Wakes the decoder when a slot frees up
+
+        std::atomic<bool> m_loop { false };        ///< Whether the decoder wraps around at the end of the file
+        std::atomic<u64> m_targetFrame { 0 };      ///< Frame the clock is at, read by the decoder
+        std::atomic<u64> m_droppedFrames { 0 };    ///< Frames skipped so far
+        std::thread m_decoder;                     ///< Decoder thread
+
+        f64 m_playbackTime = 0.0;                  ///< Seconds of playback so far
+        u64 m_currentFrame = 0;                    ///< Frame index of the presented slot
+        bool m_playing = false;                    ///< Whether the clock advances
+        bool m_finished = false;                   ///< Whether the last frame of a non-looping video was presented
+
+        FilterPipeline<filters::VertexData, filters::VertexData> m_fragmentPipeline {};  ///< Filter pipeline for visual effects
+        filters::TextureSampler m_textureSampler { nullptr };                           ///< Frame sampling filter
+    };
+}
+
+#endif // TIL_VIDEO_HPP
@@ -0,0 +1,431 @@
+#include "til.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace til
+{
+    namespace
+    {
+        constexpr i64 parallelThreshold = 4096;
+
+        void writeQuad(primitives::Vertex *v, const Vector2<f32> &p0, const Vector2<f32> &p1, const Rect<f32> &uv) {
+            const Vector2<f32> uv0 = uv.position;
+            const Vector2<f32> uv1 = uv.getEnd();
+
+            v[0] = { { p0.x, p0.y }, { uv0.x, uv0.y } };
+            v[1] = { { p1.x, p0.y }, { uv1.x, uv0.y } };
+            v[2] = { { p1.x, p1.y }, { uv1.x, uv1.y } };
+            v[3] = { { p0.x, p0.y }, { uv0.x, uv0.y } };
+            v[4] = { { p1.x, p1.y }, { uv1.x, uv1.y } };
+            v[5] = { { p0.x, p1.y }, { uv0.x, uv1.y } };
+        }
+    }
+
+    SpriteSheet::SpriteSheet(Texture *texture) : m_texture(texture) {}
+
+    void SpriteSheet::setTexture(Texture *texture) {
+        m_texture = texture;
+    }
+
+    Texture *SpriteSheet::getTexture() const {
+        return m_texture;
+    }
+
+    u32 SpriteSheet::addFrame(const Rect<u32> &region) {
+        if (!m_texture || m_texture->getSize().x == 0 || m_texture->getSize().y == 0) {
+            invokeError<LogicError>("Cannot add frames to a sprite sheet without a texture");
+        }
+
+        const Vector2<u32> textureSize = m_texture->getSize();
+        const Vector2<u32> end = region.getEnd();
+
+        if (region.isEmpty() || end.x > textureSize.x || end.y > textureSize.y) {
+            invokeError<InvalidArgumentError>("Frame region must be non-empty and inside the texture");
+        }
+
+        const Vector2<f32> scale { 1.f / static_cast<f32>(textureSize.x), 1.f / static_cast<f32>(textureSize.y) };
+        m_frames.push_back({
+            { static_cast<f32>(region.position.x) * scale.x, static_cast<f32>(region.position.y) * scale.y },
+            { static_cast<f32>(region.size.x) * scale.x, static_cast<f32>(region.size.y) * scale.y }
+        });
+
+        return static_cast<u32>(m_frames.size() - 1);
+    }
+
+    u32 SpriteSheet::addFrameGrid(const Vector2<u32> &frameSize) {
+        if (!m_texture || m_texture->getSize().x == 0 || m_texture->getSize().y == 0) {
+            invokeError<LogicError>("Cannot add frames to a sprite sheet without a texture");
+        }
+
+        const Vector2<u32> textureSize = m_texture->getSize();
+        if (frameSize.x == 0 || frameSize.y == 0 || frameSize.x > textureSize.x || frameSize.y > textureSize.y) {
+            invokeError<InvalidArgumentError>("Frame size must be positive and fit inside the texture");
+        }
+
+        const u32 first = static_cast<u32>(m_frames.size());
+        const u32 columns = textureSize.x / frameSize.x;
+        const u32 rows = textureSize.y / frameSize.y;
+
+        for (u32 y = 0; y < rows; ++y) {
+            for (u32 x = 0; x < columns; ++x) {
+                addFrame({ { x * frameSize.x, y * frameSize.y }, frameSize });
+            }
+        }
+
+        return first;
+    }
+
+    u32 SpriteSheet::getFrameCount() const {
+        return static_cast<u32>(m_frames.size());
+    }
+
+    const Rect<f32> &SpriteSheet::getFrameUV(u32 frame) const {
+        if (frame >= m_frames.size()) {
+            invokeError<InvalidArgumentError>("Frame index out of range");
+        }
+        return m_frames[frame];
+    }
+
+    u32 SpriteSheet::addClip(const std::vector<u32> &frames, f32 framesPerSecond, bool loop) {
+        if (frames.empty()) {
+            invokeError<InvalidArgumentError>("Clip must contain at least one frame");
+        }
+
+        if (!(framesPerSecond > 0.f) || !std::isfinite(framesPerSecond)) {
+            invokeError<InvalidArgumentError>("Clip frame rate must be positive");
+        }
+
+        for (u32 frame : frames) {
+            if (frame >= m_frames.size()) {
+                invokeError<InvalidArgumentError>("Clip frame index out of range");
+            }
+        }
+
+        Clip clip;
+        clip.firstFrame = static_cast<u32>(m_clipFrames.size());
+        clip.frameCount = static_cast<u32>(frames.size());
+        clip.frameDuration = 1.f / framesPerSecond;
+        clip.loop = loop;
+
+        m_clipFrames.insert(m_clipFrames.end(), frames.begin(), frames.end());
+        m_clips.push_back(clip);
+
+        return static_cast<u32>(m_clips.size() - 1);
+    }
+
+    u32 SpriteSheet::addClip(u32 firstFrame, u32 frameCount, f32 framesPerSecond, bool loop) {
+        if (frameCount == 0 || firstFrame >= m_frames.size() || frameCount > m_frames.size() - firstFrame) {
+            invokeError<InvalidArgumentError>("Clip frame range must be non-empty and inside the sheet");
+        }
+
+        std::vector<u32> frames(frameCount);
+        for (u32 i = 0; i < frameCount; ++i) {
+            frames[i] = firstFrame + i;
+        }
+
+        return addClip(frames, framesPerSecond, loop);
+    }
+
+    u32 SpriteSheet::getClipCount() const {
+        return static_cast<u32>(m_clips.size());
+    }
+
+    const SpriteSheet::Clip &SpriteSheet::getClip(u32 clip) const {
+        if (clip >= m_clips.size()) {
+            invokeError<InvalidArgumentError>("Clip index out of range");
+        }
+        return m_clips[clip];
+    }
+
+    u32 SpriteSheet::getClipFrame(u32 clip, u32 index) const {
+        const Clip &description = getClip(clip);
+        if (index >= description.frameCount) {
+            invokeError<InvalidArgumentError>("Clip frame position out of range");
+        }
+        return m_clipFrames[description.firstFrame + index];
+    }
+
+    SpriteAnimator::SpriteAnimator(const SpriteSheet *sheet) : m_sheet(sheet) {
+        if (!sheet) {
+            invokeError<InvalidArgumentError>("Sprite sheet pointer cannot be null");
+        }
+    }
+
+    const SpriteSheet *SpriteAnimator::getSheet() const {
+        return m_sheet;
+    }
+
+    u32 SpriteAnimator::add(u32 clip, f32 startTime) {
+        if (clip >= m_sheet->m_clips.size()) {
+            invokeError<InvalidArgumentError>("Clip index out of range");
+        }
+
+        m_clips.push_back(clip);
+        m_times.push_back(startTime);
+        m_speeds.push_back(1.f);
+        m_flags.push_back(0);
+        m_frames.push_back(0);
+
+        const u32 index = static_cast<u32>(m_clips.size() - 1);
+        advance(index, 0.f);
+        return index;
+    }
+
+    void SpriteAnimator::remove(u32 index) {
+        checkIndex(index);
+
+        const std::size_t last = m_clips.size() - 1;
+        m_clips[index] = m_clips[last];
+        m_times[index] = m_times[last];
+        m_speeds[index] = m_speeds[last];
+        m_flags[index] = m_flags[last];
+        m_frames[index] = m_frames[last];
+
+        m_clips.pop_back();
+        m_times.pop_back();
+        m_speeds.pop_back();
+        m_flags.pop_back();
+        m_frames.pop_back();
+    }
+
+    void SpriteAnimator::clear() {
+        m_clips.clear();
+        m_times.clear();
+        m_speeds.clear();
+        m_flags.clear();
+        m_frames.clear();
+    }
+
+    void SpriteAnimator::reserve(u32 count) {
+        m_clips.reserve(count);
+        m_times.reserve(count);
+        m_speeds.reserve(count);
+        m_flags.reserve(count);
+        m_frames.reserve(count);
+    }
+
+    u32 SpriteAnimator::getCount() const {
+        return static_cast<u32>(m_clips.size());
+    }
+
+    void SpriteAnimator::play(u32 index, u32 clip, bool restart) {
+        checkIndex(index);
+
+        if (clip >= m_sheet->m_clips.size()) {
+            invokeError<InvalidArgumentError>("Clip index out of range");
+        }
+
+        if (m_clips[index] == clip && !restart) {
+            return;
+        }
+
+        m_clips[index] = clip;
+        m_times[index] = 0.f;
+        advance(index, 0.f);
+    }
+
+    u32 SpriteAnimator::getClip(u32 index) const {
+        checkIndex(index);
+        return m_clips[index];
+    }
+
+    void SpriteAnimator::setSpeed(u32 index, f32 speed) {
+        checkIndex(index);
+        m_speeds[index] = speed;
+    }
+
+    f32 SpriteAnimator::getSpeed(u32 index) const {
+        checkIndex(index);
+        return m_speeds[index];
+    }
+
+    void SpriteAnimator::setPaused(u32 index, bool paused) {
+        checkIndex(index);
+        m_flags[index] = paused ? (m_flags[index] | pausedFlag) : (m_flags[index] & ~pausedFlag);
+    }
+
+    bool SpriteAnimator::isPaused(u32 index) const {
+        checkIndex(index);
+        return m_flags[index] & pausedFlag;
+    }
+
+    bool SpriteAnimator::isFinished(u32 index) const {
+        checkIndex(index);
+        return m_flags[index] & finishedFlag;
+    }
+
+    u32 SpriteAnimator::getFrame(u32 index) const {
+        checkIndex(index);
+        return m_frames[index];
+    }
+
+    const Rect<f32> &SpriteAnimator::getUV(u32 index) const {
+        checkIndex(index);
+        return m_sheet->m_frames[m_frames[index]];
+    }
+
+    void SpriteAnimator::update(f32 deltaTime) {
+        const i64 count = static_cast<i64>(m_clips.size());
+
+        #pragma omp parallel for if (count >= parallelThreshold)
+        for (i64 i = 0; i < count; ++i) {
+            if (m_flags[i] & pausedFlag) continue;
+            advance(static_cast<u32>(i), deltaTime);
+        }
+    }
+
+    void SpriteAnimator::checkIndex(u32 index) const {
+        if (index >= m_clips.size()) {
+            invokeError<InvalidArgumentError>("Animation instance index out of range");
+        }
+    }
+
+    void SpriteAnimator::advance(u32 index, f32 deltaTime) {
+        const SpriteSheet::Clip &clip = m_sheet->m_clips[m_clips[index]];
+        const f32 duration = static_cast<f32>(clip.frameCount) * clip.frameDuration;
+        const f32 step = deltaTime * m_speeds[index];
+
+        f32 time = m_times[index] + step;
+        u8 flags = m_flags[index] & ~finishedFlag;
+
+        if (!std::isfinite(time)) {
+            time = 0.f;
+        }
+
+        if (clip.loop) {
+            time = std::fmod(time, duration);
+            if (time < 0.f) time += duration;
+            if (time >= duration) time = 0.f;
+        } else if (time >= duration) {
+            time = duration;
+            flags |= step > 0.f ? finishedFlag : 0;
+        } else if (time <= 0.f) {
+            time = 0.f;
+            flags |= step < 0.f ? finishedFlag : 0;
+        }
+
+        const u32 position = std::min(static_cast<u32>(time / clip.frameDuration), clip.frameCount - 1);
+
+        m_times[index] = time;
+        m_flags[index] = flags;
+        m_frames[index] = m_sheet->m_clipFrames[clip.firstFrame + position];
+    }
+
+    SpriteBatch::SpriteBatch() {
+        m_textureSampler.data.samplingMode = Texture::SamplingMode::NearestNeighbor;
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
+    }
+
+    SpriteBatch::SpriteBatch(Texture *texture) : SpriteBatch() {
+        setTexture(texture);
+    }
+
+    void SpriteBatch::setTexture(Texture *texture) {
+        m_texture = texture;
+        m_textureSampler.data.texture = texture;
+    }
+
+    Texture *SpriteBatch::getTexture() const {
+        return m_texture;
+    }
+
+    void SpriteBatch::setSamplingMode(Texture::SamplingMode mode) {
+        m_textureSampler.data.samplingMode = mode;
+    }
+
+    void SpriteBatch::clear() {
+        m_vertices.clear();
+    }
+
+    void SpriteBatch::reserve(u32 count) {
+        m_vertices.reserve(static_cast<std::size_t>(count) * 6);
+    }
+
+    u32 SpriteBatch::getSpriteCount() const {
+        return static_cast<u32>(m_vertices.size() / 6);
+    }
+
+    void SpriteBatch::add(const Rect<f32> &destination, const Rect<f32> &uv) {
+        const Vector2<f32> p0 = destination.position;
+        const Vector2<f32> p1 = destination.getEnd();
+
+        extendBounds({ std::min(p0.x, p1.x), std::min(p0.y, p1.y) }, { std::max(p0.x, p1.x), std::max(p0.y, p1.y) });
+
+        const std::size_t first = m_vertices.size();
+        m_vertices.resize(first + 6);
+        writeQuad(&m_vertices[first], p0, p1, uv);
+    }
+
+    void SpriteBatch::add(const SpriteAnimator &animator, const Vector2<f32> *positions, const Vector2<f32> &size) {
+        const i64 count = static_cast<i64>(animator.getCount());
+        if (count == 0) return;
+
+        Vector2<f32> minimum = positions[0];
+        Vector2<f32> maximum = positions[0];
+        for (i64 i = 1; i < count; ++i) {
+            minimum = { std::min(minimum.x, positions[i].x), std::min(minimum.y, positions[i].y) };
+            maximum = { std::max(maximum.x, positions[i].x), std::max(maximum.y, positions[i].y) };
+        }
+
+        const Vector2<f32> reach = minimum + size;
+        extendBounds({ std::min(minimum.x, reach.x), std::min(minimum.y, reach.y) },
+                     { std::max(maximum.x, maximum.x + size.x), std::max(maximum.y, maximum.y + size.y) });
+
+        const std::size_t first = m_vertices.size();
+        m_vertices.resize(first + static_cast<std::size_t>(count) * 6);
+
+        primitives::Vertex *out = &m_vertices[first];
+        const Rect<f32> *frames = animator.m_sheet->m_frames.data();
+        const u32 *frameIndices = animator.m_frames.data();
+
+        #pragma omp parallel for if (count >= parallelThreshold)
+        for (i64 i = 0; i < count; ++i) {
+            writeQuad(out + i * 6, positions[i], positions[i] + size, frames[frameIndices[i]]);
+        }
+    }
+
+    void SpriteBatch::addFilter(BaseFilter *filter) {
+        m_fragmentPipeline.addFilter(filter).build();
+    }
+
+    void SpriteBatch::clearFilters() {
+        m_fragmentPipeline.clearFilters();
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
+    }
+
+    void SpriteBatch::draw(Renderer &renderer, RenderTarget &target) {
+        if (!m_texture) {
+            invokeError<LogicError>("Cannot draw sprite batch without a texture");
+            return;
+        }
+
+        if (m_vertices.empty() || m_texture->getSize().x == 0 || m_texture->getSize().y == 0) return;
+
+        auto alloc = renderer.allocateMesh(static_cast<u32>(m_vertices.size()));
+        std::copy(m_vertices.begin(), m_vertices.end(), alloc.vertices.begin());
+
+        primitives::TriangleMesh mesh;
+        mesh.firstVertex = alloc.firstVertex;
+        mesh.vertexCount = static_cast<u32>(m_vertices.size());
+
+        renderer.draw(target, mesh, transform, m_fragmentPipeline);
+    }
+
+    bool SpriteBatch::getLocalBounds(Rect<f32> &bounds) const {
+        if (m_vertices.empty()) return false;
+
+        bounds = { m_boundsMin, m_boundsMax - m_boundsMin };
+        return true;
+    }
+
+    void SpriteBatch::extendBounds(const Vector2<f32> &minimum, const Vector2<f32> &maximum) {
+        if (m_vertices.empty()) {
+            m_boundsMin = minimum;
+            m_boundsMax = maximum;
+            return;
+        }
+
+        m_boundsMin = { std::min(m_boundsMin.x, minimum.x), std::min(m_boundsMin.y, minimum.y) };
+        m_boundsMax = { std::max(m_boundsMax.x, maximum.x), std::max(m_boundsMax.y, maximum.y) };
+    }
+}
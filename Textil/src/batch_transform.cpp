@@ -0,0 +1,189 @@
+#include "til.hpp"
+#include <algorithm>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define TIL_BATCH_TRANSFORM_AVX
+    #define TIL_BATCH_TRANSFORM_SSE
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TIL_BATCH_TRANSFORM_SSE
+#endif
+
+namespace til
+{
+    namespace
+    {
+        // Arrays smaller than this are not worth waking up the thread pool for
+        constexpr std::size_t parallelThreshold = 1u << 15;
+        constexpr std::size_t chunkSize = 1u << 13;
+
+        struct Coefficients
+        {
+            f32 a, b, tx;
+            f32 c, d, ty;
+        };
+
+        Coefficients getCoefficients(const AffineMatrix<f32>& matrix) {
+            return {
+                matrix[0][0], matrix[0][1], matrix[0][2],
+                matrix[1][0], matrix[1][1], matrix[1][2]
+            };
+        }
+
+        template<typename Kernel>
+        void forEachChunk(std::size_t count, Kernel kernel) {
+            if (count < parallelThreshold) {
+                kernel(0, count);
+                return;
+            }
+
+            i64 chunkCount = static_cast<i64>((count + chunkSize - 1) / chunkSize);
+
+            #pragma omp parallel for
+            for (i64 chunk = 0; chunk < chunkCount; ++chunk) {
+                std::size_t begin = static_cast<std::size_t>(chunk) * chunkSize;
+                kernel(begin, std::min(chunkSize, count - begin));
+            }
+        }
+
+        void transformInterleavedRange(const Coefficients& m, const f32* input, f32* output, std::size_t count) {
+            std::size_t i = 0;
+
+        #if defined(TIL_BATCH_TRANSFORM_AVX)
+            const __m256 diagonal = _mm256_setr_ps(m.a, m.d, m.a, m.d, m.a, m.d, m.a, m.d);
+            const __m256 crossed = _mm256_setr_ps(m.b, m.c, m.b, m.c, m.b, m.c, m.b, m.c);
+            const __m256 translation = _mm256_setr_ps(m.tx, m.ty, m.tx, m.ty, m.tx, m.ty, m.tx, m.ty);
+
+            for (; i + 4 <= count; i += 4) {
+                __m256 xy = _mm256_loadu_ps(input + i * 2);
+                __m256 yx = _mm256_permute_ps(xy, _MM_SHUFFLE(2, 3, 0, 1));
+                __m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xy, diagonal), _mm256_mul_ps(yx, crossed)), translation);
+                _mm256_storeu_ps(output + i * 2, result);
+            }
+        #endif
+
+        #if defined(TIL_BATCH_TRANSFORM_SSE)
+            const __m128 diagonal4 = _mm_setr_ps(m.a, m.d, m.a, m.d);
+            const __m128 crossed4 = _mm_setr_ps(m.b, m.c, m.b, m.c);
+            const __m128 translation4 = _mm_setr_ps(m.tx, m.ty, m.tx, m.ty);
+
+            for (; i + 2 <= count; i += 2) {
+                __m128 xy = _mm_loadu_ps(input + i * 2);
+                __m128 yx = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 3, 0, 1));
+                __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xy, diagonal4), _mm_mul_ps(yx, crossed4)), translation4);
+                _mm_storeu_ps(output + i * 2, result);
+            }
+        #endif
+
+            for (; i < count; ++i) {
+                f32 x = input[i * 2];
+                f32 y = input[i * 2 + 1];
+                output[i * 2] = m.a * x + m.b * y + m.tx;
+                output[i * 2 + 1] = m.c * x + m.d * y + m.ty;
+            }
+        }
+
+        void transformSeparateRange(const Coefficients& m, const f32* inputX, const f32* inputY, f32* outputX, f32* outputY, std::size_t count) {
+            std::size_t i = 0;
+
+        #if defined(TIL_BATCH_TRANSFORM_AVX)
+            const __m256 a = _mm256_set1_ps(m.a), b = _mm256_set1_ps(m.b), tx = _mm256_set1_ps(m.tx);
+            const __m256 c = _mm256_set1_ps(m.c), d = _mm256_set1_ps(m.d), ty = _mm256_set1_ps(m.ty);
+
+            for (; i + 8 <= count; i += 8) {
+                __m256 x = _mm256_loadu_ps(inputX + i);
+                __m256 y = _mm256_loadu_ps(inputY + i);
+                __m256 resultX = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, x), _mm256_mul_ps(b, y)), tx);
+                __m256 resultY = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c, x), _mm256_mul_ps(d, y)), ty);
+                _mm256_storeu_ps(outputX + i, resultX);
+                _mm256_storeu_ps(outputY + i, resultY);
+            }
+        #endif
+
+        #if defined(TIL_BATCH_TRANSFORM_SSE)
+            const __m128 a4 = _mm_set1_ps(m.a), b4 = _mm_set1_ps(m.b), tx4 = _mm_set1_ps(m.tx);
+            const __m128 c4 = _mm_set1_ps(m.c), d4 = _mm_set1_ps(m.d), ty4 = _mm_set1_ps(m.ty);
+
+            for (; i + 4 <= count; i += 4) {
+                __m128 x = _mm_loadu_ps(inputX + i);
+                __m128 y = _mm_loadu_ps(inputY + i);
+                __m128 resultX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a4, x), _mm_mul_ps(b4, y)), tx4);
+                __m128 resultY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c4, x), _mm_mul_ps(d4, y)), ty4);
+                _mm_storeu_ps(outputX + i, resultX);
+                _mm_storeu_ps(outputY + i, resultY);
+            }
+        #endif
+
+            for (; i < count; ++i) {
+                f32 x = inputX[i];
+                f32 y = inputY[i];
+                outputX[i] = m.a * x + m.b * y + m.tx;
+                outputY[i] = m.c * x + m.d * y + m.ty;
+            }
+        }
+
+        void transformStridedRange(const Coefficients& m, const std::byte* input, std::size_t stride, f32* output, std::size_t count) {
+            std::size_t i = 0;
+
+        #if defined(TIL_BATCH_TRANSFORM_SSE)
+            const __m128 diagonal = _mm_setr_ps(m.a, m.d, m.a, m.d);
+            const __m128 crossed = _mm_setr_ps(m.b, m.c, m.b, m.c);
+            const __m128 translation = _mm_setr_ps(m.tx, m.ty, m.tx, m.ty);
+
+            for (; i + 2 <= count; i += 2) {
+                // 64-bit loads never read past the point itself, whatever follows it in memory
+                __m128 first = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(input + i * stride)));
+                __m128 second = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(input + (i + 1) * stride)));
+                __m128 xy = _mm_movelh_ps(first, second);
+                __m128 yx = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 3, 0, 1));
+                __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xy, diagonal), _mm_mul_ps(yx, crossed)), translation);
+                _mm_storeu_ps(output + i * 2, result);
+            }
+        #endif
+
+            for (; i < count; ++i) {
+                const f32* point = reinterpret_cast<const f32*>(input + i * stride);
+                f32 x = point[0];
+                f32 y = point[1];
+                output[i * 2] = m.a * x + m.b * y + m.tx;
+                output[i * 2 + 1] = m.c * x + m.d * y + m.ty;
+            }
+        }
+    }
+
+    void transformPoints(const AffineMatrix<f32>& matrix, const Vector2<f32>* input, Vector2<f32>* output, std::size_t count) {
+        static_assert(sizeof(Vector2<f32>) == 2 * sizeof(f32), "Vector2<f32> must be tightly packed");
+
+        const Coefficients coefficients = getCoefficients(matrix);
+        const f32* source = reinterpret_cast<const f32*>(input);
+        f32* destination = reinterpret_cast<f32*>(output);
+
+        forEachChunk(count, [&](std::size_t begin, std::size_t length) {
+            transformInterleavedRange(coefficients, source + begin * 2, destination + begin * 2, length);
+        });
+    }
+
+    void transformPoints(const AffineMatrix<f32>& matrix, const f32* inputX, const f32* inputY, f32* outputX, f32* outputY, std::size_t count) {
+        const Coefficients coefficients = getCoefficients(matrix);
+
+        forEachChunk(count, [&](std::size_t begin, std::size_t length) {
+            transformSeparateRange(coefficients, inputX + begin, inputY + begin, outputX + begin, outputY + begin, length);
+        });
+    }
+
+    void transformPointsStrided(const AffineMatrix<f32>& matrix, const Vector2<f32>* input, std::size_t inputStride, Vector2<f32>* output, std::size_t count) {
+        if (inputStride == sizeof(Vector2<f32>)) {
+            transformPoints(matrix, input, output, count);
+            return;
+        }
+
+        const Coefficients coefficients = getCoefficients(matrix);
+        const std::byte* source = reinterpret_cast<const std::byte*>(input);
+        f32* destination = reinterpret_cast<f32*>(output);
+
+        forEachChunk(count, [&](std::size_t begin, std::size_t length) {
+            transformStridedRange(coefficients, source + begin * inputStride, inputStride, destination + begin * 2, length);
+        });
+    }
+}
@@ -0,0 +1,367 @@
+#include "til.hpp"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace til
+{
+    FrameBroadcaster::FrameBroadcaster() = default;
+
+    FrameBroadcaster::~FrameBroadcaster() {
+        close();
+    }
+
+#if defined(__linux__) || defined(__APPLE__)
+
+    namespace
+    {
+        bool setNonBlocking(int fd) {
+            const int flags = fcntl(fd, F_GETFL, 0);
+            return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+        }
+
+        void disableSigpipe([[maybe_unused]] int fd) {
+#ifdef __APPLE__
+            int enabled = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+        }
+
+        ssize_t sendBytes(int fd, const char *data, std::size_t count) {
+#ifdef __linux__
+            return send(fd, data, count, MSG_NOSIGNAL);
+#else
+            return send(fd, data, count, 0);
+#endif
+        }
+
+        // Keeps a partly sent frame so the client still receives whole frames
+        void dropBacklog(std::deque<std::shared_ptr<const std::string>> &queue, std::size_t offset, std::size_t &bufferedBytes) {
+            if (offset > 0 && !queue.empty()) {
+                auto partial = std::move(queue.front());
+                queue.clear();
+                bufferedBytes = partial->size() - offset;
+                queue.push_back(std::move(partial));
+            } else {
+                queue.clear();
+                bufferedBytes = 0;
+            }
+        }
+    }
+
+    void FrameBroadcaster::listenUnix(const std::string &path) {
+        close();
+
+        sockaddr_un address {};
+        if (path.size() >= sizeof(address.sun_path)) {
+            invokeError<InvalidArgumentError>("Unix socket path too long: " + path);
+            return;
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            invokeError<SocketError>("Failed to create Unix socket");
+            return;
+        }
+
+        // Only a stale socket is replaced; any other file at the path is left alone
+        struct stat existing {};
+        if (lstat(path.c_str(), &existing) == 0) {
+            if (!S_ISSOCK(existing.st_mode)) {
+                ::close(fd);
+                invokeError<SocketError>("Path exists and is not a socket: " + path);
+                return;
+            }
+            unlink(path.c_str());
+        }
+
+        if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+            ::close(fd);
+            invokeError<SocketError>("Failed to listen on Unix socket: " + path);
+            return;
+        }
+
+        m_unixPath = path;
+        start(fd);
+    }
+
+    void FrameBroadcaster::listenTcp(u16 port, const std::string &address) {
+        close();
+
+        sockaddr_in socketAddress {};
+        socketAddress.sin_family = AF_INET;
+        socketAddress.sin_port = htons(port);
+        if (inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1) {
+            invokeError<InvalidArgumentError>("Invalid IPv4 address: " + address);
+            return;
+        }
+
+        const int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            invokeError<SocketError>("Failed to create TCP socket");
+            return;
+        }
+
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        socklen_t length = sizeof(socketAddress);
+        if (
+            bind(fd, reinterpret_cast<sockaddr *>(&socketAddress), sizeof(socketAddress)) < 0 ||
+            listen(fd, SOMAXCONN) < 0 ||
+            getsockname(fd, reinterpret_cast<sockaddr *>(&socketAddress), &length) < 0
+        ) {
+            ::close(fd);
+            invokeError<SocketError>("Failed to listen on " + address + ":" + std::to_string(port));
+            return;
+        }
+
+        m_port = ntohs(socketAddress.sin_port);
+        start(fd);
+    }
+
+    void FrameBroadcaster::close() {
+        if (m_network.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            wake();
+            m_network.join();
+        }
+
+        for (Client &client : m_clients) {
+            ::close(client.fd);
+        }
+        m_clients.clear();
+
+        for (int &fd : m_wakeFds) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+
+        if (m_listenFd >= 0) {
+            ::close(m_listenFd);
+            m_listenFd = -1;
+        }
+
+        if (!m_unixPath.empty()) {
+            unlink(m_unixPath.c_str());
+            m_unixPath.clear();
+        }
+
+        m_port = 0;
+        m_stop = false;
+        m_resyncCount = 0;
+        m_needsKeyframe = false;
+    }
+
+    void FrameBroadcaster::broadcast(const std::string &frame, bool keyframe) {
+        if (m_listenFd < 0 || frame.empty()) return;
+
+        auto shared = std::make_shared<const std::string>(frame);
+        bool waiting = false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (Client &client : m_clients) {
+                if (client.waitingForKeyframe) {
+                    if (!keyframe) {
+                        waiting = true;
+                        continue;
+                    }
+                    client.waitingForKeyframe = false;
+                } else if (client.bufferedBytes > 0 && client.bufferedBytes + frame.size() > m_maxBufferedBytes) {
+                    dropBacklog(client.queue, client.offset, client.bufferedBytes);
+                    ++m_resyncCount;
+
+                    if (!keyframe) {
+                        client.waitingForKeyframe = true;
+                        waiting = true;
+                        continue;
+                    }
+                }
+
+                client.queue.push_back(shared);
+                client.bufferedBytes += frame.size();
+            }
+
+            m_needsKeyframe = waiting;
+        }
+
+        wake();
+    }
+
+    void FrameBroadcaster::start(int listenFd) {
+        if (pipe(m_wakeFds) < 0) {
+            ::close(listenFd);
+            invokeError<SocketError>("Failed to create broadcaster wake pipe");
+            return;
+        }
+
+        setNonBlocking(listenFd);
+        setNonBlocking(m_wakeFds[0]);
+        setNonBlocking(m_wakeFds[1]);
+
+        m_listenFd = listenFd;
+        m_network = std::thread(&FrameBroadcaster::networkLoop, this);
+    }
+
+    void FrameBroadcaster::networkLoop() {
+        std::vector<pollfd> fds;
+        char discard[512];
+
+        while (true) {
+            fds.clear();
+            fds.push_back({ m_wakeFds[0], POLLIN, 0 });
+            fds.push_back({ m_listenFd, POLLIN, 0 });
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stop) return;
+
+                for (const Client &client : m_clients) {
+                    fds.push_back({ client.fd, static_cast<short>(client.queue.empty() ? POLLIN : POLLIN | POLLOUT), 0 });
+                }
+            }
+
+            if (poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+
+            if (fds[0].revents & POLLIN) {
+                while (read(m_wakeFds[0], discard, sizeof(discard)) > 0) {}
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop) return;
+
+            // Only this thread adds or removes clients, so they still line up with fds
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < m_clients.size(); ++i) {
+                Client &client = m_clients[i];
+                const short events = fds[i + 2].revents;
+                bool alive = !(events & (POLLERR | POLLNVAL));
+
+                if (alive && (events & (POLLIN | POLLHUP))) {
+                    const ssize_t received = recv(client.fd, discard, sizeof(discard), 0);
+                    alive = received > 0 || (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR));
+                }
+
+                if (alive && (events & POLLOUT)) {
+                    alive = flushClient(client);
+                }
+
+                if (!alive) {
+                    ::close(client.fd);
+                    continue;
+                }
+
+                if (kept != i) {
+                    m_clients[kept] = std::move(client);
+                }
+                ++kept;
+            }
+            m_clients.resize(kept);
+
+            if (fds[1].revents & POLLIN) {
+                while (true) {
+                    const int fd = accept(m_listenFd, nullptr, nullptr);
+                    if (fd < 0) break;
+
+                    setNonBlocking(fd);
+                    disableSigpipe(fd);
+
+                    Client client;
+                    client.fd = fd;
+                    m_clients.push_back(std::move(client));
+                    m_needsKeyframe = true;
+                }
+            }
+        }
+    }
+
+    bool FrameBroadcaster::flushClient(Client &client) {
+        while (!client.queue.empty()) {
+            const std::string &frame = *client.queue.front();
+            const ssize_t sent = sendBytes(client.fd, frame.data() + client.offset, frame.size() - client.offset);
+
+            if (sent < 0) {
+                return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+            }
+
+            client.offset += static_cast<std::size_t>(sent);
+            client.bufferedBytes -= static_cast<std::size_t>(sent);
+
+            if (client.offset == frame.size()) {
+                client.queue.pop_front();
+                client.offset = 0;
+            }
+        }
+        return true;
+    }
+
+    void FrameBroadcaster::wake() {
+        if (m_wakeFds[1] >= 0) {
+            const char byte = 0;
+            [[maybe_unused]] const ssize_t written = write(m_wakeFds[1], &byte, 1);
+        }
+    }
+
+#else
+
+    void FrameBroadcaster::listenUnix(const std::string &) {
+        invokeError<LogicError>("FrameBroadcaster is not supported on this platform");
+    }
+
+    void FrameBroadcaster::listenTcp(u16, const std::string &) {
+        invokeError<LogicError>("FrameBroadcaster is not supported on this platform");
+    }
+
+    void FrameBroadcaster::close() {}
+
+    void FrameBroadcaster::broadcast(const std::string &, bool) {}
+
+#endif // __linux__ || __APPLE__
+
+    bool FrameBroadcaster::isListening() const {
+        return m_listenFd >= 0;
+    }
+
+    u16 FrameBroadcaster::getPort() const {
+        return m_port;
+    }
+
+    bool FrameBroadcaster::needsKeyframe() const {
+        return m_needsKeyframe;
+    }
+
+    u32 FrameBroadcaster::getClientCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<u32>(m_clients.size());
+    }
+
+    u64 FrameBroadcaster::getResyncCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_resyncCount;
+    }
+
+    void FrameBroadcaster::setMaxBufferedBytes(std::size_t bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maxBufferedBytes = bytes;
+    }
+}
@@ -62,6 +62,28 @@ namespace til
         }
     }
 
+    Color::BlendFunction Color::getBlendFunction(BlendMode blendMode) {
+        switch (blendMode)
+        {
+            case BlendMode::None:
+                return &noBlend;
+            case BlendMode::Alpha:
+                return &alphaBlend;
+            case BlendMode::Additive:
+                return &additiveBlend;
+            case BlendMode::Multiplicative:
+                return &multiplicativeBlend;
+            case BlendMode::Subtractive:
+                return &subtractiveBlend;
+            case BlendMode::Screen:
+                return &screenBlend;
+            case BlendMode::Overlay:
+                return &overlayBlend;
+            default:
+                return &noBlend;
+        }
+    }
+
     Color Color::noBlend(Color destination, Color source) {
         return source;
     }
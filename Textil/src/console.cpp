@@ -22,6 +22,45 @@
 
 namespace til
 {
+    void encodeCharacterCells(std::span<const CharacterCell> cells, const Vector2<u32> &size, std::string &output) {
+        if (cells.empty() || size.x == 0 || size.y == 0) {
+            return;
+        }
+
+        Color currentColor = cells[0].color;
+
+        output += "\x1b[38;2;" +
+                  std::to_string(currentColor.r) +
+                  ";" +
+                  std::to_string(currentColor.g) +
+                  ";" +
+                  std::to_string(currentColor.b) +
+                  "m";
+
+        for (u32 y = 0; y < size.y; ++y) {
+            for (u32 x = 0; x < size.x; ++x) {
+                const CharacterCell &cell = cells[y * size.x + x];
+
+                if (cell.color != currentColor) {
+                    currentColor = cell.color;
+                    output += "\x1b[38;2;" +
+                              std::to_string(currentColor.r) +
+                              ";" +
+                              std::to_string(currentColor.g) +
+                              ";" +
+                              std::to_string(currentColor.b) +
+                              "m";
+                }
+
+                utf8::append(cell.codepoint, std::back_inserter(output));
+            }
+
+            output += "\x1b[1E\x1b[0G";
+        }
+
+        output += "\x1b[0m";
+    }
+
     Console::~Console() {
         reset();
     }
@@ -42,6 +81,43 @@ namespace til
 #endif // _WIN32
     }
 
+    void Console::setGraphicsProtocol(GraphicsProtocol protocol) {
+        if (protocol == m_graphicsPresenter.getProtocol()) return;
+
+        m_graphicsPresenter.setProtocol(protocol);
+        m_graphicsPresenter.setCellPixelSize(getCellPixelSize());
+        clear();
+    }
+
+    GraphicsProtocol Console::getGraphicsProtocol() const {
+        return m_graphicsPresenter.getProtocol();
+    }
+
+    GraphicsPresenter &Console::getGraphicsPresenter() {
+        return m_graphicsPresenter;
+    }
+
+    void Console::setBroadcaster(FrameBroadcaster *broadcaster) {
+        m_broadcaster = broadcaster;
+        m_graphicsPresenter.setBroadcaster(broadcaster);
+    }
+
+    void Console::setFrameExporter(SharedFrameExporter *exporter) {
+        m_frameExporter = exporter;
+    }
+
+    Vector2<u32> Console::getCellPixelSize() const {
+#if defined(__linux__) || defined(__APPLE__)
+        struct winsize w;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == -1 || w.ws_col == 0 || w.ws_row == 0) {
+            return { 0u, 0u };
+        }
+        return { static_cast<u32>(w.ws_xpixel / w.ws_col), static_cast<u32>(w.ws_ypixel / w.ws_row) };
+#else
+        return { 0u, 0u };
+#endif
+    }
+
 #ifdef __linux__
 
     std::vector<std::string> Console::findValidKeyboardDevices() {
@@ -183,6 +259,7 @@ namespace til
     void Console::fit(Vector2<u32> newSize) {
         if (newSize != m_screenSize) {
             m_screenSize = newSize;
+            m_graphicsPresenter.setCellPixelSize(getCellPixelSize());
             m_characterBuffer.getBuffer().resize(newSize.x * newSize.y);
             for (auto &cell : m_characterBuffer.getBuffer()) {
                 cell = CharacterCell(32, {255, 255, 255, 255});
@@ -233,6 +310,17 @@ namespace til
         }
     }
 
+    void Console::presentGraphics(std::list<Window> &windows) {
+        for (Window &window : windows) {
+            m_graphicsPresenter.submit(window);
+        }
+        m_graphicsPresenter.present();
+
+        if (m_frameExporter) {
+            m_frameExporter->publish({}, { 0u, 0u });
+        }
+    }
+
     void Console::writeBuffer() {
         m_outputString.clear();
         m_outputString.reserve(m_characterBuffer.getSize() * 4);
@@ -241,38 +329,7 @@ namespace til
             return;
         }
 
-        Color currentColor = m_characterBuffer[0].color;
-
-        m_outputString += "\x1b[38;2;" +
-                          std::to_string(currentColor.r) +
-                          ";" +
-                          std::to_string(currentColor.g) +
-                          ";" +
-                          std::to_string(currentColor.b) +
-                          "m";
-
-        for (u32 y = 0; y < m_screenSize.y; ++y) {
-            for (u32 x = 0; x < m_screenSize.x; ++x) {
-                const CharacterCell &cell = m_characterBuffer[y * m_screenSize.x + x];
-
-                if (cell.color != currentColor) {
-                    currentColor = cell.color;
-                    m_outputString += "\x1b[38;2;" +
-                                    std::to_string(currentColor.r) +
-                                    ";" +
-                                    std::to_string(currentColor.g) +
-                                    ";" +
-                                    std::to_string(currentColor.b) +
-                                    "m";
-                }
-
-                utf8::append(cell.codepoint, std::back_inserter(m_outputString));
-            }
-
-            m_outputString += "\x1b[1E\x1b[0G";
-        }
-
-        m_outputString += "\x1b[0m";
+        encodeCharacterCells(m_characterBuffer.getBuffer(), m_screenSize, m_outputString);
 
 #ifdef _WIN32
         SetConsoleCursorPosition(
@@ -297,6 +354,14 @@ namespace til
         std::cout << m_outputString;
 #endif // __linux__ || __APPLE__
 
+        if (m_broadcaster) {
+            m_broadcaster->broadcast("\x1b[H" + m_outputString, true);
+        }
+
+        if (m_frameExporter) {
+            m_frameExporter->publish(m_characterBuffer.getBuffer(), m_screenSize);
+        }
+
         m_characterBuffer.getBuffer().resize(m_screenSize.x * m_screenSize.y, CharacterCell(32, {255, 255, 255, 255}));
     }
     
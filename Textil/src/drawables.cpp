@@ -1,6 +1,7 @@
 #include "drawables.hpp"
 #include <algorithm>
 #include <limits>
+#include <numbers>
 
 namespace til
 {
@@ -8,6 +9,36 @@ namespace til
         return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
     }
 
+    bool Drawable::getLocalBounds(Rect<f32> &) const {
+        return false;
+    }
+
+    bool Drawable::getBounds(Rect<f32> &bounds) const {
+        Rect<f32> local;
+        if (!getLocalBounds(local)) {
+            return false;
+        }
+
+        const AffineMatrix<f32> &matrix = transform.getAffineMatrix();
+        const Vector2<f32> end = local.getEnd();
+        const Vector2<f32> corners[4] = {
+            matrix * local.position,
+            matrix * Vector2<f32>{ end.x, local.position.y },
+            matrix * end,
+            matrix * Vector2<f32>{ local.position.x, end.y }
+        };
+
+        Vector2<f32> minimum = corners[0];
+        Vector2<f32> maximum = corners[0];
+        for (const Vector2<f32> &corner : corners) {
+            minimum = { std::min(minimum.x, corner.x), std::min(minimum.y, corner.y) };
+            maximum = { std::max(maximum.x, corner.x), std::max(maximum.y, corner.y) };
+        }
+
+        bounds = { minimum, maximum - minimum };
+        return true;
+    }
+
     f32 Polygon::signedArea(const std::vector<Vector2<f32>> &pts) {
         if (pts.size() < 3) return 0.f;
         f32 area = 0.f;
@@ -88,36 +119,66 @@ namespace til
         m_meshDirty = true;
     }
 
+    const std::vector<std::vector<Vector2<f32>>>& Polygon::getHoles() const { return m_holes; }
+
+    void Polygon::addHole(const std::vector<Vector2<f32>> &points) {
+        m_holes.push_back(points);
+        m_meshDirty = true;
+    }
+
+    void Polygon::clearHoles() {
+        m_holes.clear();
+        m_meshDirty = true;
+    }
+
     void Polygon::rebuildMesh() {
         m_builtVertices.clear();
         const size_t n = m_points.size();
         if (n < 3) return;
 
         std::vector<Vector2<f32>> pts = m_points;
-        std::vector<Vector2<f32>> uvsLocal;
-        if (m_hasCustomUVs) {
-            uvsLocal = m_uvs;
-        }
-
-        if (signedArea(pts) < 0.f) {
-            std::reverse(pts.begin(), pts.end());
-            if (m_hasCustomUVs) std::reverse(uvsLocal.begin(), uvsLocal.end());
+        for (const auto &hole : m_holes) {
+            pts.insert(pts.end(), hole.begin(), hole.end());
         }
 
         Vector2<f32> minPt { std::numeric_limits<f32>::max(), std::numeric_limits<f32>::max() };
         Vector2<f32> maxPt { std::numeric_limits<f32>::lowest(), std::numeric_limits<f32>::lowest() };
-        for (const auto &p : pts) {
+        for (const auto &p : m_points) {
             minPt.x = std::min(minPt.x, p.x); minPt.y = std::min(minPt.y, p.y);
             maxPt.x = std::max(maxPt.x, p.x); maxPt.y = std::max(maxPt.y, p.y);
         }
         Vector2<f32> uvSize = { std::max(1e-6f, maxPt.x - minPt.x), std::max(1e-6f, maxPt.y - minPt.y) };
-        auto uvOf = [&](int idx, const Vector2<f32> &p) -> Vector2<f32> {
-            if (m_hasCustomUVs) return uvsLocal[idx];
+        auto uvOf = [&](u32 idx) -> Vector2<f32> {
+            if (m_hasCustomUVs && idx < n) return m_uvs[idx];
+            const Vector2<f32> &p = pts[idx];
             return { (p.x - minPt.x) / uvSize.x, (p.y - minPt.y) / uvSize.y };
         };
 
-        std::vector<int> V(n);
-        for (int i = 0; i < static_cast<int>(n); ++i) V[i] = i;
+        std::vector<u32> indices;
+        if (!triangulatePolygon(m_points, m_holes, indices)) {
+            // Outlines the sweep cannot handle, such as self-intersecting ones, still get a best-effort mesh.
+            // Ear clipping would fill the holes, so invalid holes leave the polygon empty instead of partly filled.
+            indices.clear();
+            if (!m_holes.empty()) return;
+            triangulateEarClipping(indices);
+        }
+
+        m_builtVertices.reserve(indices.size());
+        for (u32 idx : indices) {
+            m_builtVertices.push_back({ pts[idx], uvOf(idx) });
+        }
+    }
+
+    void Polygon::triangulateEarClipping(std::vector<u32> &indices) const {
+        const size_t n = m_points.size();
+        const std::vector<Vector2<f32>> &pts = m_points;
+
+        std::vector<u32> V(n);
+        for (u32 i = 0; i < static_cast<u32>(n); ++i) V[i] = i;
+
+        if (signedArea(pts) < 0.f) {
+            std::reverse(V.begin(), V.end());
+        }
 
         auto isEar = [&](int i0, int i1, int i2) -> bool {
             const Vector2<f32> &a = pts[V[i0]];
@@ -140,16 +201,9 @@ namespace til
             int i2 = (i + 1) % static_cast<int>(V.size());
 
             if (isEar(i0, i1, i2)) {
-                const int ia = V[i0];
-                const int ib = V[i1];
-                const int ic = V[i2];
-                const Vector2<f32> &a = pts[ia];
-                const Vector2<f32> &b = pts[ib];
-                const Vector2<f32> &c = pts[ic];
-
-                m_builtVertices.push_back({ a, uvOf(ia, a) });
-                m_builtVertices.push_back({ b, uvOf(ib, b) });
-                m_builtVertices.push_back({ c, uvOf(ic, c) });
+                indices.push_back(V[i0]);
+                indices.push_back(V[i1]);
+                indices.push_back(V[i2]);
 
                 V.erase(V.begin() + i1);
                 i = 0;
@@ -159,21 +213,10 @@ namespace til
         }
 
         if (V.size() == 3) {
-            const int ia = V[0];
-            const int ib = V[1];
-            const int ic = V[2];
-            const Vector2<f32> &a = pts[ia];
-            const Vector2<f32> &b = pts[ib];
-            const Vector2<f32> &c = pts[ic];
-            if (crossZ(a, b, c) < 0.f) {
-                m_builtVertices.push_back({ a, uvOf(ia, a) });
-                m_builtVertices.push_back({ c, uvOf(ic, c) });
-                m_builtVertices.push_back({ b, uvOf(ib, b) });
-            } else {
-                m_builtVertices.push_back({ a, uvOf(ia, a) });
-                m_builtVertices.push_back({ b, uvOf(ib, b) });
-                m_builtVertices.push_back({ c, uvOf(ic, c) });
+            if (crossZ(pts[V[0]], pts[V[1]], pts[V[2]]) < 0.f) {
+                std::swap(V[1], V[2]);
             }
+            indices.insert(indices.end(), V.begin(), V.end());
         }
     }
 
@@ -194,15 +237,77 @@ namespace til
 
         renderer.draw(target, mesh, transform, fragmentPipeline);
     }
+
+    bool Polygon::getLocalBounds(Rect<f32> &bounds) const {
+        if (m_points.empty()) {
+            bounds = {};
+            return true;
+        }
+
+        Vector2<f32> minimum = m_points.front();
+        Vector2<f32> maximum = m_points.front();
+        for (const auto &p : m_points) {
+            minimum = { std::min(minimum.x, p.x), std::min(minimum.y, p.y) };
+            maximum = { std::max(maximum.x, p.x), std::max(maximum.y, p.y) };
+        }
+
+        bounds = { minimum, maximum - minimum };
+        return true;
+    }
     
     void Point::draw(Renderer &renderer, RenderTarget &target) {
         primitives::Vertex v{ position, uv };
         renderer.draw(target, v, transform, fragmentPipeline);
     }
+
+    bool Point::getLocalBounds(Rect<f32> &bounds) const {
+        bounds = { position, { 0.f, 0.f } };
+        return true;
+    }
     
     void LineDrawable::draw(Renderer &renderer, RenderTarget &target) {
-        primitives::Line l{ { start, uvStart }, { end, uvEnd } };
-        renderer.draw(target, l, transform, fragmentPipeline);
+        if (thickness <= 1.f) {
+            primitives::Line l{ { start, uvStart }, { end, uvEnd } };
+            renderer.draw(target, l, transform, fragmentPipeline);
+            return;
+        }
+
+        if (!m_meshValid || m_builtStart != start || m_builtEnd != end || m_builtThickness != thickness) {
+            m_contours.resize(1);
+            m_contours[0].points = { start, end };
+            m_contours[0].closed = false;
+
+            m_builtVertices.clear();
+            strokePath(m_contours, StrokeStyle{ thickness, LineJoin::Bevel, LineCap::Butt }, 0.25f, m_builtVertices);
+
+            m_meshValid = true;
+            m_builtStart = start;
+            m_builtEnd = end;
+            m_builtThickness = thickness;
+        }
+
+        if (m_builtVertices.empty()) return;
+
+        auto alloc = renderer.allocateMesh(static_cast<u32>(m_builtVertices.size()));
+        for (std::size_t i = 0; i < m_builtVertices.size(); ++i) {
+            alloc.vertices[i].position = m_builtVertices[i].position;
+            alloc.vertices[i].uv = uvStart + (uvEnd - uvStart) * m_builtVertices[i].uv.x;
+        }
+
+        primitives::TriangleMesh mesh;
+        mesh.firstVertex = alloc.firstVertex;
+        mesh.vertexCount = static_cast<u32>(m_builtVertices.size());
+
+        renderer.draw(target, mesh, transform, fragmentPipeline);
+    }
+
+    bool LineDrawable::getLocalBounds(Rect<f32> &bounds) const {
+        const f32 halfThickness = thickness > 1.f ? thickness * 0.5f : 0.f;
+        const Vector2<f32> minimum { std::min(start.x, end.x) - halfThickness, std::min(start.y, end.y) - halfThickness };
+        const Vector2<f32> maximum { std::max(start.x, end.x) + halfThickness, std::max(start.y, end.y) + halfThickness };
+
+        bounds = { minimum, maximum - minimum };
+        return true;
     }
     
     void EllipseDrawable::draw(Renderer &renderer, RenderTarget &target) {
@@ -210,6 +315,12 @@ namespace til
         renderer.draw(target, e, transform, fragmentPipeline);
     }
 
+    bool EllipseDrawable::getLocalBounds(Rect<f32> &bounds) const {
+        const Vector2<f32> extent { std::abs(radii.x), std::abs(radii.y) };
+        bounds = { center - extent, extent * 2.f };
+        return true;
+    }
+
     void Rectangle::draw(Renderer &renderer, RenderTarget &target) {
         auto alloc = renderer.allocateMesh(6);
         auto &v = alloc.vertices;
@@ -227,9 +338,14 @@ namespace til
         renderer.draw(target, mesh, transform, fragmentPipeline);
     }
 
+    bool Rectangle::getLocalBounds(Rect<f32> &bounds) const {
+        bounds = { { std::min(topLeft.x, topLeft.x + size.x), std::min(topLeft.y, topLeft.y + size.y) }, { std::abs(size.x), std::abs(size.y) } };
+        return true;
+    }
+
     Sprite::Sprite() : m_texture(nullptr) {
         m_textureSampler.data.texture = m_texture;
-        m_fragmentPipeline.addFilter(&m_textureSampler);
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
     }
 
     Sprite::Sprite(Texture *texture) : m_texture(texture) {
@@ -238,7 +354,7 @@ namespace til
         }
 
         m_textureSampler.data.texture = m_texture;
-        m_fragmentPipeline.addFilter(&m_textureSampler);
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
     }
 
     void Sprite::setTexture(Texture *texture) {
@@ -265,14 +381,17 @@ namespace til
             return;
         }
 
+        const Vector2<f32> uv0 = textureRect.position;
+        const Vector2<f32> uv1 = textureRect.getEnd();
+
         auto alloc = renderer.allocateMesh(6);
         auto &v = alloc.vertices;
-        v[0] = { { 0.f,     0.f      }, { 0.f, 0.f } };
-        v[1] = { { size.x,  0.f      }, { 1.f, 0.f } };
-        v[2] = { { size.x,  size.y   }, { 1.f, 1.f } };
-        v[3] = { { 0.f,     0.f      }, { 0.f, 0.f } };
-        v[4] = { { size.x,  size.y   }, { 1.f, 1.f } };
-        v[5] = { { 0.f,     size.y   }, { 0.f, 1.f } };
+        v[0] = { { 0.f,     0.f      }, { uv0.x, uv0.y } };
+        v[1] = { { size.x,  0.f      }, { uv1.x, uv0.y } };
+        v[2] = { { size.x,  size.y   }, { uv1.x, uv1.y } };
+        v[3] = { { 0.f,     0.f      }, { uv0.x, uv0.y } };
+        v[4] = { { size.x,  size.y   }, { uv1.x, uv1.y } };
+        v[5] = { { 0.f,     size.y   }, { uv0.x, uv1.y } };
 
         primitives::TriangleMesh mesh;
         mesh.firstVertex = alloc.firstVertex;
@@ -281,22 +400,157 @@ namespace til
         renderer.draw(target, mesh, transform, m_fragmentPipeline);
     }
 
+    bool Sprite::getLocalBounds(Rect<f32> &bounds) const {
+        bounds = { { std::min(0.f, size.x), std::min(0.f, size.y) }, { std::abs(size.x), std::abs(size.y) } };
+        return true;
+    }
+
     void Sprite::addFilter(BaseFilter *filter) {
-        m_fragmentPipeline.addFilter(filter);
+        m_fragmentPipeline.addFilter(filter).build();
     }
 
     void Sprite::insertFilter(u32 index, BaseFilter *filter) {
         u32 realIndex = index + 1;
-        m_fragmentPipeline.insertFilter(realIndex, filter);
+        m_fragmentPipeline.insertFilter(realIndex, filter).build();
     }
 
     void Sprite::removeFilter(u32 index) {
         u32 realIndex = index + 1;
-        m_fragmentPipeline.removeFilter(realIndex);
+        m_fragmentPipeline.removeFilter(realIndex).build();
     }
 
     void Sprite::clearFilters() {
         m_fragmentPipeline.clearFilters();
-        m_fragmentPipeline.addFilter(&m_textureSampler);
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
+    }
+
+    void PathDrawable::draw(Renderer &renderer, RenderTarget &target) {
+        const AffineMatrix<f32> &matrix = transform.getAffineMatrix();
+
+        // Largest stretch of the transform, used to express the pixel tolerance in path units
+        const f32 scale = std::sqrt(std::max(
+            matrix[0][0] * matrix[0][0] + matrix[1][0] * matrix[1][0],
+            matrix[0][1] * matrix[0][1] + matrix[1][1] * matrix[1][1]
+        ));
+
+        if (!(scale > 0.f) || !(tolerance > 0.f)) return;
+
+        // Quarter-octave levels let small zoom changes reuse the mesh; rounding up keeps it within tolerance
+        const i32 scaleLevel = static_cast<i32>(std::ceil(std::log2(scale) * 4.f));
+
+        if (!m_meshValid || m_builtVersion != path.getVersion() || m_builtStroke != stroke || m_builtTolerance != tolerance || m_builtScaleLevel != scaleLevel) {
+            const f32 localTolerance = tolerance / std::exp2(static_cast<f32>(scaleLevel) * 0.25f);
+
+            m_builtVertices.clear();
+            path.flatten(localTolerance, m_contours);
+            strokePath(m_contours, stroke, localTolerance, m_builtVertices);
+
+            m_meshValid = true;
+            m_builtVersion = path.getVersion();
+            m_builtStroke = stroke;
+            m_builtTolerance = tolerance;
+            m_builtScaleLevel = scaleLevel;
+        }
+
+        if (m_builtVertices.empty()) return;
+
+        auto alloc = renderer.allocateMesh(static_cast<u32>(m_builtVertices.size()));
+        std::copy(m_builtVertices.begin(), m_builtVertices.end(), alloc.vertices.begin());
+
+        primitives::TriangleMesh mesh;
+        mesh.firstVertex = alloc.firstVertex;
+        mesh.vertexCount = static_cast<u32>(m_builtVertices.size());
+
+        renderer.draw(target, mesh, transform, fragmentPipeline);
+    }
+
+    bool PathDrawable::getLocalBounds(Rect<f32> &bounds) const {
+        // Square caps reach half the width diagonally, miter joins up to the miter limit times half the width
+        const f32 reachFactor = stroke.join == LineJoin::Miter ? std::max(stroke.miterLimit, std::numbers::sqrt2_v<f32>) : std::numbers::sqrt2_v<f32>;
+        const f32 reach = stroke.width * 0.5f * reachFactor;
+        const Rect<f32> pathBounds = path.getBounds();
+
+        bounds = { pathBounds.position - Vector2<f32>{ reach, reach }, pathBounds.size + Vector2<f32>{ reach, reach } * 2.f };
+        return true;
+    }
+
+    bool CachedDrawable::CacheKey::operator==(const CacheKey &other) const {
+        return target == other.target && generation == other.generation && matrix == other.matrix;
+    }
+
+    CachedDrawable::CachedDrawable(Drawable *drawable, std::size_t memoryLimit) : m_drawable(drawable), m_recording(memoryLimit) {}
+
+    Drawable *CachedDrawable::getDrawable() const {
+        return m_drawable;
+    }
+
+    void CachedDrawable::setDrawable(Drawable *drawable) {
+        m_drawable = drawable;
+        m_recording.clear();
+        m_recordedKey = {};
+        m_lastKey = {};
+        m_generation = 0;
+    }
+
+    void CachedDrawable::invalidate() {
+        ++m_generation;
+    }
+
+    u64 CachedDrawable::getGeneration() const {
+        return m_generation;
+    }
+
+    bool CachedDrawable::isCached() const {
+        return m_recording.isComplete() && m_recordedKey == m_lastKey;
+    }
+
+    std::size_t CachedDrawable::getMemoryLimit() const {
+        return m_recording.getMemoryLimit();
+    }
+
+    void CachedDrawable::setMemoryLimit(std::size_t memoryLimit) {
+        m_recording.setMemoryLimit(memoryLimit);
+    }
+
+    std::size_t CachedDrawable::getMemoryUsage() const {
+        return m_recording.getMemoryUsage();
+    }
+
+    void CachedDrawable::draw(Renderer &renderer, RenderTarget &target) {
+        if (!m_drawable) return;
+
+        const CacheKey key { &target, m_drawable->transform.getAffineMatrix(), m_generation };
+        const bool repeated = key == m_lastKey;
+        m_lastKey = key;
+
+        if (key == m_recordedKey) {
+            if (m_recording.isValidFor(target)) {
+                renderer.draw(target, m_recording);
+                return;
+            }
+            if (m_recording.hasOverflowed()) {
+                m_drawable->draw(renderer, target);
+                return;
+            }
+        }
+
+        // Only capture once the key is stable, so content changing every frame is never recorded
+        if (!repeated) {
+            m_drawable->draw(renderer, target);
+            return;
+        }
+
+        renderer.beginRecording(target, m_recording);
+        m_drawable->draw(renderer, target);
+        renderer.endRecording(target, m_recording);
+        m_recordedKey = key;
+    }
+
+    bool CachedDrawable::getLocalBounds(Rect<f32> &bounds) const {
+        return m_drawable && m_drawable->getLocalBounds(bounds);
+    }
+
+    bool CachedDrawable::getBounds(Rect<f32> &bounds) const {
+        return m_drawable && m_drawable->getBounds(bounds);
     }
-}
\ No newline at end of file
+}
@@ -11,6 +11,10 @@ namespace til
         return m_events[m_currentEventIndex++];
     }
 
+    void EventManager::pushEvent(const Event &event) {
+        m_events.push_back(event);
+    }
+
     void EventManager::discardEvents() {
         m_events.clear();
         m_currentEventIndex = 0;
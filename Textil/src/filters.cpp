@@ -1,6 +1,10 @@
 #include "filters.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <numbers>
 
 namespace til
 {
@@ -218,5 +222,186 @@ namespace til
                 output.color = data.texture->sample(input.uv, data.samplingMode);
             });
         }
+
+        namespace
+        {
+            f32 cross(const Vector2<f32> &a, const Vector2<f32> &b) {
+                return a.x * b.y - a.y * b.x;
+            }
+
+            u32 angleToBin(f32 angle, u32 resolution) {
+                const f32 position = (angle + std::numbers::pi_v<f32>) * (static_cast<f32>(resolution) / (2.f * std::numbers::pi_v<f32>));
+                return std::min(static_cast<u32>(std::max(position, 0.f)), resolution - 1);
+            }
+
+            f32 distanceToSegment(const Vector2<f32> &a, const Vector2<f32> &b) {
+                const Vector2<f32> edge = b - a;
+                const f32 lengthSquared = edge.x * edge.x + edge.y * edge.y;
+                const f32 u = lengthSquared > 0.f ? std::clamp(-(a.x * edge.x + a.y * edge.y) / lengthSquared, 0.f, 1.f) : 0.f;
+                const Vector2<f32> closest = a + edge * u;
+                return std::sqrt(closest.x * closest.x + closest.y * closest.y);
+            }
+
+            // Writes the distance to the occluder, relative to the light, into every bin it covers
+            void rasterizeOccluder(f32 *shadowMap, u32 resolution, const Vector2<f32> &a, const Vector2<f32> &b) {
+                const f32 angleA = std::atan2(a.y, a.x);
+                const f32 angleB = std::atan2(b.y, b.x);
+
+                f32 sweep = angleB - angleA;
+                if (sweep > std::numbers::pi_v<f32>) sweep -= 2.f * std::numbers::pi_v<f32>;
+                if (sweep < -std::numbers::pi_v<f32>) sweep += 2.f * std::numbers::pi_v<f32>;
+
+                const u32 first = angleToBin(sweep >= 0.f ? angleA : angleB, resolution);
+                const u32 last = angleToBin(sweep >= 0.f ? angleB : angleA, resolution);
+                const u32 count = (last + resolution - first) % resolution + 1;
+
+                const Vector2<f32> edge = b - a;
+                const f32 nearestEnd = std::sqrt(std::min(a.x * a.x + a.y * a.y, b.x * b.x + b.y * b.y));
+                const f32 binAngle = 2.f * std::numbers::pi_v<f32> / static_cast<f32>(resolution);
+
+                for (u32 i = 0; i < count; ++i) {
+                    const u32 bin = (first + i) % resolution;
+                    const f32 angle = (static_cast<f32>(bin) + 0.5f) * binAngle - std::numbers::pi_v<f32>;
+                    const Vector2<f32> direction { std::cos(angle), std::sin(angle) };
+
+                    // Bins at the ends may be only partly covered; their center ray can miss the segment
+                    f32 distance = nearestEnd;
+                    const f32 denominator = cross(direction, edge);
+                    if (std::abs(denominator) > 1e-12f) {
+                        const f32 t = cross(a, edge) / denominator;
+                        const f32 u = cross(a, direction) / denominator;
+                        if (t > 0.f && u >= 0.f && u <= 1.f) {
+                            distance = t;
+                        }
+                    }
+
+                    shadowMap[bin] = std::min(shadowMap[bin], distance);
+                }
+            }
+        }
+
+        void LightingData::addRectangleOccluder(const Rect<f32> &rect) {
+            const Vector2<f32> topLeft = rect.position;
+            const Vector2<f32> bottomRight = rect.getEnd();
+            const Vector2<f32> topRight { bottomRight.x, topLeft.y };
+            const Vector2<f32> bottomLeft { topLeft.x, bottomRight.y };
+
+            occluders.push_back({ topLeft, topRight });
+            occluders.push_back({ topRight, bottomRight });
+            occluders.push_back({ bottomRight, bottomLeft });
+            occluders.push_back({ bottomLeft, topLeft });
+        }
+
+        Lighting::Lighting() {
+            executionMode = ExecutionMode::Single;
+
+            setSingleFilterFunction([](FilterableBuffer<Color> &input, FilterableBuffer<Color> &output, const LightingData &data) {
+                const Vector2<u32> size = data.bufferSize;
+                if (size.x == 0 || size.y == 0 || input.getSize() != size.x * size.y || output.getSize() != input.getSize()) return;
+
+                const f32 scale = data.resolutionScale > 0.f ? std::min(data.resolutionScale, 1.f) : 1.f;
+                const Vector2<u32> lightSize {
+                    std::max(1u, static_cast<u32>(std::ceil(static_cast<f32>(size.x) * scale))),
+                    std::max(1u, static_cast<u32>(std::ceil(static_cast<f32>(size.y) * scale)))
+                };
+                const Vector2<f32> toLight { static_cast<f32>(lightSize.x) / static_cast<f32>(size.x), static_cast<f32>(lightSize.y) / static_cast<f32>(size.y) };
+
+                const u32 resolution = std::max(data.shadowMapResolution, 8u);
+                const i64 lightCount = static_cast<i64>(data.lights.size());
+
+                data.m_shadowMaps.assign(static_cast<std::size_t>(lightCount) * resolution, std::numeric_limits<f32>::infinity());
+                data.m_lightBuffer.resize(static_cast<std::size_t>(lightSize.x) * lightSize.y * 3);
+                data.m_lightBufferSize = lightSize;
+
+                #pragma omp parallel for schedule(dynamic) if (lightCount > 1)
+                for (i64 l = 0; l < lightCount; ++l) {
+                    const PointLight &light = data.lights[l];
+                    f32 *shadowMap = data.m_shadowMaps.data() + static_cast<std::size_t>(l) * resolution;
+
+                    for (const Occluder &occluder : data.occluders) {
+                        const Vector2<f32> a = occluder.start - light.position;
+                        const Vector2<f32> b = occluder.end - light.position;
+                        if (distanceToSegment(a, b) >= light.radius) continue;
+
+                        rasterizeOccluder(shadowMap, resolution, a, b);
+                    }
+                }
+
+                // Surfaces within one light texel of an occluder stay lit, so walls show their lit face
+                const f32 bias = 1.f / std::min(toLight.x, toLight.y);
+                const f32 inverse = 1.f / 255.f;
+
+                #pragma omp parallel for
+                for (i64 ly = 0; ly < static_cast<i64>(lightSize.y); ++ly) {
+                    f32 *row = data.m_lightBuffer.data() + static_cast<std::size_t>(ly) * lightSize.x * 3;
+                    const f32 y = (static_cast<f32>(ly) + 0.5f) / toLight.y;
+
+                    for (u32 lx = 0; lx < lightSize.x; ++lx) {
+                        const f32 x = (static_cast<f32>(lx) + 0.5f) / toLight.x;
+                        f32 r = data.ambientColor.r * inverse;
+                        f32 g = data.ambientColor.g * inverse;
+                        f32 b = data.ambientColor.b * inverse;
+
+                        for (i64 l = 0; l < lightCount; ++l) {
+                            const PointLight &light = data.lights[l];
+                            const f32 dx = x - light.position.x;
+                            const f32 dy = y - light.position.y;
+                            const f32 distanceSquared = dx * dx + dy * dy;
+                            if (distanceSquared >= light.radius * light.radius) continue;
+
+                            const f32 distance = std::sqrt(distanceSquared);
+                            const f32 *shadowMap = data.m_shadowMaps.data() + static_cast<std::size_t>(l) * resolution;
+                            if (distance > shadowMap[angleToBin(std::atan2(dy, dx), resolution)] + bias) continue;
+
+                            f32 falloff = 1.f - distance / light.radius;
+                            falloff *= falloff * light.intensity * inverse;
+                            r += light.color.r * falloff;
+                            g += light.color.g * falloff;
+                            b += light.color.b * falloff;
+                        }
+
+                        row[lx * 3 + 0] = r;
+                        row[lx * 3 + 1] = g;
+                        row[lx * 3 + 2] = b;
+                    }
+                }
+
+                const f32 *light = data.m_lightBuffer.data();
+
+                #pragma omp parallel for
+                for (i64 y = 0; y < static_cast<i64>(size.y); ++y) {
+                    const f32 sampleY = std::clamp((static_cast<f32>(y) + 0.5f) * toLight.y - 0.5f, 0.f, static_cast<f32>(lightSize.y - 1));
+                    const u32 y0 = static_cast<u32>(sampleY);
+                    const u32 y1 = std::min(y0 + 1, lightSize.y - 1);
+                    const f32 ty = sampleY - static_cast<f32>(y0);
+
+                    const f32 *row0 = light + static_cast<std::size_t>(y0) * lightSize.x * 3;
+                    const f32 *row1 = light + static_cast<std::size_t>(y1) * lightSize.x * 3;
+
+                    for (u32 x = 0; x < size.x; ++x) {
+                        const f32 sampleX = std::clamp((static_cast<f32>(x) + 0.5f) * toLight.x - 0.5f, 0.f, static_cast<f32>(lightSize.x - 1));
+                        const u32 x0 = static_cast<u32>(sampleX);
+                        const u32 x1 = std::min(x0 + 1, lightSize.x - 1);
+                        const f32 tx = sampleX - static_cast<f32>(x0);
+
+                        const std::size_t index = static_cast<std::size_t>(y) * size.x + x;
+                        const Color &color = input[index];
+                        Color &result = output[index];
+
+                        f32 channels[3];
+                        for (u32 c = 0; c < 3; ++c) {
+                            const f32 top = row0[x0 * 3 + c] + (row0[x1 * 3 + c] - row0[x0 * 3 + c]) * tx;
+                            const f32 bottom = row1[x0 * 3 + c] + (row1[x1 * 3 + c] - row1[x0 * 3 + c]) * tx;
+                            channels[c] = top + (bottom - top) * ty;
+                        }
+
+                        result.r = static_cast<u8>(std::min(color.r * channels[0], 255.f));
+                        result.g = static_cast<u8>(std::min(color.g * channels[1], 255.f));
+                        result.b = static_cast<u8>(std::min(color.b * channels[2], 255.f));
+                        result.a = color.a;
+                    }
+                }
+            });
+        }
     }
 }
\ No newline at end of file
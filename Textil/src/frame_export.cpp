@@ -0,0 +1,184 @@
+#include "til.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+namespace til
+{
+    static_assert(sizeof(CharacterCell) == sizeof(SharedFrameCell), "Shared cells mirror CharacterCell");
+    static_assert(sizeof(Color) == 4, "Shared pixels are stored as RGBA");
+
+    SharedFrameExporter::~SharedFrameExporter() {
+        close();
+    }
+
+#if defined(__linux__) || defined(__APPLE__)
+
+    void SharedFrameExporter::open(const std::string &name, const Vector2<u32> &maxCells, const Vector2<u32> &maxPixels, u32 slotCount) {
+        close();
+
+        if (slotCount == 0) {
+            invokeError<InvalidArgumentError>("Shared frame ring needs at least one slot");
+            return;
+        }
+
+        const std::size_t cellBytes = static_cast<std::size_t>(maxCells.x) * maxCells.y * sizeof(SharedFrameCell);
+        const std::size_t pixelBytes = static_cast<std::size_t>(maxPixels.x) * maxPixels.y * sizeof(Color);
+        const std::size_t slotStride = (sizeof(SharedFrameSlot) + cellBytes + pixelBytes + 63) / 64 * 64;
+        const std::size_t size = sizeof(SharedFrameHeader) + slotStride * slotCount;
+
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+
+        // Only a frame ring left behind under the name is replaced; anything else there is kept
+        if (fd < 0 && errno == EEXIST) {
+            if (!SharedFrameReader().open(name)) {
+                invokeError<SharedMemoryError>("Shared memory object exists and is not a frame ring: " + name);
+                return;
+            }
+            shm_unlink(name.c_str());
+            fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        }
+
+        if (fd < 0) {
+            invokeError<SharedMemoryError>("Failed to create shared memory object: " + name);
+            return;
+        }
+
+        if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+            ::close(fd);
+            shm_unlink(name.c_str());
+            invokeError<SharedMemoryError>("Failed to size shared memory object: " + name);
+            return;
+        }
+
+        void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            invokeError<SharedMemoryError>("Failed to map shared memory object: " + name);
+            return;
+        }
+
+        m_name = name;
+        m_memory = static_cast<u8 *>(memory);
+        m_size = size;
+        m_maxCells = maxCells;
+        m_maxPixels = maxPixels;
+        m_sequence = 0;
+
+        // The object starts zeroed; readers reject it until the magic is set last
+        SharedFrameHeader *header = new (m_memory) SharedFrameHeader {};
+        header->version = sharedFrameVersion;
+        header->slotCount = slotCount;
+        header->slotStride = static_cast<u32>(slotStride);
+        header->maxCells = maxCells.x * maxCells.y;
+        header->maxPixels = maxPixels.x * maxPixels.y;
+        header->latestSequence.store(0, std::memory_order_relaxed);
+
+        for (u32 i = 0; i < slotCount; ++i) {
+            new (m_memory + sizeof(SharedFrameHeader) + i * slotStride) SharedFrameSlot {};
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = sharedFrameMagic;
+    }
+
+    void SharedFrameExporter::close() {
+        if (m_memory) {
+            munmap(m_memory, m_size);
+            shm_unlink(m_name.c_str());
+        }
+
+        m_name.clear();
+        m_memory = nullptr;
+        m_size = 0;
+        m_sequence = 0;
+    }
+
+    void SharedFrameExporter::publish(std::span<const CharacterCell> cells, const Vector2<u32> &size) {
+        if (!m_memory) return;
+
+        if (cells.size() < static_cast<std::size_t>(size.x) * size.y) {
+            invokeError<InvalidArgumentError>("Frame has fewer cells than its size requires");
+            return;
+        }
+
+        SharedFrameHeader *header = reinterpret_cast<SharedFrameHeader *>(m_memory);
+        const u64 sequence = m_sequence + 1;
+        u8 *slotMemory = m_memory + sizeof(SharedFrameHeader) + (sequence % header->slotCount) * header->slotStride;
+        SharedFrameSlot *slot = reinterpret_cast<SharedFrameSlot *>(slotMemory);
+
+        slot->lock.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const u32 columns = std::min(size.x, m_maxCells.x);
+        const u32 rows = std::min(size.y, m_maxCells.y);
+        u8 *cellMemory = slotMemory + sizeof(SharedFrameSlot);
+
+        if (columns == size.x && rows > 0) {
+            std::memcpy(cellMemory, cells.data(), static_cast<std::size_t>(columns) * rows * sizeof(CharacterCell));
+        } else {
+            for (u32 y = 0; y < rows; ++y) {
+                std::memcpy(
+                    cellMemory + static_cast<std::size_t>(y) * columns * sizeof(CharacterCell),
+                    cells.data() + static_cast<std::size_t>(y) * size.x,
+                    columns * sizeof(CharacterCell)
+                );
+            }
+        }
+
+        Vector2<u32> pixelSize { 0u, 0u };
+        if (m_pixelSource && m_maxPixels.x > 0 && m_maxPixels.y > 0) {
+            const Vector2<u32> &sourceSize = m_pixelSource->getBufferSize();
+            pixelSize = { std::min(sourceSize.x, m_maxPixels.x), std::min(sourceSize.y, m_maxPixels.y) };
+
+            u8 *pixelMemory = cellMemory + static_cast<std::size_t>(header->maxCells) * sizeof(SharedFrameCell);
+            PixelLock lock = m_pixelSource->lockPixels({ { 0u, 0u }, pixelSize });
+            lock.setModifiedRegion({});
+
+            for (u32 y = 0; y < lock.getSize().y; ++y) {
+                std::span<Color> row = lock.getRow(y);
+                std::memcpy(pixelMemory + static_cast<std::size_t>(y) * pixelSize.x * sizeof(Color), row.data(), row.size_bytes());
+            }
+        }
+
+        slot->sequence = sequence;
+        slot->timestamp = static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count());
+        slot->columns = columns;
+        slot->rows = rows;
+        slot->pixelWidth = pixelSize.x;
+        slot->pixelHeight = pixelSize.y;
+
+        slot->lock.fetch_add(1, std::memory_order_release);
+        header->latestSequence.store(sequence, std::memory_order_release);
+        m_sequence = sequence;
+    }
+
+#else
+
+    void SharedFrameExporter::open(const std::string &, const Vector2<u32> &, const Vector2<u32> &, u32) {
+        invokeError<LogicError>("SharedFrameExporter is not supported on this platform");
+    }
+
+    void SharedFrameExporter::close() {}
+
+    void SharedFrameExporter::publish(std::span<const CharacterCell>, const Vector2<u32> &) {}
+
+#endif // __linux__ || __APPLE__
+
+    bool SharedFrameExporter::isOpen() const {
+        return m_memory != nullptr;
+    }
+
+    void SharedFrameExporter::setPixelSource(RenderTarget *target) {
+        m_pixelSource = target;
+    }
+
+    u64 SharedFrameExporter::getSequence() const {
+        return m_sequence;
+    }
+}
@@ -24,6 +24,11 @@ namespace til
         windowManager.renderWindows();
         windowManager.sortByDepth();
 
+        if (console.getGraphicsProtocol() != GraphicsProtocol::None) {
+            console.presentGraphics(windowManager.getWindows());
+            return;
+        }
+
         for (const Window& window : windowManager.getWindows()) {
             console.drawWindow(window);
         }
@@ -0,0 +1,460 @@
+#include "til.hpp"
+#include <algorithm>
+#include <array>
+#include <iostream>
+
+namespace til
+{
+    namespace
+    {
+        constexpr u32 kittyChunkSize = 4096;
+
+        constexpr u32 sixelRedLevels = 6;
+        constexpr u32 sixelGreenLevels = 7;
+        constexpr u32 sixelBlueLevels = 6;
+        constexpr u32 sixelPaletteSize = sixelRedLevels * sixelGreenLevels * sixelBlueLevels;
+        constexpr u8 sixelTransparent = 255;
+
+        static_assert(sizeof(Color) == 4, "Kitty output sends Color arrays as raw RGBA");
+        static_assert(sixelPaletteSize < sixelTransparent, "Sixel palette indices must fit below the transparent marker");
+
+        void appendBase64(const u8 *bytes, std::size_t count, std::string &output) {
+            static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+            const std::size_t groups = (count + 2) / 3;
+            const std::size_t offset = output.size();
+            output.resize(offset + groups * 4);
+            char *out = output.data() + offset;
+
+            #pragma omp parallel for
+            for (i64 g = 0; g < static_cast<i64>(groups); ++g) {
+                const std::size_t i = static_cast<std::size_t>(g) * 3;
+                const u32 remaining = static_cast<u32>(std::min<std::size_t>(3, count - i));
+
+                u32 triple = static_cast<u32>(bytes[i]) << 16;
+                if (remaining > 1) triple |= static_cast<u32>(bytes[i + 1]) << 8;
+                if (remaining > 2) triple |= static_cast<u32>(bytes[i + 2]);
+
+                char *quad = out + g * 4;
+                quad[0] = alphabet[(triple >> 18) & 63];
+                quad[1] = alphabet[(triple >> 12) & 63];
+                quad[2] = remaining > 1 ? alphabet[(triple >> 6) & 63] : '=';
+                quad[3] = remaining > 2 ? alphabet[triple & 63] : '=';
+            }
+        }
+
+        void appendCursorPosition(const Vector2<i32> &cell, std::string &output) {
+            // Terminals cannot place anything above or left of the screen
+            output += "\x1b[" + std::to_string(std::max(cell.y, 0) + 1) + ";" + std::to_string(std::max(cell.x, 0) + 1) + "H";
+        }
+
+        u32 quantizeChannel(u8 value, u32 levels) {
+            return (static_cast<u32>(value) * (levels - 1) + 127) / 255;
+        }
+
+        u32 levelToPercent(u32 level, u32 levels) {
+            return (level * 100 + (levels - 1) / 2) / (levels - 1);
+        }
+
+        void appendSixelRun(char sixel, u32 count, std::string &output) {
+            if (count >= 4) {
+                output += '!';
+                output += std::to_string(count);
+                output += sixel;
+            } else {
+                output.append(count, sixel);
+            }
+        }
+    }
+
+    void encodeKittyGraphics(const GraphicsUpdate &update, std::string &output) {
+        std::string control;
+
+        if (update.replace) {
+            appendCursorPosition(update.cellPosition, output);
+            control = "a=T,f=32,s=" + std::to_string(update.imageSize.x) +
+                      ",v=" + std::to_string(update.imageSize.y) +
+                      ",i=" + std::to_string(update.imageId) +
+                      ",p=1,C=1,q=2";
+        } else {
+            control = "a=f,r=1,X=1,f=32,i=" + std::to_string(update.imageId) +
+                      ",x=" + std::to_string(update.region.position.x) +
+                      ",y=" + std::to_string(update.region.position.y) +
+                      ",s=" + std::to_string(update.region.size.x) +
+                      ",v=" + std::to_string(update.region.size.y) +
+                      ",q=2";
+        }
+
+        std::string data;
+        appendBase64(reinterpret_cast<const u8 *>(update.pixels.data()), update.pixels.size() * sizeof(Color), data);
+
+        std::size_t offset = 0;
+        do {
+            const std::size_t length = std::min<std::size_t>(kittyChunkSize, data.size() - offset);
+            const bool more = offset + length < data.size();
+
+            output += "\x1b_G";
+            output += offset == 0 ? control + "," : std::string("q=2,");
+            output += more ? "m=1;" : "m=0;";
+            output.append(data, offset, length);
+            output += "\x1b\\";
+
+            offset += length;
+        } while (offset < data.size());
+    }
+
+    void encodeSixelGraphics(const GraphicsUpdate &update, const Vector2<u32> &cellPixelSize, std::string &output) {
+        const u32 width = update.region.size.x;
+        const u32 height = update.region.size.y;
+        if (width == 0 || height == 0) return;
+
+        std::vector<u8> indices(update.pixels.size());
+
+        #pragma omp parallel for
+        for (i64 i = 0; i < static_cast<i64>(indices.size()); ++i) {
+            const Color &color = update.pixels[i];
+            indices[i] = color.a == 0 ? sixelTransparent : static_cast<u8>(
+                quantizeChannel(color.r, sixelRedLevels) * sixelGreenLevels * sixelBlueLevels +
+                quantizeChannel(color.g, sixelGreenLevels) * sixelBlueLevels +
+                quantizeChannel(color.b, sixelBlueLevels)
+            );
+        }
+
+        std::array<bool, sixelPaletteSize> used {};
+        for (u8 index : indices) {
+            if (index != sixelTransparent) used[index] = true;
+        }
+
+        Vector2<i32> cell = update.cellPosition;
+        if (cellPixelSize.x > 0 && cellPixelSize.y > 0) {
+            cell.x += static_cast<i32>(update.region.position.x / cellPixelSize.x);
+            cell.y += static_cast<i32>(update.region.position.y / cellPixelSize.y);
+        }
+        appendCursorPosition(cell, output);
+
+        // P2 = 1 leaves pixels without a sixel bit unchanged
+        output += "\x1bP0;1;0q\"1;1;" + std::to_string(width) + ";" + std::to_string(height);
+
+        for (u32 i = 0; i < sixelPaletteSize; ++i) {
+            if (!used[i]) continue;
+            const u32 r = i / (sixelGreenLevels * sixelBlueLevels);
+            const u32 g = i / sixelBlueLevels % sixelGreenLevels;
+            const u32 b = i % sixelBlueLevels;
+            output += '#';
+            output += std::to_string(i);
+            output += ";2;";
+            output += std::to_string(levelToPercent(r, sixelRedLevels));
+            output += ';';
+            output += std::to_string(levelToPercent(g, sixelGreenLevels));
+            output += ';';
+            output += std::to_string(levelToPercent(b, sixelBlueLevels));
+        }
+
+        const u32 bandCount = (height + 5) / 6;
+        std::vector<std::string> bands(bandCount);
+
+        #pragma omp parallel
+        {
+            std::vector<u8> bits;
+            std::array<i32, sixelPaletteSize> slots;
+            std::vector<u32> colors;
+
+            #pragma omp for schedule(dynamic)
+            for (i64 band = 0; band < static_cast<i64>(bandCount); ++band) {
+                const u32 top = static_cast<u32>(band) * 6;
+                const u32 rows = std::min(6u, height - top);
+
+                slots.fill(-1);
+                colors.clear();
+                bits.clear();
+
+                for (u32 row = 0; row < rows; ++row) {
+                    const u8 *line = indices.data() + static_cast<std::size_t>(top + row) * width;
+                    for (u32 x = 0; x < width; ++x) {
+                        const u8 index = line[x];
+                        if (index == sixelTransparent) continue;
+
+                        if (slots[index] < 0) {
+                            slots[index] = static_cast<i32>(colors.size());
+                            colors.push_back(index);
+                            bits.resize(colors.size() * width, 0);
+                        }
+                        bits[static_cast<std::size_t>(slots[index]) * width + x] |= static_cast<u8>(1u << row);
+                    }
+                }
+
+                std::string &out = bands[band];
+                for (std::size_t slot = 0; slot < colors.size(); ++slot) {
+                    if (slot > 0) out += '$';
+                    out += '#';
+                    out += std::to_string(colors[slot]);
+
+                    const u8 *line = bits.data() + slot * width;
+                    u32 end = width;
+                    while (end > 0 && line[end - 1] == 0) --end;
+
+                    u32 x = 0;
+                    while (x < end) {
+                        u32 run = x + 1;
+                        while (run < end && line[run] == line[x]) ++run;
+                        appendSixelRun(static_cast<char>(63 + line[x]), run - x, out);
+                        x = run;
+                    }
+                }
+
+                if (static_cast<u32>(band) + 1 < bandCount) out += '-';
+            }
+        }
+
+        for (const std::string &band : bands) {
+            output += band;
+        }
+
+        output += "\x1b\\";
+    }
+
+    GraphicsPresenter::GraphicsPresenter() : m_sink([](const std::string &bytes) {
+        std::cout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        std::cout.flush();
+    }) {}
+
+    GraphicsPresenter::~GraphicsPresenter() {
+        finish();
+
+        if (m_presenter.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+            m_presenter.join();
+        }
+    }
+
+    void GraphicsPresenter::setProtocol(GraphicsProtocol protocol) {
+        finish();
+
+        if (m_protocol == GraphicsProtocol::Kitty && !m_images.empty() && m_sink) {
+            std::string bytes;
+            for (const auto &[id, state] : m_images) {
+                bytes += "\x1b_Ga=d,d=I,i=" + std::to_string(id) + ",q=2\x1b\\";
+            }
+            m_sink(bytes);
+        }
+
+        m_protocol = protocol;
+        m_images.clear();
+        m_submitted.clear();
+        m_keyframePending = true;
+    }
+
+    GraphicsProtocol GraphicsPresenter::getProtocol() const {
+        return m_protocol;
+    }
+
+    void GraphicsPresenter::setCellPixelSize(const Vector2<u32> &size) {
+        m_cellPixelSize = size;
+    }
+
+    const Vector2<u32> &GraphicsPresenter::getCellPixelSize() const {
+        return m_cellPixelSize;
+    }
+
+    void GraphicsPresenter::setSink(Sink sink) {
+        finish();
+        m_sink = std::move(sink);
+    }
+
+    void GraphicsPresenter::setBroadcaster(FrameBroadcaster *broadcaster) {
+        finish();
+        m_broadcaster = broadcaster;
+    }
+
+    void GraphicsPresenter::invalidate() {
+        m_keyframePending = true;
+    }
+
+    void GraphicsPresenter::submit(Window &window) {
+        m_submitted.push_back(&window);
+    }
+
+    void GraphicsPresenter::present() {
+        if (m_protocol == GraphicsProtocol::None) {
+            m_submitted.clear();
+            return;
+        }
+
+        finish();
+
+        const bool sixel = m_protocol == GraphicsProtocol::Sixel;
+
+        const bool keyframe = m_keyframePending || (m_broadcaster && m_broadcaster->needsKeyframe());
+        if (keyframe) {
+            m_images.clear();
+            m_keyframePending = false;
+        }
+
+        std::unordered_map<u32, ImageState> images;
+        bool layoutChanged = false;
+
+        for (Window *window : m_submitted) {
+            const ImageState state { window->getPosition(), window->getSize() };
+            images[window->id] = state;
+
+            auto it = m_images.find(window->id);
+            if (it == m_images.end() || it->second.cellPosition != state.cellPosition || it->second.size != state.size) {
+                layoutChanged = true;
+            }
+        }
+
+        std::vector<u32> deletedImages;
+        for (const auto &[id, state] : m_images) {
+            if (!images.count(id)) {
+                deletedImages.push_back(id);
+                layoutChanged = true;
+            }
+        }
+
+        const bool clearScreen = keyframe || (sixel && layoutChanged);
+
+        std::vector<GraphicsUpdate> updates;
+        for (Window *window : m_submitted) {
+            const Vector2<u32> size = window->getSize();
+            const Rect<u32> bounds { { 0u, 0u }, size };
+
+            auto it = m_images.find(window->id);
+            const bool replace = clearScreen || it == m_images.end() ||
+                                 it->second.cellPosition != window->getPosition() || it->second.size != size;
+
+            Rect<u32> region = replace ? bounds : window->getDirtyRegion().getIntersection(bounds);
+            window->clearDirtyRegion();
+
+            if (region.isEmpty()) continue;
+
+            if (sixel && !replace) {
+                region = alignToCells(region, size);
+            }
+
+            GraphicsUpdate update = takeSnapshot(*window, region, replace);
+            update.cellPosition = window->getPosition();
+            updates.push_back(std::move(update));
+        }
+
+        m_images = std::move(images);
+        m_submitted.clear();
+
+        if (sixel || keyframe) {
+            deletedImages.clear();
+        }
+
+        if (updates.empty() && deletedImages.empty() && !clearScreen) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_inFlight = std::move(updates);
+            m_deletedImages = std::move(deletedImages);
+            m_frameProtocol = m_protocol;
+            m_frameCellPixelSize = m_cellPixelSize;
+            m_clearScreen = clearScreen;
+            m_keyframe = keyframe;
+            m_busy = true;
+        }
+
+        if (!m_presenter.joinable()) {
+            m_presenter = std::thread(&GraphicsPresenter::presentLoop, this);
+        }
+        m_condition.notify_all();
+    }
+
+    void GraphicsPresenter::finish() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return !m_busy; });
+    }
+
+    void GraphicsPresenter::presentLoop() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stop || m_busy; });
+                if (!m_busy) return;
+            }
+
+            encodeFrame();
+            if (m_sink) {
+                m_sink(m_encoded);
+            }
+            if (m_broadcaster) {
+                m_broadcaster->broadcast(m_encoded, m_keyframe);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_inFlight.clear();
+                m_busy = false;
+            }
+            m_condition.notify_all();
+        }
+    }
+
+    GraphicsUpdate GraphicsPresenter::takeSnapshot(Window &window, const Rect<u32> &region, bool replace) {
+        GraphicsUpdate update;
+        update.imageId = window.id;
+        update.imageSize = window.getSize();
+        update.region = region;
+        update.replace = replace;
+        update.pixels.resize(static_cast<std::size_t>(region.size.x) * region.size.y);
+
+        PixelLock lock = window.lockPixels(region);
+        lock.setModifiedRegion({});
+
+        for (u32 y = 0; y < region.size.y; ++y) {
+            std::span<Color> row = lock.getRow(y);
+            std::copy(row.begin(), row.end(), update.pixels.begin() + static_cast<std::size_t>(y) * region.size.x);
+        }
+
+        return update;
+    }
+
+    Rect<u32> GraphicsPresenter::alignToCells(const Rect<u32> &region, const Vector2<u32> &imageSize) const {
+        if (m_cellPixelSize.x == 0 || m_cellPixelSize.y == 0) {
+            return { { 0u, 0u }, imageSize };
+        }
+
+        const Vector2<u32> start {
+            region.position.x / m_cellPixelSize.x * m_cellPixelSize.x,
+            region.position.y / m_cellPixelSize.y * m_cellPixelSize.y
+        };
+        const Vector2<u32> end {
+            std::min((region.position.x + region.size.x + m_cellPixelSize.x - 1) / m_cellPixelSize.x * m_cellPixelSize.x, imageSize.x),
+            std::min((region.position.y + region.size.y + m_cellPixelSize.y - 1) / m_cellPixelSize.y * m_cellPixelSize.y, imageSize.y)
+        };
+
+        return { start, end - start };
+    }
+
+    void GraphicsPresenter::encodeFrame() {
+        m_encoded.clear();
+
+        if (m_clearScreen) {
+            m_encoded += "\x1b[2J";
+        }
+
+        if (m_keyframe && m_frameProtocol == GraphicsProtocol::Kitty) {
+            m_encoded += "\x1b_Ga=d,d=A,q=2\x1b\\";
+        }
+
+        for (u32 id : m_deletedImages) {
+            m_encoded += "\x1b_Ga=d,d=I,i=" + std::to_string(id) + ",q=2\x1b\\";
+        }
+
+        for (const GraphicsUpdate &update : m_inFlight) {
+            if (m_frameProtocol == GraphicsProtocol::Kitty) {
+                encodeKittyGraphics(update, m_encoded);
+            } else {
+                encodeSixelGraphics(update, m_frameCellPixelSize, m_encoded);
+            }
+        }
+    }
+}
@@ -0,0 +1,494 @@
+#include "til.hpp"
+#include <atomic>
+#include <cmath>
+#include <numbers>
+#include <limits>
+
+namespace til
+{
+    namespace
+    {
+        constexpr u32 maxCurveSegments = 1024;
+
+        u64 nextPathVersion() {
+            static std::atomic<u64> counter { 0 };
+            return ++counter;
+        }
+
+        u32 clampSegmentCount(f32 segments) {
+            if (!(segments > 1.f)) {
+                return 1;
+            }
+            return static_cast<u32>(std::min(std::ceil(segments), static_cast<f32>(maxCurveSegments)));
+        }
+
+        // Segments needed so that chords of a circular arc stay within the tolerance (sagitta bound)
+        u32 arcSegmentCount(f32 radius, f32 tolerance, f32 sweep) {
+            f32 step = (tolerance < radius) ? 2.f * std::acos(1.f - tolerance / radius) : std::numbers::pi_v<f32>;
+            return clampSegmentCount(std::abs(sweep) / std::max(step, 1e-4f));
+        }
+
+        f32 cross(const Vector2<f32> &a, const Vector2<f32> &b) {
+            return a.x * b.y - a.y * b.x;
+        }
+
+        Vector2<f32> perpendicular(const Vector2<f32> &direction) {
+            return { -direction.y, direction.x };
+        }
+
+        Vector2<f32> normalizeOrZero(const Vector2<f32> &vector) {
+            f32 length = vector.magnitude();
+            return length > 0.f ? vector / length : Vector2<f32>{ 0.f, 0.f };
+        }
+    }
+
+    void Path::addVerb(Verb verb) {
+        m_verbs.push_back(verb);
+        m_version = nextPathVersion();
+    }
+
+    void Path::ensureSubpath() {
+        // Drawing after close() continues from the start of the closed subpath
+        if (m_subpathClosed) {
+            moveTo(m_subpathStart);
+        }
+    }
+
+    void Path::moveTo(const Vector2<f32> &point) {
+        addVerb(Verb::MoveTo);
+        m_points.push_back(point);
+
+        m_currentPoint = point;
+        m_subpathStart = point;
+        m_hasCurrentPoint = true;
+        m_subpathClosed = false;
+    }
+
+    void Path::lineTo(const Vector2<f32> &point) {
+        if (!m_hasCurrentPoint) {
+            moveTo(point);
+            return;
+        }
+
+        ensureSubpath();
+
+        addVerb(Verb::LineTo);
+        m_points.push_back(point);
+        m_currentPoint = point;
+    }
+
+    void Path::quadTo(const Vector2<f32> &control, const Vector2<f32> &point) {
+        if (!m_hasCurrentPoint) {
+            moveTo(control);
+        }
+
+        ensureSubpath();
+
+        addVerb(Verb::QuadTo);
+        m_points.push_back(control);
+        m_points.push_back(point);
+        m_currentPoint = point;
+    }
+
+    void Path::cubicTo(const Vector2<f32> &control1, const Vector2<f32> &control2, const Vector2<f32> &point) {
+        if (!m_hasCurrentPoint) {
+            moveTo(control1);
+        }
+
+        ensureSubpath();
+
+        addVerb(Verb::CubicTo);
+        m_points.push_back(control1);
+        m_points.push_back(control2);
+        m_points.push_back(point);
+        m_currentPoint = point;
+    }
+
+    void Path::arcTo(const Vector2<f32> &corner, const Vector2<f32> &point, f32 radius) {
+        if (!m_hasCurrentPoint) {
+            moveTo(corner);
+            return;
+        }
+
+        ensureSubpath();
+
+        const Vector2<f32> toStart = m_currentPoint - corner;
+        const Vector2<f32> toEnd = point - corner;
+        const f32 startLength = toStart.magnitude();
+        const f32 endLength = toEnd.magnitude();
+
+        if (radius <= 0.f || startLength <= 0.f || endLength <= 0.f) {
+            lineTo(corner);
+            return;
+        }
+
+        const Vector2<f32> startDirection = toStart / startLength;
+        const Vector2<f32> endDirection = toEnd / endLength;
+
+        if (std::abs(cross(startDirection, endDirection)) < 1e-6f) {
+            lineTo(corner);
+            return;
+        }
+
+        // Angle between the two tangent lines at the corner
+        const f32 angle = std::acos(std::clamp(startDirection.dot(endDirection), -1.f, 1.f));
+        const f32 tangentDistance = radius / std::tan(angle * 0.5f);
+
+        const Vector2<f32> arcStart = corner + startDirection * tangentDistance;
+        const Vector2<f32> arcEnd = corner + endDirection * tangentDistance;
+        const Vector2<f32> center = corner + normalizeOrZero(startDirection + endDirection) * (radius / std::sin(angle * 0.5f));
+
+        lineTo(arcStart);
+
+        const f32 startAngle = std::atan2(arcStart.y - center.y, arcStart.x - center.x);
+        const f32 endAngle = std::atan2(arcEnd.y - center.y, arcEnd.x - center.x);
+
+        f32 sweep = endAngle - startAngle;
+        if (sweep > std::numbers::pi_v<f32>) sweep -= 2.f * std::numbers::pi_v<f32>;
+        if (sweep < -std::numbers::pi_v<f32>) sweep += 2.f * std::numbers::pi_v<f32>;
+
+        addVerb(Verb::Arc);
+        m_points.push_back(center);
+        m_points.push_back({ radius, radius });
+        m_points.push_back({ startAngle, sweep });
+        m_currentPoint = arcEnd;
+    }
+
+    void Path::close() {
+        if (!m_hasCurrentPoint || m_subpathClosed) {
+            return;
+        }
+
+        addVerb(Verb::Close);
+        m_currentPoint = m_subpathStart;
+        m_subpathClosed = true;
+    }
+
+    void Path::clear() {
+        m_verbs.clear();
+        m_points.clear();
+        m_hasCurrentPoint = false;
+        m_subpathClosed = false;
+        m_version = nextPathVersion();
+    }
+
+    bool Path::isEmpty() const {
+        return m_verbs.empty();
+    }
+
+    u64 Path::getVersion() const {
+        return m_version;
+    }
+
+    Rect<f32> Path::getBounds() const {
+        if (m_points.empty()) {
+            return {};
+        }
+
+        Vector2<f32> minimum { std::numeric_limits<f32>::max(), std::numeric_limits<f32>::max() };
+        Vector2<f32> maximum { std::numeric_limits<f32>::lowest(), std::numeric_limits<f32>::lowest() };
+
+        auto include = [&](const Vector2<f32> &point) {
+            minimum = { std::min(minimum.x, point.x), std::min(minimum.y, point.y) };
+            maximum = { std::max(maximum.x, point.x), std::max(maximum.y, point.y) };
+        };
+
+        std::size_t operand = 0;
+
+        for (Verb verb : m_verbs) {
+            switch (verb) {
+                case Verb::MoveTo:
+                case Verb::LineTo:
+                    include(m_points[operand++]);
+                    break;
+                case Verb::QuadTo:
+                    include(m_points[operand++]);
+                    include(m_points[operand++]);
+                    break;
+                case Verb::CubicTo:
+                    include(m_points[operand++]);
+                    include(m_points[operand++]);
+                    include(m_points[operand++]);
+                    break;
+                case Verb::Arc: {
+                    // The whole circle is a cheap bound for any sweep
+                    const Vector2<f32> &center = m_points[operand];
+                    const f32 radius = m_points[operand + 1].x;
+                    include(center - Vector2<f32>{ radius, radius });
+                    include(center + Vector2<f32>{ radius, radius });
+                    operand += 3;
+                    break;
+                }
+                case Verb::Close:
+                    break;
+            }
+        }
+
+        return { minimum, maximum - minimum };
+    }
+
+    void Path::flatten(f32 tolerance, std::vector<PathContour> &contours) const {
+        contours.clear();
+
+        if (!(tolerance > 0.f)) {
+            invokeError<InvalidArgumentError>("Path flattening tolerance must be positive");
+        }
+
+        PathContour *contour = nullptr;
+        Vector2<f32> current;
+        std::size_t operand = 0;
+
+        auto addPoint = [&](const Vector2<f32> &point) {
+            if (contour->points.empty() || contour->points.back() != point) {
+                contour->points.push_back(point);
+            }
+        };
+
+        for (Verb verb : m_verbs) {
+            switch (verb) {
+                case Verb::MoveTo: {
+                    contour = &contours.emplace_back();
+                    current = m_points[operand++];
+                    addPoint(current);
+                    break;
+                }
+                case Verb::LineTo: {
+                    current = m_points[operand++];
+                    addPoint(current);
+                    break;
+                }
+                case Verb::QuadTo: {
+                    const Vector2<f32> &control = m_points[operand];
+                    const Vector2<f32> &end = m_points[operand + 1];
+                    operand += 2;
+
+                    // Wang's formula for degree 2: n = sqrt(|p0 - 2p1 + p2| / (4 * tolerance))
+                    const f32 deviation = (current - control * 2.f + end).magnitude();
+                    const u32 segments = clampSegmentCount(std::sqrt(deviation / (4.f * tolerance)));
+
+                    for (u32 i = 1; i <= segments; ++i) {
+                        const f32 t = static_cast<f32>(i) / static_cast<f32>(segments);
+                        const f32 mt = 1.f - t;
+                        addPoint(current * (mt * mt) + control * (2.f * mt * t) + end * (t * t));
+                    }
+
+                    current = end;
+                    break;
+                }
+                case Verb::CubicTo: {
+                    const Vector2<f32> &control1 = m_points[operand];
+                    const Vector2<f32> &control2 = m_points[operand + 1];
+                    const Vector2<f32> &end = m_points[operand + 2];
+                    operand += 3;
+
+                    // Wang's formula for degree 3: n = sqrt(3/4 * max|second difference| / tolerance)
+                    const f32 deviation = std::max(
+                        (current - control1 * 2.f + control2).magnitude(),
+                        (control1 - control2 * 2.f + end).magnitude()
+                    );
+                    const u32 segments = clampSegmentCount(std::sqrt(0.75f * deviation / tolerance));
+
+                    for (u32 i = 1; i <= segments; ++i) {
+                        const f32 t = static_cast<f32>(i) / static_cast<f32>(segments);
+                        const f32 mt = 1.f - t;
+                        addPoint(current * (mt * mt * mt) + control1 * (3.f * mt * mt * t) + control2 * (3.f * mt * t * t) + end * (t * t * t));
+                    }
+
+                    current = end;
+                    break;
+                }
+                case Verb::Arc: {
+                    const Vector2<f32> &center = m_points[operand];
+                    const f32 radius = m_points[operand + 1].x;
+                    const f32 startAngle = m_points[operand + 2].x;
+                    const f32 sweep = m_points[operand + 2].y;
+                    operand += 3;
+
+                    const u32 segments = arcSegmentCount(radius, tolerance, sweep);
+
+                    for (u32 i = 1; i <= segments; ++i) {
+                        const f32 angle = startAngle + sweep * static_cast<f32>(i) / static_cast<f32>(segments);
+                        current = center + Vector2<f32>{ std::cos(angle), std::sin(angle) } * radius;
+                        addPoint(current);
+                    }
+                    break;
+                }
+                case Verb::Close: {
+                    contour->closed = true;
+                    current = contour->points.front();
+                    break;
+                }
+            }
+        }
+
+        for (auto &flattened : contours) {
+            if (flattened.closed && flattened.points.size() > 1 && flattened.points.back() == flattened.points.front()) {
+                flattened.points.pop_back();
+            }
+        }
+    }
+
+    void strokePath(const std::vector<PathContour> &contours, const StrokeStyle &style, f32 tolerance, std::vector<primitives::Vertex> &vertices) {
+        const f32 halfWidth = style.width * 0.5f;
+
+        if (!(halfWidth > 0.f)) {
+            return;
+        }
+
+        // The rasterizer only fills one winding, so every triangle is emitted counter-clockwise
+        auto addTriangle = [&](primitives::Vertex a, primitives::Vertex b, primitives::Vertex c) {
+            f32 area2 = cross(b.position - a.position, c.position - a.position);
+
+            if (area2 == 0.f) {
+                return;
+            }
+
+            if (area2 < 0.f) {
+                std::swap(b, c);
+            }
+
+            vertices.push_back(a);
+            vertices.push_back(b);
+            vertices.push_back(c);
+        };
+
+        // UV y is 0 on the side the segment normal points to and 1 on the opposite side
+        auto offsetVertex = [&](const Vector2<f32> &point, const Vector2<f32> &offset, const Vector2<f32> &normal, f32 u) {
+            return primitives::Vertex{ point + offset * halfWidth, { u, 0.5f - 0.5f * offset.dot(normal) } };
+        };
+
+        auto addFan = [&](const Vector2<f32> &point, const Vector2<f32> &from, f32 sweep, const Vector2<f32> &normal, f32 u) {
+            const u32 segments = arcSegmentCount(halfWidth, tolerance, sweep);
+            const f32 startAngle = std::atan2(from.y, from.x);
+            const primitives::Vertex center { point, { u, 0.5f } };
+
+            Vector2<f32> previous = from;
+            for (u32 i = 1; i <= segments; ++i) {
+                const f32 angle = startAngle + sweep * static_cast<f32>(i) / static_cast<f32>(segments);
+                const Vector2<f32> next = { std::cos(angle), std::sin(angle) };
+
+                addTriangle(center, offsetVertex(point, previous, normal, u), offsetVertex(point, next, normal, u));
+                previous = next;
+            }
+        };
+
+        auto addJoin = [&](const Vector2<f32> &point, const Vector2<f32> &incoming, const Vector2<f32> &outgoing, f32 u) {
+            const f32 turn = cross(incoming, outgoing);
+
+            if (std::abs(turn) < 1e-6f && incoming.dot(outgoing) > 0.f) {
+                return;
+            }
+
+            // The gap to fill opens on the side facing away from the turn
+            const f32 side = turn > 0.f ? -1.f : 1.f;
+            const Vector2<f32> normal = perpendicular(incoming);
+            const Vector2<f32> outerIn = normal * side;
+            const Vector2<f32> outerOut = perpendicular(outgoing) * side;
+
+            const primitives::Vertex center { point, { u, 0.5f } };
+            const primitives::Vertex cornerIn = offsetVertex(point, outerIn, normal, u);
+            const primitives::Vertex cornerOut = offsetVertex(point, outerOut, normal, u);
+
+            if (style.join == LineJoin::Round) {
+                addFan(point, outerIn, std::atan2(cross(outerIn, outerOut), outerIn.dot(outerOut)), normal, u);
+                return;
+            }
+
+            if (style.join == LineJoin::Miter) {
+                const Vector2<f32> bisector = normalizeOrZero(outerIn + outerOut);
+                const f32 cosHalfAngle = bisector.dot(outerIn);
+
+                if (cosHalfAngle > 1e-6f && 1.f / cosHalfAngle <= style.miterLimit) {
+                    const primitives::Vertex tip = offsetVertex(point, bisector * (1.f / cosHalfAngle), normal, u);
+                    addTriangle(center, cornerIn, tip);
+                    addTriangle(center, tip, cornerOut);
+                    return;
+                }
+            }
+
+            addTriangle(center, cornerIn, cornerOut);
+        };
+
+        auto addCap = [&](const Vector2<f32> &point, const Vector2<f32> &outward, f32 u) {
+            const Vector2<f32> normal = perpendicular(outward);
+
+            if (style.cap == LineCap::Square) {
+                const primitives::Vertex a = offsetVertex(point, normal, normal, u);
+                const primitives::Vertex b = offsetVertex(point, -normal, normal, u);
+                const primitives::Vertex c = offsetVertex(point, -normal + outward, normal, u);
+                const primitives::Vertex d = offsetVertex(point, normal + outward, normal, u);
+                addTriangle(a, b, c);
+                addTriangle(a, c, d);
+            } else if (style.cap == LineCap::Round) {
+                addFan(point, normal, cross(normal, outward) > 0.f ? std::numbers::pi_v<f32> : -std::numbers::pi_v<f32>, normal, u);
+            }
+        };
+
+        std::vector<f32> distances;
+
+        for (const PathContour &contour : contours) {
+            const std::vector<Vector2<f32>> &points = contour.points;
+            const std::size_t count = points.size();
+
+            if (count == 0) {
+                continue;
+            }
+
+            if (count == 1) {
+                // A lone point is only visible through its caps
+                if (style.cap == LineCap::Round) {
+                    addFan(points[0], { 1.f, 0.f }, 2.f * std::numbers::pi_v<f32>, { 0.f, 1.f }, 0.f);
+                } else if (style.cap == LineCap::Square) {
+                    addCap(points[0], { 1.f, 0.f }, 0.f);
+                    addCap(points[0], { -1.f, 0.f }, 0.f);
+                }
+                continue;
+            }
+
+            const bool closed = contour.closed && count > 2;
+            const std::size_t segmentCount = closed ? count : count - 1;
+
+            distances.resize(count + 1);
+            distances[0] = 0.f;
+            for (std::size_t i = 0; i < segmentCount; ++i) {
+                distances[i + 1] = distances[i] + (points[(i + 1) % count] - points[i]).magnitude();
+            }
+
+            const f32 inverseLength = distances[segmentCount] > 0.f ? 1.f / distances[segmentCount] : 0.f;
+
+            auto direction = [&](std::size_t segment) {
+                return normalizeOrZero(points[(segment + 1) % count] - points[segment]);
+            };
+
+            for (std::size_t i = 0; i < segmentCount; ++i) {
+                const Vector2<f32> &start = points[i];
+                const Vector2<f32> &end = points[(i + 1) % count];
+                const Vector2<f32> normal = perpendicular(direction(i));
+
+                const f32 uStart = distances[i] * inverseLength;
+                const f32 uEnd = distances[i + 1] * inverseLength;
+
+                const primitives::Vertex a = offsetVertex(start, normal, normal, uStart);
+                const primitives::Vertex b = offsetVertex(end, normal, normal, uEnd);
+                const primitives::Vertex c = offsetVertex(end, -normal, normal, uEnd);
+                const primitives::Vertex d = offsetVertex(start, -normal, normal, uStart);
+
+                addTriangle(a, b, c);
+                addTriangle(a, c, d);
+            }
+
+            const std::size_t firstJoin = closed ? 0 : 1;
+            const std::size_t lastJoin = closed ? count : count - 1;
+
+            for (std::size_t i = firstJoin; i < lastJoin; ++i) {
+                const std::size_t incoming = (i + segmentCount - 1) % segmentCount;
+                addJoin(points[i], direction(incoming), direction(i % segmentCount), distances[i] * inverseLength);
+            }
+
+            if (!closed) {
+                addCap(points[0], -direction(0), 0.f);
+                addCap(points[count - 1], direction(segmentCount - 1), 1.f);
+            }
+        }
+    }
+}
@@ -0,0 +1,419 @@
+#include "til.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TIL_RAYCASTER_SSE
+#endif
+
+namespace til
+{
+    namespace
+    {
+        // Stands in for the infinite step of axis-parallel rays; unlike infinity it never produces NaN
+        constexpr f32 farDistance = 1e30f;
+
+        // Columns handed to one thread; a multiple of the SIMD packet width
+        constexpr u32 columnBlock = 64;
+
+        Color shade(const Color &color, u32 factor) {
+            return {
+                static_cast<u8>((color.r * factor) >> 8),
+                static_cast<u8>((color.g * factor) >> 8),
+                static_cast<u8>((color.b * factor) >> 8),
+                color.a
+            };
+        }
+
+        u32 toFactor(f32 brightness) {
+            return static_cast<u32>(std::clamp(brightness, 0.f, 1.f) * 256.f);
+        }
+
+        const Color &sampleTexel(const Texture &texture, f32 u, f32 v) {
+            const Vector2<u32> size = texture.getSize();
+            const u32 x = std::min(static_cast<u32>(std::max(u, 0.f) * static_cast<f32>(size.x)), size.x - 1);
+            const u32 y = std::min(static_cast<u32>(std::max(v, 0.f) * static_cast<f32>(size.y)), size.y - 1);
+            return texture.getRawData()[y * size.x + x];
+        }
+
+        bool isUsable(const Texture *texture) {
+            return texture && texture->getSize().x > 0 && texture->getSize().y > 0;
+        }
+    }
+
+    Raycaster::Camera Raycaster::Camera::fromAngle(const Vector2<f32> &position, f32 angle, f32 planeScale) {
+        const f32 c = std::cos(angle);
+        const f32 s = std::sin(angle);
+
+        Camera camera;
+        camera.position = position;
+        camera.direction = { c, s };
+        camera.plane = { -s * planeScale, c * planeScale };
+        return camera;
+    }
+
+    void Raycaster::setMap(const Vector2<u32> &size, const std::vector<u32> &cells) {
+        if (cells.size() != static_cast<std::size_t>(size.x) * size.y) {
+            invokeError<InvalidArgumentError>("Map cell count does not match the map size");
+        }
+
+        m_mapSize = size;
+        m_cells = cells;
+    }
+
+    const Vector2<u32> &Raycaster::getMapSize() const {
+        return m_mapSize;
+    }
+
+    u32 Raycaster::getCell(i32 x, i32 y) const {
+        if (x < 0 || y < 0 || static_cast<u32>(x) >= m_mapSize.x || static_cast<u32>(y) >= m_mapSize.y) {
+            return 0;
+        }
+        return m_cells[static_cast<std::size_t>(y) * m_mapSize.x + static_cast<u32>(x)];
+    }
+
+    void Raycaster::setCell(const Vector2<u32> &position, u32 cell) {
+        if (position.x >= m_mapSize.x || position.y >= m_mapSize.y) {
+            invokeError<InvalidArgumentError>("Cell position out of range");
+        }
+        m_cells[static_cast<std::size_t>(position.y) * m_mapSize.x + position.x] = cell;
+    }
+
+    void Raycaster::setWallTexture(u32 cell, Texture *texture) {
+        getMaterial(cell).texture = texture;
+    }
+
+    void Raycaster::setWallColor(u32 cell, const Color &color) {
+        getMaterial(cell).color = color;
+    }
+
+    bool Raycaster::castRay(const Vector2<f32> &origin, const Vector2<f32> &direction, RayHit &hit) const {
+        i32 mapX = static_cast<i32>(std::floor(origin.x));
+        i32 mapY = static_cast<i32>(std::floor(origin.y));
+
+        const f32 deltaX = std::min(std::abs(1.f / direction.x), farDistance);
+        const f32 deltaY = std::min(std::abs(1.f / direction.y), farDistance);
+
+        const i32 stepX = direction.x < 0.f ? -1 : 1;
+        const i32 stepY = direction.y < 0.f ? -1 : 1;
+
+        const f32 fractionX = origin.x - static_cast<f32>(mapX);
+        const f32 fractionY = origin.y - static_cast<f32>(mapY);
+        f32 sideX = (direction.x < 0.f ? fractionX : 1.f - fractionX) * deltaX;
+        f32 sideY = (direction.y < 0.f ? fractionY : 1.f - fractionY) * deltaY;
+
+        const u32 maxSteps = m_mapSize.x + m_mapSize.y + 2;
+        bool side = false;
+
+        for (u32 i = 0; i < maxSteps; ++i) {
+            if (sideX < sideY) {
+                sideX += deltaX;
+                mapX += stepX;
+                side = false;
+            } else {
+                sideY += deltaY;
+                mapY += stepY;
+                side = true;
+            }
+
+            if (mapX < 0 || mapY < 0 || static_cast<u32>(mapX) >= m_mapSize.x || static_cast<u32>(mapY) >= m_mapSize.y) {
+                return false;
+            }
+
+            const u32 cell = m_cells[static_cast<std::size_t>(mapY) * m_mapSize.x + static_cast<u32>(mapX)];
+            if (cell != 0) {
+                hit.distance = side ? sideY - deltaY : sideX - deltaX;
+                hit.cell = cell;
+                hit.mapPosition = { mapX, mapY };
+                hit.side = side;
+
+                const f32 along = side ? origin.x + hit.distance * direction.x : origin.y + hit.distance * direction.y;
+                hit.wallX = along - std::floor(along);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Raycaster::render(RenderTarget &target, const Camera &camera) {
+        PixelLock lock = target.lockPixels();
+        const Vector2<u32> size = lock.getSize();
+
+        m_depth.resize(size.x);
+        m_columnCells.resize(size.x);
+        m_columnWallX.resize(size.x);
+        m_columnBrightness.resize(size.x);
+
+        if (size.x == 0 || size.y == 0) return;
+
+        const i64 blockCount = static_cast<i64>((size.x + columnBlock - 1) / columnBlock);
+
+        #pragma omp parallel for if (blockCount > 1)
+        for (i64 block = 0; block < blockCount; ++block) {
+            const u32 first = static_cast<u32>(block) * columnBlock;
+            castColumns(camera, first, std::min(columnBlock, size.x - first), size.x);
+        }
+
+        const f32 width = static_cast<f32>(size.x);
+        const f32 half = static_cast<f32>(size.y) * 0.5f;
+        const Vector2<f32> planeStep = camera.plane * (2.f / width);
+        const Vector2<f32> leftRay = camera.direction - camera.plane + camera.plane * (1.f / width);
+
+        const std::span<Color> pixels = lock.getPixels();
+        const u32 stride = lock.getStride();
+
+        #pragma omp parallel for
+        for (i64 y = 0; y < static_cast<i64>(size.y); ++y) {
+            Color *row = pixels.data() + static_cast<std::size_t>(y) * stride;
+
+            const f32 centerY = static_cast<f32>(y) + 0.5f;
+            const f32 offset = std::abs(centerY - half);
+            // The middle row of an odd height sits on the horizon; half a row keeps its distance finite
+            const f32 rowDistance = half / std::max(offset, 0.5f);
+
+            const bool isFloor = centerY > half;
+            const Texture *surface = isFloor ? floorTexture : ceilingTexture;
+            const u32 surfaceFactor = toFactor(getBrightness(rowDistance));
+            const bool textured = isUsable(surface);
+            const Color flat = shade(isFloor ? floorColor : ceilingColor, surfaceFactor);
+
+            // The floor point seen by a row moves linearly across the columns
+            Vector2<f32> world = camera.position + leftRay * rowDistance;
+            const Vector2<f32> worldStep = planeStep * rowDistance;
+
+            for (u32 x = 0; x < size.x; ++x, world += worldStep) {
+                const u32 cell = m_columnCells[x];
+                const f32 distance = m_depth[x];
+
+                if (cell != 0 && offset * distance < half) {
+                    const WallMaterial *material = cell < m_materials.size() ? &m_materials[cell] : nullptr;
+                    const u32 factor = toFactor(m_columnBrightness[x]);
+
+                    if (material && isUsable(material->texture)) {
+                        const f32 lineHeight = static_cast<f32>(size.y) / distance;
+                        const f32 v = (centerY - (half - lineHeight * 0.5f)) / lineHeight;
+                        row[x] = shade(sampleTexel(*material->texture, m_columnWallX[x], v), factor);
+                    } else {
+                        row[x] = shade(material ? material->color : WallMaterial{}.color, factor);
+                    }
+                } else if (textured) {
+                    row[x] = shade(sampleTexel(*surface, world.x - std::floor(world.x), world.y - std::floor(world.y)), surfaceFactor);
+                } else {
+                    row[x] = flat;
+                }
+            }
+        }
+    }
+
+    void Raycaster::renderSprite(RenderTarget &target, const Camera &camera, const Vector2<f32> &position, const Texture &texture, f32 scale) {
+        PixelLock lock = target.lockPixels();
+        const Vector2<u32> size = lock.getSize();
+
+        if (m_depth.size() != size.x) {
+            invokeError<LogicError>("Raycaster sprites must follow a render() of the same target size");
+            return;
+        }
+
+        if (size.x == 0 || size.y == 0 || !isUsable(&texture) || !(scale > 0.f)) return;
+
+        const f32 determinant = camera.plane.x * camera.direction.y - camera.direction.x * camera.plane.y;
+        if (determinant == 0.f) return;
+
+        // Sprite position in camera space: lateral offset and depth along the view direction
+        const Vector2<f32> relative = position - camera.position;
+        const f32 inverse = 1.f / determinant;
+        const f32 lateral = inverse * (camera.direction.y * relative.x - camera.direction.x * relative.y);
+        const f32 depth = inverse * (camera.plane.x * relative.y - camera.plane.y * relative.x);
+
+        if (depth <= 1e-4f) return;
+
+        const f32 half = static_cast<f32>(size.y) * 0.5f;
+        const f32 height = static_cast<f32>(size.y) / depth * scale;
+        const f32 width = height * static_cast<f32>(texture.getSize().x) / static_cast<f32>(texture.getSize().y);
+        const f32 centerX = static_cast<f32>(size.x) * 0.5f * (1.f + lateral / depth);
+        const f32 bottom = half + half / depth;
+        const f32 left = centerX - width * 0.5f;
+        const f32 top = bottom - height;
+
+        const i64 firstX = std::max<i64>(0, static_cast<i64>(std::ceil(left - 0.5f)));
+        const i64 endX = std::min<i64>(size.x, static_cast<i64>(std::ceil(left + width - 0.5f)));
+        const i64 firstY = std::max<i64>(0, static_cast<i64>(std::ceil(top - 0.5f)));
+        const i64 endY = std::min<i64>(size.y, static_cast<i64>(std::ceil(bottom - 0.5f)));
+
+        if (firstX >= endX || firstY >= endY) return;
+
+        const std::span<Color> pixels = lock.getPixels();
+        const u32 stride = lock.getStride();
+        const u32 factor = toFactor(getBrightness(depth));
+
+        for (i64 x = firstX; x < endX; ++x) {
+            if (depth >= m_depth[x]) continue;
+
+            const f32 u = (static_cast<f32>(x) + 0.5f - left) / width;
+            for (i64 y = firstY; y < endY; ++y) {
+                const Color &texel = sampleTexel(texture, u, (static_cast<f32>(y) + 0.5f - top) / height);
+                if (texel.a == 0) continue;
+
+                pixels[static_cast<std::size_t>(y) * stride + static_cast<std::size_t>(x)] = shade(texel, factor);
+            }
+        }
+    }
+
+    const std::vector<f32> &Raycaster::getDepthBuffer() const {
+        return m_depth;
+    }
+
+    void Raycaster::castColumns(const Camera &camera, u32 first, u32 count, u32 width) {
+        const u32 end = first + count;
+        const f32 inverseWidth = 2.f / static_cast<f32>(width);
+        u32 column = first;
+
+        auto rayDirection = [&](u32 x) {
+            const f32 cameraX = (static_cast<f32>(x) + 0.5f) * inverseWidth - 1.f;
+            return camera.direction + camera.plane * cameraX;
+        };
+
+    #if defined(TIL_RAYCASTER_SSE)
+        // Four rays walk the grid in lockstep; each lane stops stepping once it hits or leaves the map
+        const i32 startX = static_cast<i32>(std::floor(camera.position.x));
+        const i32 startY = static_cast<i32>(std::floor(camera.position.y));
+        const f32 fractionX = camera.position.x - static_cast<f32>(startX);
+        const f32 fractionY = camera.position.y - static_cast<f32>(startY);
+        const u32 maxSteps = m_mapSize.x + m_mapSize.y + 2;
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.f);
+        const __m128 far = _mm_set1_ps(farDistance);
+        const __m128 signMask = _mm_set1_ps(-0.f);
+        const __m128i plusOne = _mm_set1_epi32(1);
+        const __m128i minusOne = _mm_set1_epi32(-1);
+
+        for (; column + 4 <= end; column += 4) {
+            alignas(16) f32 directionX[4];
+            alignas(16) f32 directionY[4];
+            for (u32 lane = 0; lane < 4; ++lane) {
+                const Vector2<f32> direction = rayDirection(column + lane);
+                directionX[lane] = direction.x;
+                directionY[lane] = direction.y;
+            }
+
+            const __m128 rayX = _mm_load_ps(directionX);
+            const __m128 rayY = _mm_load_ps(directionY);
+            const __m128 deltaX = _mm_min_ps(_mm_andnot_ps(signMask, _mm_div_ps(one, rayX)), far);
+            const __m128 deltaY = _mm_min_ps(_mm_andnot_ps(signMask, _mm_div_ps(one, rayY)), far);
+
+            const __m128 negativeX = _mm_cmplt_ps(rayX, zero);
+            const __m128 negativeY = _mm_cmplt_ps(rayY, zero);
+            const __m128i stepX = _mm_or_si128(_mm_and_si128(_mm_castps_si128(negativeX), minusOne), _mm_andnot_si128(_mm_castps_si128(negativeX), plusOne));
+            const __m128i stepY = _mm_or_si128(_mm_and_si128(_mm_castps_si128(negativeY), minusOne), _mm_andnot_si128(_mm_castps_si128(negativeY), plusOne));
+
+            const __m128 towardX = _mm_or_ps(_mm_and_ps(negativeX, _mm_set1_ps(fractionX)), _mm_andnot_ps(negativeX, _mm_set1_ps(1.f - fractionX)));
+            const __m128 towardY = _mm_or_ps(_mm_and_ps(negativeY, _mm_set1_ps(fractionY)), _mm_andnot_ps(negativeY, _mm_set1_ps(1.f - fractionY)));
+            __m128 sideX = _mm_mul_ps(towardX, deltaX);
+            __m128 sideY = _mm_mul_ps(towardY, deltaY);
+
+            __m128i mapX = _mm_set1_epi32(startX);
+            __m128i mapY = _mm_set1_epi32(startY);
+            __m128 sides = zero;
+            __m128 active = _mm_cmpeq_ps(zero, zero);
+
+            alignas(16) i32 laneActive[4] = { -1, -1, -1, -1 };
+            alignas(16) i32 laneX[4];
+            alignas(16) i32 laneY[4];
+            u32 laneCells[4] = { 0, 0, 0, 0 };
+
+            for (u32 i = 0; i < maxSteps && _mm_movemask_ps(active) != 0; ++i) {
+                const __m128 xFirst = _mm_cmplt_ps(sideX, sideY);
+                const __m128 takeX = _mm_and_ps(xFirst, active);
+                const __m128 takeY = _mm_andnot_ps(xFirst, active);
+
+                sideX = _mm_add_ps(sideX, _mm_and_ps(takeX, deltaX));
+                sideY = _mm_add_ps(sideY, _mm_and_ps(takeY, deltaY));
+                mapX = _mm_add_epi32(mapX, _mm_and_si128(_mm_castps_si128(takeX), stepX));
+                mapY = _mm_add_epi32(mapY, _mm_and_si128(_mm_castps_si128(takeY), stepY));
+                sides = _mm_or_ps(_mm_andnot_ps(active, sides), takeY);
+
+                // SSE2 has no gather, so the cell lookups stay per lane
+                _mm_store_si128(reinterpret_cast<__m128i *>(laneX), mapX);
+                _mm_store_si128(reinterpret_cast<__m128i *>(laneY), mapY);
+
+                for (u32 lane = 0; lane < 4; ++lane) {
+                    if (!laneActive[lane]) continue;
+
+                    if (laneX[lane] < 0 || laneY[lane] < 0 || static_cast<u32>(laneX[lane]) >= m_mapSize.x || static_cast<u32>(laneY[lane]) >= m_mapSize.y) {
+                        laneActive[lane] = 0;
+                        continue;
+                    }
+
+                    const u32 cell = m_cells[static_cast<std::size_t>(laneY[lane]) * m_mapSize.x + static_cast<u32>(laneX[lane])];
+                    if (cell != 0) {
+                        laneCells[lane] = cell;
+                        laneActive[lane] = 0;
+                    }
+                }
+
+                active = _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i *>(laneActive)));
+            }
+
+            alignas(16) f32 distances[4];
+            const __m128 distanceX = _mm_sub_ps(sideX, deltaX);
+            const __m128 distanceY = _mm_sub_ps(sideY, deltaY);
+            _mm_store_ps(distances, _mm_or_ps(_mm_and_ps(sides, distanceY), _mm_andnot_ps(sides, distanceX)));
+            const i32 sideBits = _mm_movemask_ps(sides);
+
+            for (u32 lane = 0; lane < 4; ++lane) {
+                storeColumn(column + lane, camera.position, { directionX[lane], directionY[lane] }, laneCells[lane] != 0, laneCells[lane], (sideBits >> lane) & 1, distances[lane]);
+            }
+        }
+    #endif
+
+        for (; column < end; ++column) {
+            const Vector2<f32> direction = rayDirection(column);
+
+            RayHit hit;
+            const bool found = castRay(camera.position, direction, hit);
+            storeColumn(column, camera.position, direction, found, hit.cell, hit.side, hit.distance);
+        }
+    }
+
+    void Raycaster::storeColumn(u32 column, const Vector2<f32> &origin, const Vector2<f32> &direction, bool hit, u32 cell, bool side, f32 distance) {
+        if (!hit) {
+            m_columnCells[column] = 0;
+            m_depth[column] = std::numeric_limits<f32>::infinity();
+            return;
+        }
+
+        distance = std::max(distance, 1e-4f);
+
+        const f32 along = side ? origin.x + distance * direction.x : origin.y + distance * direction.y;
+        f32 wallX = along - std::floor(along);
+
+        // Mirror faces seen from the far side so textures are never drawn backwards
+        if ((!side && direction.x > 0.f) || (side && direction.y < 0.f)) {
+            wallX = 1.f - wallX;
+        }
+
+        m_columnCells[column] = cell;
+        m_depth[column] = distance;
+        m_columnWallX[column] = wallX;
+        m_columnBrightness[column] = getBrightness(distance) * (side ? sideBrightness : 1.f);
+    }
+
+    Raycaster::WallMaterial &Raycaster::getMaterial(u32 cell) {
+        if (cell == 0) {
+            invokeError<InvalidArgumentError>("Cell id 0 is empty space and has no material");
+        }
+
+        if (cell >= m_materials.size()) {
+            m_materials.resize(static_cast<std::size_t>(cell) + 1);
+        }
+        return m_materials[cell];
+    }
+
+    f32 Raycaster::getBrightness(f32 distance) const {
+        return std::clamp(1.f / (1.f + distance * distanceFalloff), minimumBrightness, 1.f);
+    }
+}
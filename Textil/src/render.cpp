@@ -1,104 +1,835 @@
 #include "til.hpp"
+#include <bit>
 
 namespace til
 {
+    namespace
+    {
+        // 28.4 fixed point: four fractional bits, i.e. 1/16 pixel precision
+        constexpr i64 subpixelBits = 4;
+        constexpr i64 subpixelScale = i64(1) << subpixelBits;
+
+        struct FixedPointEdge
+        {
+            i64 a, b, c;
+            i64 bias;  // 0 for top/left edges, -1 otherwise, so ties are resolved by a sign test
+        };
+
+        i64 snapToSubpixel(f32 value) {
+            return static_cast<i64>(std::llround(static_cast<f64>(value) * subpixelScale));
+        }
+
+        i64 floorDivide(i64 value, i64 divisor) {
+            i64 quotient = value / divisor;
+            return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+        }
+
+        i64 ceilDivide(i64 value, i64 divisor) {
+            i64 quotient = value / divisor;
+            return (value % divisor != 0 && value > 0) ? quotient + 1 : quotient;
+        }
+
+        FixedPointEdge makeFixedPointEdge(i64 x1, i64 y1, i64 x2, i64 y2) {
+            bool topLeft = (y1 == y2) ? (x1 < x2) : (y1 > y2);
+            return { y1 - y2, x2 - x1, x1 * y2 - x2 * y1, topLeft ? 0 : -1 };
+        }
+
+        // Quotient rounded to nearest, halves rounded up; divisor must be positive
+        i64 roundDivide(i64 value, i64 divisor) {
+            return floorDivide(2 * value + divisor, 2 * divisor);
+        }
+
+        // Exclusive prefix sum of the run lengths stored as each run's first fragment index, so the
+        // fragments of all runs can be written concurrently; returns the total number of fragments
+        template<typename Run>
+        u32 assignFragmentOffsets(std::vector<Run> &runs) {
+            constexpr i64 blockSize = 4096;
+
+            const i64 runCount = static_cast<i64>(runs.size());
+            const i64 blockCount = (runCount + blockSize - 1) / blockSize;
+
+            std::vector<u32> blockOffsets(blockCount + 1, 0u);
+
+            #pragma omp parallel for if (blockCount > 1)
+            for (i64 block = 0; block < blockCount; ++block) {
+                const i64 blockEnd = std::min(runCount, (block + 1) * blockSize);
+
+                u32 sum = 0;
+                for (i64 i = block * blockSize; i < blockEnd; ++i) {
+                    sum += runs[i].length;
+                }
+
+                blockOffsets[block + 1] = sum;
+            }
+
+            for (i64 block = 0; block < blockCount; ++block) {
+                blockOffsets[block + 1] += blockOffsets[block];
+            }
+
+            #pragma omp parallel for if (blockCount > 1)
+            for (i64 block = 0; block < blockCount; ++block) {
+                const i64 blockEnd = std::min(runCount, (block + 1) * blockSize);
+
+                u32 offset = blockOffsets[block];
+                for (i64 i = block * blockSize; i < blockEnd; ++i) {
+                    runs[i].firstFragment = offset;
+                    offset += runs[i].length;
+                }
+            }
+
+            return blockOffsets[blockCount];
+        }
+
+        struct ClippedRect
+        {
+            u32 x, y;           // first covered pixel of the target
+            u32 width, height;  // covered size
+            u32 skipX, skipY;   // pixels cut off the left and top of the source
+        };
+
+        bool clipRect(const Vector2<u32> &bounds, const Vector2<i32> &position, const Vector2<u32> &size, ClippedRect &clipped) {
+            const i64 left = std::max<i64>(position.x, 0);
+            const i64 top = std::max<i64>(position.y, 0);
+            const i64 right = std::min<i64>(static_cast<i64>(position.x) + size.x, bounds.x);
+            const i64 bottom = std::min<i64>(static_cast<i64>(position.y) + size.y, bounds.y);
+
+            if (left >= right || top >= bottom) {
+                return false;
+            }
+
+            clipped = {
+                static_cast<u32>(left), static_cast<u32>(top),
+                static_cast<u32>(right - left), static_cast<u32>(bottom - top),
+                static_cast<u32>(left - position.x), static_cast<u32>(top - position.y)
+            };
+            return true;
+        }
+    }
+
+    PixelLock::PixelLock(RenderTarget &target, const Rect<u32> &region)
+        : m_target(&target), m_stride(target.m_bufferSize.x), m_region(region), m_modifiedRegion(region) {
+        m_pixels = target.m_pixelBuffer.getBuffer().data() + region.position.y * m_stride + region.position.x;
+        target.m_pixelsLocked = true;
+    }
+
+    PixelLock::PixelLock(PixelLock &&other) noexcept
+        : m_target(other.m_target), m_pixels(other.m_pixels), m_stride(other.m_stride), m_region(other.m_region), m_modifiedRegion(other.m_modifiedRegion) {
+        other.m_target = nullptr;
+        other.m_pixels = nullptr;
+    }
+
+    PixelLock &PixelLock::operator=(PixelLock &&other) noexcept {
+        if (this != &other) {
+            unlock();
+
+            m_target = other.m_target;
+            m_pixels = other.m_pixels;
+            m_stride = other.m_stride;
+            m_region = other.m_region;
+            m_modifiedRegion = other.m_modifiedRegion;
+
+            other.m_target = nullptr;
+            other.m_pixels = nullptr;
+        }
+        return *this;
+    }
+
+    PixelLock::~PixelLock() {
+        unlock();
+    }
+
+    std::span<Color> PixelLock::getPixels() const {
+        if (!m_pixels || m_region.isEmpty()) {
+            return {};
+        }
+        return { m_pixels, static_cast<std::size_t>(m_region.size.y - 1) * m_stride + m_region.size.x };
+    }
+
+    std::span<Color> PixelLock::getRow(u32 y) const {
+        if (!m_pixels || y >= m_region.size.y) {
+            return {};
+        }
+        return { m_pixels + static_cast<std::size_t>(y) * m_stride, m_region.size.x };
+    }
+
+    u32 PixelLock::getStride() const {
+        return m_stride;
+    }
+
+    Vector2<u32> PixelLock::getSize() const {
+        return m_region.size;
+    }
+
+    const Rect<u32> &PixelLock::getRegion() const {
+        return m_region;
+    }
+
+    void PixelLock::setModifiedRegion(const Rect<u32> &region) {
+        m_modifiedRegion = m_region.getIntersection(region);
+    }
+
+    void PixelLock::unlock() {
+        if (!m_target) {
+            return;
+        }
+
+        m_target->m_pixelsLocked = false;
+        if (!m_modifiedRegion.isEmpty()) {
+            m_target->markDirty(m_modifiedRegion);
+        }
+
+        m_target = nullptr;
+        m_pixels = nullptr;
+    }
+
+    FragmentRecording::FragmentRecording(std::size_t memoryLimit) : m_memoryLimit(memoryLimit) {}
+
+    void FragmentRecording::clear() {
+        std::vector<Run>().swap(m_runs);
+        std::vector<Color>().swap(m_colors);
+        m_bounds = {};
+        m_state = State::Empty;
+    }
+
+    bool FragmentRecording::isComplete() const {
+        return m_state == State::Complete;
+    }
+
+    bool FragmentRecording::hasOverflowed() const {
+        return m_state == State::Overflowed;
+    }
+
+    bool FragmentRecording::isValidFor(const RenderTarget &target) const {
+        return m_state == State::Complete && m_bufferSize == target.m_bufferSize;
+    }
+
+    const Vector2<u32> &FragmentRecording::getBufferSize() const {
+        return m_bufferSize;
+    }
+
+    const Rect<u32> &FragmentRecording::getBounds() const {
+        return m_bounds;
+    }
+
+    std::span<const FragmentRecording::Run> FragmentRecording::getRuns() const {
+        return m_runs;
+    }
+
+    std::span<const Color> FragmentRecording::getColors() const {
+        return m_colors;
+    }
+
+    std::size_t FragmentRecording::getMemoryUsage() const {
+        return m_runs.capacity() * sizeof(Run) + m_colors.capacity() * sizeof(Color);
+    }
+
+    std::size_t FragmentRecording::getMemoryLimit() const {
+        return m_memoryLimit;
+    }
+
+    void FragmentRecording::setMemoryLimit(std::size_t memoryLimit) {
+        m_memoryLimit = memoryLimit;
+    }
+
+    void FragmentRecording::begin(const Vector2<u32> &bufferSize) {
+        // Keep the allocations: recapturing similar content reuses them
+        m_runs.clear();
+        m_colors.clear();
+        m_bounds = {};
+        m_bufferSize = bufferSize;
+        m_state = State::Recording;
+    }
+
+    void FragmentRecording::end() {
+        if (m_state == State::Recording) {
+            m_state = State::Complete;
+        }
+    }
+
+    Color *FragmentRecording::appendRun(u32 index, u32 count, BlendMode blendMode) {
+        if (m_state != State::Recording || count == 0) {
+            return nullptr;
+        }
+
+        const bool merge = !m_runs.empty() && m_runs.back().blendMode == blendMode && m_runs.back().index + m_runs.back().count == index;
+        const std::size_t bytes = (m_runs.size() + (merge ? 0 : 1)) * sizeof(Run) + (m_colors.size() + count) * sizeof(Color);
+
+        if (bytes > m_memoryLimit) {
+            clear();
+            m_state = State::Overflowed;
+            return nullptr;
+        }
+
+        if (merge) {
+            m_runs.back().count += count;
+        } else {
+            m_runs.push_back({ index, count, blendMode });
+        }
+
+        m_bounds = m_bounds.getUnion({ { index % m_bufferSize.x, index / m_bufferSize.x }, { count, 1u } });
+
+        const std::size_t offset = m_colors.size();
+        m_colors.resize(offset + count);
+        return m_colors.data() + offset;
+    }
+
+    void FragmentRecording::record(u32 index, const filters::VertexData *fragments, u32 count, BlendMode blendMode) {
+        Color *colors = appendRun(index, count, blendMode);
+        if (!colors) {
+            return;
+        }
+
+        for (u32 i = 0; i < count; ++i) {
+            colors[i] = fragments[i].color;
+        }
+    }
+
+    void FragmentRecording::record(u32 index, const Color *colors, u32 count, BlendMode blendMode) {
+        Color *destination = appendRun(index, count, blendMode);
+        if (destination) {
+            std::copy_n(colors, count, destination);
+        }
+    }
+
     void RenderTarget::render() {
         if (!m_renderer) {
             invokeError<LogicError>("No renderer set");
         }
 
-        sortDrawCalls();
+        if (m_pixelsLocked) {
+            invokeError<LogicError>("Cannot render while the pixels are locked");
+        }
+
+        m_drawCommands.sort();
+
+        m_drawCommands.forEach([this](const DrawCommandHeader &header, const AffineMatrix<f32> &matrix, const std::byte *payload) {
+            m_activeDrawId = header.drawId;
 
-        for (const auto &drawCall : m_drawCalls) {
-            DrawCallData &data = m_drawCallDataPool[drawCall.data_index];
-            switch (data.type) {
+            switch (header.type) {
                 case DrawCallType::Vertex:
-                    m_renderer->drawImmediate(*this, std::get<primitives::Vertex>(data.payload), data.transform, *data.fragmentPipeline);
+                    m_renderer->drawImmediate(*this, DrawCommandBuffer::readPayload<primitives::Vertex>(payload), matrix, *header.fragmentPipeline, header.blendMode);
                     break;
                 case DrawCallType::Line:
-                    m_renderer->drawImmediate(*this, std::get<primitives::Line>(data.payload), data.transform, *data.fragmentPipeline);
+                    m_renderer->drawImmediate(*this, DrawCommandBuffer::readPayload<primitives::Line>(payload), matrix, *header.fragmentPipeline, header.blendMode);
                     break;
                 case DrawCallType::Ellipse:
-                    m_renderer->drawImmediate(*this, std::get<primitives::Ellipse>(data.payload), data.transform, *data.fragmentPipeline);
+                    m_renderer->drawImmediate(*this, DrawCommandBuffer::readPayload<primitives::Ellipse>(payload), matrix, *header.fragmentPipeline, header.blendMode);
                     break;
                 case DrawCallType::TriangleMesh:
-                    m_renderer->drawImmediate(*this, std::get<primitives::TriangleMesh>(data.payload), data.transform, *data.fragmentPipeline);
+                    m_renderer->drawImmediate(*this, DrawCommandBuffer::readPayload<primitives::TriangleMesh>(payload), matrix, *header.fragmentPipeline, header.blendMode);
+                    break;
+                case DrawCallType::LineList:
+                    m_renderer->drawImmediate(*this, DrawCommandBuffer::readPayload<primitives::LineList>(payload), matrix, *header.fragmentPipeline, header.blendMode);
+                    break;
+                case DrawCallType::LineStrip:
+                    m_renderer->drawImmediate(*this, DrawCommandBuffer::readPayload<primitives::LineStrip>(payload), matrix, *header.fragmentPipeline, header.blendMode);
+                    break;
+                case DrawCallType::FragmentPass:
+                    m_renderer->drawImmediate(*this, DrawCommandBuffer::readPayload<primitives::FragmentPass>(payload), *header.fragmentPipeline, header.blendMode);
+                    break;
+                case DrawCallType::BeginRecording:
+                    if (m_recording) {
+                        invokeError<LogicError>("Fragment recordings cannot be nested");
+                    }
+                    m_recording = DrawCommandBuffer::readPayload<primitives::Recording>(payload).recording;
+                    m_recording->begin(m_bufferSize);
+                    break;
+                case DrawCallType::EndRecording:
+                    if (m_recording == DrawCommandBuffer::readPayload<primitives::Recording>(payload).recording) {
+                        m_recording->end();
+                        m_recording = nullptr;
+                    }
+                    break;
+                case DrawCallType::Replay:
+                    m_renderer->drawImmediate(*this, *DrawCommandBuffer::readPayload<primitives::Recording>(payload).recording);
                     break;
                 default:
                     invokeError<LogicError>("Unknown draw call type");
             }
+        });
+
+        m_activeDrawId = m_drawId;
+
+        // A capture without its end marker is incomplete
+        if (m_recording) {
+            m_recording->clear();
+            m_recording = nullptr;
         }
         
         clearDrawCalls();
     }
 
     void RenderTarget::fill(const Color &color) {
+        if (m_pixelsLocked) {
+            invokeError<LogicError>("Cannot fill while the pixels are locked");
+        }
+
+        markDirty();
+
         i32 size = m_bufferSize.x * m_bufferSize.y;
 
         #pragma omp parallel for
-        for (i32 i = 0; i < size; ++i) {
-            m_pixelBuffer[i] = color;
+        for (i32 i = 0; i < size; ++i) {
+            m_pixelBuffer[i] = color;
+        }
+
+        std::fill(m_idBuffer.begin(), m_idBuffer.end(), 0u);
+    }
+
+    void RenderTarget::clearDrawCalls() {
+        m_drawCommands.clear();
+    }
+
+    const Vector2<u32> &RenderTarget::getBufferSize() const {
+        return m_bufferSize;
+    }
+
+    void RenderTarget::setBufferSize(const Vector2<u32> &size) {
+        if (m_pixelsLocked) {
+            invokeError<LogicError>("Cannot resize while the pixels are locked");
+        }
+
+        m_bufferSize = size;
+        m_baseData.bufferSize = size;
+        m_pixelBuffer.getBuffer().resize(size.x * size.y);
+        if (m_idBufferEnabled) {
+            m_idBuffer.assign(static_cast<std::size_t>(size.x) * size.y, 0u);
+        }
+        m_dirtyRegion = {};
+        markDirty();
+    }
+
+    PixelLock RenderTarget::lockPixels() {
+        return lockPixels({ { 0u, 0u }, m_bufferSize });
+    }
+
+    PixelLock RenderTarget::lockPixels(const Rect<u32> &region) {
+        if (m_pixelsLocked) {
+            invokeError<LogicError>("Pixels are already locked");
+        }
+
+        return PixelLock(*this, region.getIntersection({ { 0u, 0u }, m_bufferSize }));
+    }
+
+    const Rect<u32> &RenderTarget::getDirtyRegion() const {
+        return m_dirtyRegion;
+    }
+
+    void RenderTarget::clearDirtyRegion() {
+        m_dirtyRegion = {};
+    }
+
+    u64 RenderTarget::getContentVersion() const {
+        return m_contentVersion;
+    }
+
+    void RenderTarget::setIdBufferEnabled(bool enabled) {
+        m_idBufferEnabled = enabled;
+
+        if (enabled) {
+            m_idBuffer.assign(static_cast<std::size_t>(m_bufferSize.x) * m_bufferSize.y, 0u);
+        } else {
+            std::vector<u32>().swap(m_idBuffer);
+        }
+    }
+
+    bool RenderTarget::isIdBufferEnabled() const {
+        return m_idBufferEnabled;
+    }
+
+    void RenderTarget::setDrawId(u32 id) {
+        m_drawId = id;
+        m_activeDrawId = id;
+    }
+
+    u32 RenderTarget::getDrawId() const {
+        return m_drawId;
+    }
+
+    u32 RenderTarget::pick(const Vector2<u32> &position) const {
+        if (!m_idBufferEnabled || position.x >= m_bufferSize.x || position.y >= m_bufferSize.y) {
+            return 0;
+        }
+        return m_idBuffer[static_cast<std::size_t>(position.y) * m_bufferSize.x + position.x];
+    }
+
+    std::span<const u32> RenderTarget::getIdBuffer() const {
+        return m_idBuffer;
+    }
+
+    template<typename ColorAt>
+    void RenderTarget::writeIds(u32 index, u32 stride, u32 count, BlendMode blendMode, ColorAt colorAt) {
+        u32 *ids = m_idBuffer.data() + index;
+
+        if (blendMode == BlendMode::None) {
+            for (u32 i = 0; i < count; ++i, ids += stride) {
+                *ids = m_activeDrawId;
+            }
+            return;
+        }
+
+        for (u32 i = 0; i < count; ++i, ids += stride) {
+            if (colorAt(i).a > 0) {
+                *ids = m_activeDrawId;
+            }
+        }
+    }
+
+    void RenderTarget::markDirty(const Rect<u32> &region) {
+        m_dirtyRegion = m_dirtyRegion.getUnion(region);
+        ++m_contentVersion;
+    }
+
+    void RenderTarget::markDirty() {
+        markDirty({ { 0u, 0u }, m_bufferSize });
+    }
+
+    void RenderTarget::setPixel(u32 index, const Color &color) {
+        m_pixelBuffer[index] = color;
+
+        if (m_idBufferEnabled) {
+            m_idBuffer[index] = m_activeDrawId;
+        }
+    }
+
+    void RenderTarget::setPixel(const Vector2<u32> &position, const Color &color) {
+        u32 index = position.y * m_bufferSize.x + position.x;
+        setPixel(index, color);
+    }
+
+    void RenderTarget::setPixelWithBlend(u32 index, const Color &color, BlendMode blendMode) {
+        Color destinationColor = m_pixelBuffer[index];
+
+        m_pixelBuffer[index] = Color::applyBlend(destinationColor, color, blendMode);
+
+        if (m_idBufferEnabled) {
+            writeIds(index, 1u, 1u, blendMode, [&](u32) { return color; });
+        }
+    }
+
+    void RenderTarget::setPixelWithBlend(const Vector2<u32> &position, const Color &color, BlendMode blendMode) {
+        u32 index = position.y * m_bufferSize.x + position.x;
+        setPixelWithBlend(index, color, blendMode);
+
+        if (m_recording) {
+            m_recording->record(index, &color, 1u, blendMode);
+        }
+    }
+
+    void RenderTarget::blendSpan(u32 index, const filters::VertexData *fragments, u32 count, BlendMode blendMode) {
+        const Color::BlendFunction blend = Color::getBlendFunction(blendMode);
+        Color *pixels = m_pixelBuffer.getBuffer().data() + index;
+
+        for (u32 i = 0; i < count; ++i) {
+            pixels[i] = blend(pixels[i], fragments[i].color);
+        }
+
+        if (m_idBufferEnabled) {
+            writeIds(index, 1u, count, blendMode, [fragments](u32 i) { return fragments[i].color; });
+        }
+
+        markDirty({ { index % m_bufferSize.x, index / m_bufferSize.x }, { count, 1u } });
+
+        if (m_recording) {
+            m_recording->record(index, fragments, count, blendMode);
+        }
+    }
+
+    void RenderTarget::blendFragments(const filters::VertexData *positions, const filters::VertexData *fragments, u32 count, BlendMode blendMode) {
+        const Color::BlendFunction blend = Color::getBlendFunction(blendMode);
+        Color *pixels = m_pixelBuffer.getBuffer().data();
+
+        Vector2<u32> minimum = m_bufferSize;
+        Vector2<u32> maximum { 0u, 0u };
+
+        for (u32 i = 0; i < count; ++i) {
+            const u32 x = static_cast<u32>(positions[i].position.x);
+            const u32 y = static_cast<u32>(positions[i].position.y);
+            u32 index = y * m_bufferSize.x + x;
+            pixels[index] = blend(pixels[index], fragments[i].color);
+
+            if (m_idBufferEnabled) {
+                writeIds(index, 1u, 1u, blendMode, [&](u32) { return fragments[i].color; });
+            }
+
+            minimum = { std::min(minimum.x, x), std::min(minimum.y, y) };
+            maximum = { std::max(maximum.x, x + 1), std::max(maximum.y, y + 1) };
+
+            if (m_recording) {
+                m_recording->record(index, fragments + i, 1u, blendMode);
+            }
+        }
+
+        if (count > 0) {
+            markDirty({ minimum, maximum - minimum });
+        }
+    }
+
+    void RenderTarget::blendRect(const Rect<u32> &region, const filters::VertexData *fragments, BlendMode blendMode) {
+        const Color::BlendFunction blend = Color::getBlendFunction(blendMode);
+        Color *pixels = m_pixelBuffer.getBuffer().data();
+
+        #pragma omp parallel for
+        for (i32 row = 0; row < static_cast<i32>(region.size.y); ++row) {
+            Color *target = pixels + (region.position.y + row) * m_bufferSize.x + region.position.x;
+            const filters::VertexData *source = fragments + static_cast<std::size_t>(row) * region.size.x;
+
+            for (u32 i = 0; i < region.size.x; ++i) {
+                target[i] = blend(target[i], source[i].color);
+            }
+
+            if (m_idBufferEnabled) {
+                writeIds((region.position.y + row) * m_bufferSize.x + region.position.x, 1u, region.size.x, blendMode, [source](u32 i) { return source[i].color; });
+            }
+        }
+
+        markDirty(region);
+
+        if (m_recording) {
+            for (u32 row = 0; row < region.size.y; ++row) {
+                m_recording->record((region.position.y + row) * m_bufferSize.x + region.position.x, fragments + static_cast<std::size_t>(row) * region.size.x, region.size.x, blendMode);
+            }
+        }
+    }
+
+    void RenderTarget::fillSpan(u32 index, u32 stride, u32 count, const Color &color, BlendMode blendMode) {
+        Color *pixels = m_pixelBuffer.getBuffer().data() + index;
+
+        if (m_idBufferEnabled) {
+            writeIds(index, stride, count, blendMode, [&](u32) { return color; });
+        }
+
+        if (blendMode == BlendMode::None && stride == 1) {
+            std::fill_n(pixels, count, color);
+            return;
+        }
+
+        const Color::BlendFunction blend = Color::getBlendFunction(blendMode);
+        for (u32 i = 0; i < count; ++i, pixels += stride) {
+            *pixels = blend(*pixels, color);
+        }
+    }
+
+    void RenderTarget::fillGradientSpan(u32 index, u32 stride, u32 count, const Color &startColor, const Color &endColor, u32 firstStep, u32 stepCount, BlendMode blendMode) {
+        const Color::BlendFunction blend = Color::getBlendFunction(blendMode);
+        Color *pixels = m_pixelBuffer.getBuffer().data() + index;
+
+        // Channels advance in 16.16 fixed point, one addition per pixel
+        u8 Color::*const channels[4] = { &Color::r, &Color::g, &Color::b, &Color::a };
+        i32 value[4];
+        i32 delta[4];
+
+        for (u32 c = 0; c < 4; ++c) {
+            const i32 start = static_cast<i32>(startColor.*channels[c]) << 16;
+            const i32 end = static_cast<i32>(endColor.*channels[c]) << 16;
+
+            delta[c] = stepCount > 0 ? static_cast<i32>((static_cast<i64>(end) - start) / stepCount) : 0;
+            value[c] = start + delta[c] * static_cast<i32>(firstStep) + 0x8000;
+        }
+
+        for (u32 i = 0; i < count; ++i, pixels += stride) {
+            Color color;
+            for (u32 c = 0; c < 4; ++c) {
+                color.*channels[c] = static_cast<u8>(std::clamp(value[c] >> 16, 0, 255));
+                value[c] += delta[c];
+            }
+
+            *pixels = blend(*pixels, color);
+
+            if (m_idBufferEnabled && (blendMode == BlendMode::None || color.a > 0)) {
+                m_idBuffer[index + i * stride] = m_activeDrawId;
+            }
+        }
+    }
+
+    void RenderTarget::blendColors(u32 index, const Color *colors, u32 count, BlendMode blendMode) {
+        Color *pixels = m_pixelBuffer.getBuffer().data() + index;
+
+        if (m_idBufferEnabled) {
+            writeIds(index, 1u, count, blendMode, [colors](u32 i) { return colors[i]; });
+        }
+
+        if (blendMode == BlendMode::None) {
+            std::copy_n(colors, count, pixels);
+            return;
+        }
+
+        const Color::BlendFunction blend = Color::getBlendFunction(blendMode);
+        for (u32 i = 0; i < count; ++i) {
+            pixels[i] = blend(pixels[i], colors[i]);
+        }
+    }
+
+    filters::BaseData &RenderTarget::getBaseData() {
+        return m_baseData;
+    }
+
+    void RenderTarget::setRenderer(Renderer *renderer) {
+        m_renderer = renderer;
+    }
+
+    void DrawCommandBuffer::sort() {
+        m_useSortedCommands = false;
+
+        auto byKey = [](const SortEntry &a, const SortEntry &b) {
+            return a.key < b.key;
+        };
+
+        if (std::is_sorted(m_sortEntries.begin(), m_sortEntries.end(), byKey)) {
+            return;
+        }
+
+        std::sort(m_sortEntries.begin(), m_sortEntries.end(), byKey);
+
+        m_sortedCommands.resize(m_commands.size());
+
+        std::size_t destination = 0;
+        for (const auto &entry : m_sortEntries) {
+            const std::byte *command = m_commands.data() + entry.offset;
+
+            DrawCommandHeader header;
+            std::memcpy(&header, command, sizeof(header));
+            std::memcpy(m_sortedCommands.data() + destination, command, header.size);
+
+            destination += header.size;
+        }
+
+        m_useSortedCommands = true;
+    }
+
+    void DrawCommandBuffer::clear() {
+        m_commands.clear();
+        m_sortedCommands.clear();
+        m_sortEntries.clear();
+        m_useSortedCommands = false;
+    }
+
+    u32 DrawCommandBuffer::getCommandCount() const {
+        return static_cast<u32>(m_sortEntries.size());
+    }
+
+    u64 DrawCommandBuffer::makeSortKey(f32 depth, u32 sequence) {
+        u32 bits = std::bit_cast<u32>(depth);
+        u32 orderedDepth = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+
+        return (static_cast<u64>(~orderedDepth) << 32) | sequence;
+    }
+
+    void Renderer::drawImmediatePixel(RenderTarget &renderTarget, const Vector2<u32> &position, const Color &color, BlendMode blendMode) {
+        if (position.x >= renderTarget.getBufferSize().x || position.y >= renderTarget.getBufferSize().y) {
+            return;
+        }
+        renderTarget.setPixelWithBlend(position, color, blendMode);
+        renderTarget.markDirty({ position, { 1u, 1u } });
+    }
+
+    void Renderer::drawImmediateRect(RenderTarget &renderTarget, const Vector2<i32> &position, const Vector2<u32> &size, const Color &color, BlendMode blendMode) {
+        const Vector2<u32> bufferSize = renderTarget.getBufferSize();
+
+        ClippedRect rect;
+        if (!clipRect(bufferSize, position, size, rect)) {
+            return;
+        }
+
+        renderTarget.markDirty({ { rect.x, rect.y }, { rect.width, rect.height } });
+
+        #pragma omp parallel for
+        for (i32 row = 0; row < static_cast<i32>(rect.height); ++row) {
+            renderTarget.fillSpan((rect.y + row) * bufferSize.x + rect.x, 1, rect.width, color, blendMode);
         }
     }
 
-    void RenderTarget::registerDrawCall(const DrawCallData &drawCallData, f32 depth) {
-        m_drawCallDataPool.push_back(drawCallData);
-        m_drawCalls.push_back({ depth, static_cast<u32>(m_drawCallDataPool.size() - 1) });
-    }
+    void Renderer::drawImmediateHorizontalSpan(RenderTarget &renderTarget, const Vector2<i32> &start, u32 length, const Color &color, BlendMode blendMode) {
+        const Vector2<u32> bufferSize = renderTarget.getBufferSize();
 
-    void RenderTarget::clearDrawCalls() {
-        m_drawCalls.clear();
-        m_drawCallDataPool.clear();
-    }
+        ClippedRect span;
+        if (!clipRect(bufferSize, start, { length, 1u }, span)) {
+            return;
+        }
 
-    const Vector2<u32> &RenderTarget::getBufferSize() const {
-        return m_bufferSize;
-    }
+        renderTarget.markDirty({ { span.x, span.y }, { span.width, 1u } });
 
-    void RenderTarget::setBufferSize(const Vector2<u32> &size) {
-        m_bufferSize = size;
-        m_pixelBuffer.getBuffer().resize(size.x * size.y);
+        renderTarget.fillSpan(span.y * bufferSize.x + span.x, 1, span.width, color, blendMode);
     }
 
-    void RenderTarget::setPixel(u32 index, const Color &color) {
-        m_pixelBuffer[index] = color;
-    }
+    void Renderer::drawImmediateHorizontalSpan(RenderTarget &renderTarget, const Vector2<i32> &start, u32 length, const Color &startColor, const Color &endColor, BlendMode blendMode) {
+        const Vector2<u32> bufferSize = renderTarget.getBufferSize();
 
-    void RenderTarget::setPixel(const Vector2<u32> &position, const Color &color) {
-        u32 index = position.y * m_bufferSize.x + position.x;
-        setPixel(index, color);
+        ClippedRect span;
+        if (!clipRect(bufferSize, start, { length, 1u }, span)) {
+            return;
+        }
+
+        renderTarget.markDirty({ { span.x, span.y }, { span.width, 1u } });
+
+        renderTarget.fillGradientSpan(span.y * bufferSize.x + span.x, 1, span.width, startColor, endColor, span.skipX, length - 1, blendMode);
     }
 
-    void RenderTarget::setPixelWithBlend(u32 index, const Color &color, BlendMode blendMode) {
-        Color destinationColor = m_pixelBuffer[index];
+    void Renderer::drawImmediateVerticalSpan(RenderTarget &renderTarget, const Vector2<i32> &start, u32 length, const Color &color, BlendMode blendMode) {
+        const Vector2<u32> bufferSize = renderTarget.getBufferSize();
 
-        m_pixelBuffer[index] = Color::applyBlend(destinationColor, color, blendMode);
+        ClippedRect span;
+        if (!clipRect(bufferSize, start, { 1u, length }, span)) {
+            return;
+        }
+
+        renderTarget.markDirty({ { span.x, span.y }, { 1u, span.height } });
+
+        renderTarget.fillSpan(span.y * bufferSize.x + span.x, bufferSize.x, span.height, color, blendMode);
     }
 
-    void RenderTarget::setPixelWithBlend(const Vector2<u32> &position, const Color &color, BlendMode blendMode) {
-        u32 index = position.y * m_bufferSize.x + position.x;
-        setPixelWithBlend(index, color, blendMode);
+    void Renderer::drawImmediateVerticalSpan(RenderTarget &renderTarget, const Vector2<i32> &start, u32 length, const Color &startColor, const Color &endColor, BlendMode blendMode) {
+        const Vector2<u32> bufferSize = renderTarget.getBufferSize();
+
+        ClippedRect span;
+        if (!clipRect(bufferSize, start, { 1u, length }, span)) {
+            return;
+        }
+
+        renderTarget.markDirty({ { span.x, span.y }, { 1u, span.height } });
+
+        renderTarget.fillGradientSpan(span.y * bufferSize.x + span.x, bufferSize.x, span.height, startColor, endColor, span.skipY, length - 1, blendMode);
     }
 
-    filters::BaseData &RenderTarget::getBaseData() {
-        return m_baseData;
+    void Renderer::drawImmediatePixels(RenderTarget &renderTarget, const Vector2<i32> &position, const Vector2<u32> &size, const Color *pixels, BlendMode blendMode) {
+        blitPixels(renderTarget, position, size, pixels, size.x, blendMode);
     }
 
-    void RenderTarget::setRenderer(Renderer *renderer) {
-        m_renderer = renderer;
+    void Renderer::drawImmediateTexture(RenderTarget &renderTarget, const Vector2<i32> &position, const Texture &texture, BlendMode blendMode) {
+        blitPixels(renderTarget, position, texture.getSize(), texture.getRawData().data(), texture.getSize().x, blendMode);
     }
 
-    void RenderTarget::sortDrawCalls() {
-        std::sort(m_drawCalls.begin(), m_drawCalls.end(), [](const DrawCall &a, const DrawCall &b) {
-            return a.depth > b.depth;
-        });
+    void Renderer::drawImmediateTexture(RenderTarget &renderTarget, const Vector2<i32> &position, const Texture &texture, const Vector2<u32> &sourcePosition, const Vector2<u32> &sourceSize, BlendMode blendMode) {
+        const Vector2<u32> textureSize = texture.getSize();
+
+        if (sourcePosition.x >= textureSize.x || sourcePosition.y >= textureSize.y) {
+            return;
+        }
+
+        const Vector2<u32> size {
+            std::min(sourceSize.x, textureSize.x - sourcePosition.x),
+            std::min(sourceSize.y, textureSize.y - sourcePosition.y)
+        };
+
+        const Color *source = texture.getRawData().data() + sourcePosition.y * textureSize.x + sourcePosition.x;
+        blitPixels(renderTarget, position, size, source, textureSize.x, blendMode);
     }
 
-    void Renderer::drawImmediatePixel(RenderTarget &renderTarget, const Vector2<u32> &position, const Color &color, BlendMode blendMode) {
-        if (position.x > renderTarget.getBufferSize().x || position.y > renderTarget.getBufferSize().y) {
+    void Renderer::blitPixels(RenderTarget &renderTarget, const Vector2<i32> &position, const Vector2<u32> &size, const Color *pixels, u32 sourceStride, BlendMode blendMode) {
+        const Vector2<u32> bufferSize = renderTarget.getBufferSize();
+
+        ClippedRect rect;
+        if (!clipRect(bufferSize, position, size, rect)) {
             return;
         }
-        renderTarget.setPixelWithBlend(position, color, blendMode);
+
+        renderTarget.markDirty({ { rect.x, rect.y }, { rect.width, rect.height } });
+
+        #pragma omp parallel for
+        for (i32 row = 0; row < static_cast<i32>(rect.height); ++row) {
+            const Color *sourceRow = pixels + static_cast<std::size_t>(rect.skipY + row) * sourceStride + rect.skipX;
+            renderTarget.blendColors((rect.y + row) * bufferSize.x + rect.x, sourceRow, rect.width, blendMode);
+        }
     }
 
     void Renderer::drawImmediateLine(RenderTarget &renderTarget, const Vector2<u32> &start, const Vector2<u32> &end, const Color &color, BlendMode blendMode) {
@@ -146,10 +877,19 @@ namespace til
                 err += dx;
             }
         }
+
+        // Every plotted pixel lies in the box spanned by the end points
+        const Vector2<u32> minimum { std::min(start.x, end.x), std::min(start.y, end.y) };
+        const Vector2<u32> maximum { std::max(start.x, end.x) + 1u, std::max(start.y, end.y) + 1u };
+        renderTarget.markDirty({ minimum, maximum - minimum });
     }
 
     void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::Vertex &vertex, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
-        Vector2<f32> transformedPosition = transform.getMatrix() * vertex.position;
+        drawImmediate(renderTarget, vertex, transform.getAffineMatrix(), fragmentPipeline, blendMode);
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::Vertex &vertex, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        Vector2<f32> transformedPosition = matrix * vertex.position;
 
         if (
             transformedPosition.x < 0.f ||
@@ -173,48 +913,151 @@ namespace til
 
         fragmentPipeline.run(&m_fragmentInputBuffer, &m_fragmentOutputBuffer, renderTarget.getBaseData());
 
-        renderTarget.setPixelWithBlend({ static_cast<u32>(transformedPosition.x), static_cast<u32>(transformedPosition.y) }, m_fragmentOutputBuffer[0].color, blendMode);
+        const Vector2<u32> pixel { static_cast<u32>(transformedPosition.x), static_cast<u32>(transformedPosition.y) };
+        renderTarget.setPixelWithBlend(pixel, m_fragmentOutputBuffer[0].color, blendMode);
+        renderTarget.markDirty({ pixel, { 1u, 1u } });
     }
 
     void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::Line &line, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
-        Matrix3<f32> transformMatrix = transform.getMatrix();
+        drawImmediate(renderTarget, line, transform.getAffineMatrix(), fragmentPipeline, blendMode);
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::Line &line, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        const primitives::Vertex vertices[2] = { line.start, line.end };
+        drawSegments(renderTarget, vertices, 1, false, matrix, fragmentPipeline, blendMode);
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::LineList &lines, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        drawImmediate(renderTarget, lines, transform.getAffineMatrix(), fragmentPipeline, blendMode);
+    }
 
-        Vector2<f32> startTransformed = transformMatrix * line.start.position;
-        Vector2<f32> endTransformed = transformMatrix * line.end.position;
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::LineList &lines, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        if (lines.firstVertex + lines.vertexCount > m_meshVertices.size()) {
+            invokeError<InvalidArgumentError>("Renderer couldn't find the specified line list vertices");
+        }
+
+        if (lines.vertexCount % 2 != 0) {
+            invokeError<InvalidArgumentError>("Line list vertex count must be a multiple of 2.");
+        }
+
+        drawSegments(renderTarget, m_meshVertices.data() + lines.firstVertex, lines.vertexCount / 2, false, matrix, fragmentPipeline, blendMode);
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::LineStrip &strip, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        drawImmediate(renderTarget, strip, transform.getAffineMatrix(), fragmentPipeline, blendMode);
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::LineStrip &strip, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        if (strip.firstVertex + strip.vertexCount > m_meshVertices.size()) {
+            invokeError<InvalidArgumentError>("Renderer couldn't find the specified line strip vertices");
+        }
+
+        if (strip.vertexCount < 2) {
+            invokeError<InvalidArgumentError>("Not enough vertices to form a line strip.");
+        }
+
+        drawSegments(renderTarget, m_meshVertices.data() + strip.firstVertex, strip.vertexCount - 1, true, matrix, fragmentPipeline, blendMode);
+    }
+
+    void Renderer::drawSegments(RenderTarget &renderTarget, const primitives::Vertex *vertices, u32 segmentCount, bool strip, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        const Vector2<u32> renderTargetSize = renderTarget.getBufferSize();
 
-        if (!clipLineToRect(startTransformed, endTransformed, renderTarget.getBufferSize())) {
+        if (segmentCount == 0 || renderTargetSize.x == 0 || renderTargetSize.y == 0) {
             return;
         }
 
-        Vector2<f32> difference = endTransformed - startTransformed;
-        Vector2<f32> inverseDifference = { 1.f / difference.x, 1.f / difference.y };
-        float length = difference.magnitude();
+        m_lineSegments.resize(segmentCount);
 
-        filters::VertexData pixelData;
+        #pragma omp parallel for if (segmentCount > 256)
+        for (i64 s = 0; s < static_cast<i64>(segmentCount); ++s) {
+            const primitives::Vertex &a = vertices[strip ? s : s * 2];
+            const primitives::Vertex &b = vertices[strip ? s + 1 : s * 2 + 1];
 
-        m_fragmentInputBuffer.clear();
+            const Vector2<f32> transformedStart = matrix * a.position;
+            const Vector2<f32> transformedEnd = matrix * b.position;
 
-        if (length < 1e-6f) {
-            pixelData.position = startTransformed;
-            pixelData.uv = { 0.f, 0.f };
-            pixelData.size = { 1.f, 1.f };
-            pixelData.inverseSize = { 1.f, 1.f };
+            Vector2<f32> start = transformedStart;
+            Vector2<f32> end = transformedEnd;
 
-            m_fragmentInputBuffer.getBuffer().push_back(pixelData);
-        } else {
-            u32 steps = static_cast<u32>(std::ceil(length));
-            f32 inverseSteps = 1.f / static_cast<f32>(steps);
-            Vector2<f32> step = difference / static_cast<f32>(steps);
+            LineSegment &segment = m_lineSegments[s];
+            segment.length = 0;
+
+            if (!clipLineToRect(start, end, renderTargetSize)) {
+                continue;
+            }
+
+            // Carry the texture coordinates over to the clipped end points
+            const Vector2<f32> direction = transformedEnd - transformedStart;
+            const f32 lengthSquared = direction.x * direction.x + direction.y * direction.y;
+
+            f32 tStart = 0.f, tEnd = 1.f;
+            if (lengthSquared > 0.f) {
+                tStart = ((start.x - transformedStart.x) * direction.x + (start.y - transformedStart.y) * direction.y) / lengthSquared;
+                tEnd = ((end.x - transformedStart.x) * direction.x + (end.y - transformedStart.y) * direction.y) / lengthSquared;
+            }
+
+            segment.uvStart = a.uv + (b.uv - a.uv) * tStart;
+            segment.uvEnd = a.uv + (b.uv - a.uv) * tEnd;
+
+            const Vector2<f32> difference = end - start;
+
+            if (difference.magnitude() < 1e-6f) {
+                segment.size = { 1.f, 1.f };
+                segment.inverseSize = { 1.f, 1.f };
+            } else {
+                segment.size = difference;
+                segment.inverseSize = { 1.f / difference.x, 1.f / difference.y };
+            }
+
+            segment.start = { static_cast<i32>(std::lround(start.x)), static_cast<i32>(std::lround(start.y)) };
+            segment.delta = Vector2<i32>{ static_cast<i32>(std::lround(end.x)), static_cast<i32>(std::lround(end.y)) } - segment.start;
+
+            // A strip segment starting where the previous one ended would plot that pixel twice
+            segment.firstStep = (strip && s > 0 && start == transformedStart) ? 1u : 0u;
+
+            const u32 steps = static_cast<u32>(std::max(std::abs(segment.delta.x), std::abs(segment.delta.y)));
+            segment.length = steps + 1 - segment.firstStep;
+        }
+
+        m_fragmentInputBuffer.setSize(assignFragmentOffsets(m_lineSegments));
+
+        filters::VertexData *fragments = m_fragmentInputBuffer.getBuffer().data();
 
-            for (u32 i = 0; i <= steps; ++i) {
-                Vector2<f32> position = startTransformed + step * static_cast<f32>(i);
+        #pragma omp parallel for schedule(dynamic, 16)
+        for (i64 s = 0; s < static_cast<i64>(segmentCount); ++s) {
+            const LineSegment &segment = m_lineSegments[s];
 
-                pixelData.position = position;
-                pixelData.uv = { static_cast<f32>(i) * inverseSteps, 0.f };
-                pixelData.size = difference;
-                pixelData.inverseSize = inverseDifference;
+            if (segment.length == 0) {
+                continue;
+            }
+
+            const i64 dx = segment.delta.x;
+            const i64 dy = segment.delta.y;
+            const i64 steps = std::max(std::abs(dx), std::abs(dy));
+            const bool xMajor = std::abs(dx) >= std::abs(dy);
+            const f32 inverseSteps = steps > 0 ? 1.f / static_cast<f32>(steps) : 0.f;
+            const Vector2<f32> uvDelta = segment.uvEnd - segment.uvStart;
+
+            filters::VertexData pixelData;
+            pixelData.size = segment.size;
+            pixelData.inverseSize = segment.inverseSize;
+
+            filters::VertexData *output = fragments + segment.firstFragment - segment.firstStep;
+
+            for (i64 i = segment.firstStep; i <= steps; ++i) {
+                // One pixel per major axis step, minor axis rounded exactly as Bresenham would
+                i64 x, y;
+                if (xMajor) {
+                    x = segment.start.x + (dx < 0 ? -i : i);
+                    y = segment.start.y + (steps > 0 ? roundDivide(i * dy, steps) : 0);
+                } else {
+                    x = segment.start.x + roundDivide(i * dx, steps);
+                    y = segment.start.y + (dy < 0 ? -i : i);
+                }
 
-                m_fragmentInputBuffer.getBuffer().push_back(pixelData);
+                pixelData.position = { static_cast<f32>(x), static_cast<f32>(y) };
+                pixelData.uv = segment.uvStart + uvDelta * (static_cast<f32>(i) * inverseSteps);
+                output[i] = pixelData;
             }
         }
 
@@ -222,14 +1065,85 @@ namespace til
 
         fragmentPipeline.run(&m_fragmentInputBuffer, &m_fragmentOutputBuffer, renderTarget.getBaseData());
 
-        for (i32 i = 0; i < m_fragmentOutputBuffer.getSize(); ++i) {
-            renderTarget.setPixelWithBlend({ static_cast<u32>(m_fragmentInputBuffer[i].position.x), static_cast<u32>(m_fragmentInputBuffer[i].position.y) }, m_fragmentOutputBuffer[i].color, blendMode);
+        renderTarget.blendFragments(m_fragmentInputBuffer.getBuffer().data(), m_fragmentOutputBuffer.getBuffer().data(), m_fragmentInputBuffer.getSize(), blendMode);
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const FragmentRecording &recording) {
+        if (!recording.isValidFor(renderTarget) || &recording == renderTarget.m_recording) {
+            return;
+        }
+
+        const Color *colors = recording.m_colors.data();
+
+        for (const FragmentRecording::Run &run : recording.m_runs) {
+            renderTarget.blendColors(run.index, colors, run.count, run.blendMode);
+
+            if (renderTarget.m_recording) {
+                renderTarget.m_recording->record(run.index, colors, run.count, run.blendMode);
+            }
+
+            colors += run.count;
+        }
+
+        if (!recording.m_bounds.isEmpty()) {
+            renderTarget.markDirty(recording.m_bounds);
+        }
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::FragmentPass &pass, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        const Vector2<u32> renderTargetSize = renderTarget.getBufferSize();
+
+        const Rect<i32> region = pass.fullTarget
+            ? Rect<i32>({ 0, 0 }, { static_cast<i32>(renderTargetSize.x), static_cast<i32>(renderTargetSize.y) })
+            : pass.region;
+
+        if (region.isEmpty()) {
+            return;
+        }
+
+        ClippedRect rect;
+        if (!clipRect(renderTargetSize, region.position, { static_cast<u32>(region.size.x), static_cast<u32>(region.size.y) }, rect)) {
+            return;
+        }
+
+        const Vector2<f32> size { static_cast<f32>(region.size.x), static_cast<f32>(region.size.y) };
+        const Vector2<f32> inverseSize { 1.f / size.x, 1.f / size.y };
+
+        m_fragmentInputBuffer.setSize(rect.width * rect.height);
+        filters::VertexData *fragments = m_fragmentInputBuffer.getBuffer().data();
+
+        // Row tiles are independent: each row writes its own slice of the fragment stream
+        #pragma omp parallel for
+        for (i32 row = 0; row < static_cast<i32>(rect.height); ++row) {
+            filters::VertexData pixelData;
+            pixelData.position = { static_cast<f32>(rect.x), static_cast<f32>(rect.y + row) };
+            pixelData.uv = { static_cast<f32>(rect.skipX) * inverseSize.x, static_cast<f32>(rect.skipY + row) * inverseSize.y };
+            pixelData.size = size;
+            pixelData.inverseSize = inverseSize;
+
+            filters::VertexData *output = fragments + static_cast<std::size_t>(row) * rect.width;
+
+            for (u32 i = 0; i < rect.width; ++i) {
+                output[i] = pixelData;
+
+                pixelData.position.x += 1.f;
+                pixelData.uv.x = static_cast<f32>(rect.skipX + i + 1) * inverseSize.x;
+            }
         }
+
+        m_fragmentOutputBuffer.setSize(m_fragmentInputBuffer.getSize());
+
+        fragmentPipeline.run(&m_fragmentInputBuffer, &m_fragmentOutputBuffer, renderTarget.getBaseData());
+
+        renderTarget.blendRect({ { rect.x, rect.y }, { rect.width, rect.height } }, m_fragmentOutputBuffer.getBuffer().data(), blendMode);
     }
 
     void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::Ellipse &ellipse, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
-        Matrix3<f32> transformMatrix = transform.getMatrix();
-        Matrix3<f32> inverseMatrix = transformMatrix.inverse();
+        drawImmediate(renderTarget, ellipse, transform.getAffineMatrix(), fragmentPipeline, blendMode);
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::Ellipse &ellipse, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        AffineMatrix<f32> inverseMatrix = matrix.inverse();
 
         Vector2<f32> corners[4] = {
             { ellipse.center.x - ellipse.radii.x, ellipse.center.y - ellipse.radii.y },
@@ -238,11 +1152,13 @@ namespace til
             { ellipse.center.x - ellipse.radii.x, ellipse.center.y + ellipse.radii.y }
         };
 
-        Vector2<f32> topLeft = transformMatrix * corners[0];
+        transformPoints(matrix, corners, corners, 4);
+
+        Vector2<f32> topLeft = corners[0];
         Vector2<f32> bottomRight = topLeft;
 
         for (u32 i = 1; i < 4; ++i) {
-            Vector2<f32> transformedCorner = transformMatrix * corners[i];
+            const Vector2<f32> &transformedCorner = corners[i];
 
             topLeft.x = std::min(topLeft.x, transformedCorner.x);
             topLeft.y = std::min(topLeft.y, transformedCorner.y);
@@ -265,53 +1181,125 @@ namespace til
             return;
         }
 
-        m_fragmentInputBuffer.clear();
+        const Vector2<f32> inverseRadii = { 1.f / ellipse.radii.x, 1.f / ellipse.radii.y };
 
-        #pragma omp parallel
-        {
-            std::vector<filters::VertexData> localBuffer;
-            localBuffer.reserve(256);
-
-            #pragma omp for collapse(2) schedule(dynamic)
-            for (int y = clippedTop; y <= clippedBottom; ++y) {
-                for (int x = clippedLeft; x <= clippedRight; ++x) {
-                    Vector2<f32> pixelPos = { static_cast<f32>(x), static_cast<f32>(y) };
-                    Vector2<f32> localPos = inverseMatrix * pixelPos;
-
-                    f32 dx = localPos.x - ellipse.center.x;
-                    f32 dy = localPos.y - ellipse.center.y;
-                    f32 distanceSquared = (dx * dx) / (ellipse.radii.x * ellipse.radii.x) + (dy * dy) / (ellipse.radii.y * ellipse.radii.y);
-
-                    if (distanceSquared <= 1.f) {
-                        filters::VertexData pixelData;
-                        
-                        pixelData.position = pixelPos;
-                        pixelData.uv = {
-                            (localPos.x - ellipse.center.x) * inverseDiameter.x + 0.5f,
-                            (localPos.y - ellipse.center.y) * inverseDiameter.y + 0.5f
-                        };
-                        pixelData.size = size;
-                        pixelData.inverseSize = inverseSize;
-
-                        localBuffer.push_back(pixelData);
-                    }
-                }
+        // Local position along a row is linear in x: rowOrigin(y) + x * localStep
+        const Vector2<f32> localStep = { inverseMatrix[0][0], inverseMatrix[1][0] };
+
+        auto localRowOrigin = [&](i32 y) {
+            return inverseMatrix * Vector2<f32>{ 0.f, static_cast<f32>(y) } - ellipse.center;
+        };
+
+        auto inside = [&](const Vector2<f32> &rowOrigin, i32 x) {
+            Vector2<f32> localPos = rowOrigin + localStep * static_cast<f32>(x);
+
+            f32 dx = localPos.x * inverseRadii.x;
+            f32 dy = localPos.y * inverseRadii.y;
+
+            return dx * dx + dy * dy <= 1.f;
+        };
+
+        const i32 rowCount = clippedBottom - clippedTop + 1;
+
+        m_fragmentSpans.resize(rowCount);
+
+        #pragma omp parallel for schedule(static)
+        for (i32 row = 0; row < rowCount; ++row) {
+            const i32 y = clippedTop + row;
+            const Vector2<f32> rowOrigin = localRowOrigin(y);
+
+            FragmentSpan &span = m_fragmentSpans[row];
+            span.x = static_cast<u32>(clippedLeft);
+            span.y = static_cast<u32>(y);
+            span.length = 0;
+
+            // The normalized distance is quadratic in x, so its roots bound the covered run
+            const f32 ax = localStep.x * inverseRadii.x, bx = rowOrigin.x * inverseRadii.x;
+            const f32 ay = localStep.y * inverseRadii.y, by = rowOrigin.y * inverseRadii.y;
+
+            const f32 a = ax * ax + ay * ay;
+            const f32 b = 2.f * (ax * bx + ay * by);
+            const f32 c = bx * bx + by * by - 1.f;
+            const f32 discriminant = b * b - 4.f * a * c;
+
+            if (a <= 0.f || discriminant < 0.f) {
+                continue;
+            }
+
+            const f32 root = std::sqrt(discriminant);
+            const f32 first = (-b - root) / (2.f * a);
+            const f32 last = (-b + root) / (2.f * a);
+
+            if (last < static_cast<f32>(clippedLeft) - 1.f || first > static_cast<f32>(clippedRight) + 1.f) {
+                continue;
+            }
+
+            i32 start = std::clamp(static_cast<i32>(std::ceil(first)), clippedLeft, clippedRight);
+            i32 end = std::clamp(static_cast<i32>(std::floor(last)), clippedLeft, clippedRight);
+
+            // Settle rounding at both ends against the exact per-pixel test
+            while (start > clippedLeft && inside(rowOrigin, start - 1)) --start;
+            while (start <= end && !inside(rowOrigin, start)) ++start;
+            while (end < clippedRight && inside(rowOrigin, end + 1)) ++end;
+            while (end >= start && !inside(rowOrigin, end)) --end;
+
+            if (start <= end) {
+                span.x = static_cast<u32>(start);
+                span.length = static_cast<u32>(end - start + 1);
+            }
+        }
+
+        m_fragmentInputBuffer.setSize(assignFragmentOffsets(m_fragmentSpans));
+
+        filters::VertexData *fragments = m_fragmentInputBuffer.getBuffer().data();
+
+        #pragma omp parallel for schedule(static)
+        for (i32 row = 0; row < rowCount; ++row) {
+            const FragmentSpan &span = m_fragmentSpans[row];
+
+            if (span.length == 0) {
+                continue;
             }
 
-            #pragma omp critical
-            m_fragmentInputBuffer.getBuffer().insert(m_fragmentInputBuffer.getBuffer().end(), localBuffer.begin(), localBuffer.end());
+            Vector2<f32> localPos = localRowOrigin(static_cast<i32>(span.y)) + localStep * static_cast<f32>(span.x);
+
+            filters::VertexData pixelData;
+            pixelData.position = { static_cast<f32>(span.x), static_cast<f32>(span.y) };
+            pixelData.size = size;
+            pixelData.inverseSize = inverseSize;
+
+            filters::VertexData *output = fragments + span.firstFragment;
+
+            for (u32 i = 0; i < span.length; ++i) {
+                pixelData.uv = {
+                    localPos.x * inverseDiameter.x + 0.5f,
+                    localPos.y * inverseDiameter.y + 0.5f
+                };
+                output[i] = pixelData;
+
+                pixelData.position.x += 1.f;
+                localPos += localStep;
+            }
         }
 
         m_fragmentOutputBuffer.setSize(m_fragmentInputBuffer.getSize());
 
         fragmentPipeline.run(&m_fragmentInputBuffer, &m_fragmentOutputBuffer, renderTarget.getBaseData());
 
-        for (i32 i = 0; i < m_fragmentOutputBuffer.getSize(); ++i) {
-            renderTarget.setPixelWithBlend({ static_cast<u32>(m_fragmentInputBuffer[i].position.x), static_cast<u32>(m_fragmentInputBuffer[i].position.y) }, m_fragmentOutputBuffer[i].color, blendMode);
+        const filters::VertexData *shadedFragments = m_fragmentOutputBuffer.getBuffer().data();
+
+        for (const FragmentSpan &span : m_fragmentSpans) {
+            if (span.length > 0) {
+                renderTarget.blendSpan(span.y * renderTargetSize.x + span.x, shadedFragments + span.firstFragment, span.length, blendMode);
+            }
         }
     }
 
     void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::TriangleMesh &mesh, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
+        drawImmediate(renderTarget, mesh, transform.getAffineMatrix(), fragmentPipeline, blendMode);
+    }
+
+    void Renderer::drawImmediate(RenderTarget &renderTarget, const primitives::TriangleMesh &mesh, const AffineMatrix<f32> &matrix, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, BlendMode blendMode) {
         u32 meshStart = mesh.firstVertex;
         u32 meshEnd = mesh.firstVertex + mesh.vertexCount;
 
@@ -329,26 +1317,28 @@ namespace til
             invokeError<InvalidArgumentError>("Not enough vertices to form a mesh.");
         }
 
-        Matrix3<f32> transformMatrix = transform.getMatrix();
-
-        #pragma omp parallel for
-        for (u32 i = meshStart; i < meshEnd; ++i) {
-            m_meshVertices[i].position = transformMatrix * m_meshVertices[i].position;
-        }
+        m_transformedPositions.resize(mesh.vertexCount);
+        transformPointsStrided(matrix, &m_meshVertices[meshStart].position, sizeof(primitives::Vertex), m_transformedPositions.data(), mesh.vertexCount);
 
         struct TriangleParams {
-            Vector2<f32> uv1, uv2, uv3;
-            Vector2<f32> topLeft, bottomRight;
+            Vector2<f32> origin;                 // first vertex, where the attribute planes are anchored
+            Vector2<f32> uvOrigin;               // uv at the first vertex
+            Vector2<f32> uvDx, uvDy;             // constant uv increments per pixel step in x and y
             Vector2<f32> size, inverseSize;
-            f32 inverseArea;
+            i32 left, top, right, bottom;        // clipped pixel bounds, empty when left > right or top > bottom
 
             f32 e1a, e1b, e1c;
             f32 e2a, e2b, e2c;
             f32 e3a, e3b, e3c;
             
             bool e1_topLeft, e2_topLeft, e3_topLeft;
+
+            FixedPointEdge f1, f2, f3;
         };
 
+        const bool fixedPoint = m_rasterizationMode == RasterizationMode::FixedPoint;
+        const Vector2<u32> renderTargetSize = renderTarget.getBufferSize();
+
         auto isTopOrLeftEdge = [](const Vector2<f32> &p1, const Vector2<f32> &p2) {
             return (p1.y == p2.y) ? (p1.x < p2.x) : (p1.y > p2.y);
         };
@@ -357,20 +1347,20 @@ namespace til
         
         #pragma omp parallel for
         for (int i = 0; i < triangleCount; ++i) {
-            auto p1 = m_meshVertices[meshStart + i * 3].position;
-            auto p2 = m_meshVertices[meshStart + i * 3 + 1].position;
-            auto p3 = m_meshVertices[meshStart + i * 3 + 2].position;
+            auto p1 = m_transformedPositions[i * 3];
+            auto p2 = m_transformedPositions[i * 3 + 1];
+            auto p3 = m_transformedPositions[i * 3 + 2];
 
-            auto &triangle = triangles[i];
+            auto uv1 = m_meshVertices[meshStart + i * 3].uv;
+            auto uv2 = m_meshVertices[meshStart + i * 3 + 1].uv;
+            auto uv3 = m_meshVertices[meshStart + i * 3 + 2].uv;
 
-            triangle.uv1 = m_meshVertices[meshStart + i * 3].uv;
-            triangle.uv2 = m_meshVertices[meshStart + i * 3 + 1].uv;
-            triangle.uv3 = m_meshVertices[meshStart + i * 3 + 2].uv;
+            auto &triangle = triangles[i];
 
-            triangle.topLeft = { std::min({ p1.x, p2.x, p3.x }), std::min({ p1.y, p2.y, p3.y }) };
-            triangle.bottomRight = { std::max({ p1.x, p2.x, p3.x }), std::max({ p1.y, p2.y, p3.y }) };
+            Vector2<f32> topLeft = { std::min({ p1.x, p2.x, p3.x }), std::min({ p1.y, p2.y, p3.y }) };
+            Vector2<f32> bottomRight = { std::max({ p1.x, p2.x, p3.x }), std::max({ p1.y, p2.y, p3.y }) };
 
-            triangle.size = triangle.bottomRight - triangle.topLeft;
+            triangle.size = bottomRight - topLeft;
             triangle.inverseSize = { 1.f / triangle.size.x, 1.f / triangle.size.y };
 
             triangle.e1a = p1.y - p2.y; triangle.e1b = p2.x - p1.x; triangle.e1c = p1.x * p2.y - p2.x * p1.y;
@@ -382,125 +1372,225 @@ namespace til
             triangle.e3_topLeft = isTopOrLeftEdge(p3, p1);
 
             f32 area2 = (p2.x - p1.x) * (p3.y - p1.y) - (p3.x - p1.x) * (p2.y - p1.y);
-            triangle.inverseArea = (std::abs(area2) > 1e-6f) ? 1.f / area2 : 0.f;
+            f32 inverseArea = (std::abs(area2) > 1e-6f) ? 1.f / area2 : 0.f;
+
+            // Barycentric weights are linear in x and y, so the interpolated uv is a plane
+            // through uv1 at p1 with these constant gradients
+            triangle.origin = p1;
+            triangle.uvOrigin = uv1;
+            triangle.uvDx = (uv1 * triangle.e2a + uv2 * triangle.e3a + uv3 * triangle.e1a) * inverseArea;
+            triangle.uvDy = (uv1 * triangle.e2b + uv2 * triangle.e3b + uv3 * triangle.e1b) * inverseArea;
+
+            if (fixedPoint) {
+                i64 x1 = snapToSubpixel(p1.x), y1 = snapToSubpixel(p1.y);
+                i64 x2 = snapToSubpixel(p2.x), y2 = snapToSubpixel(p2.y);
+                i64 x3 = snapToSubpixel(p3.x), y3 = snapToSubpixel(p3.y);
+
+                triangle.f1 = makeFixedPointEdge(x1, y1, x2, y2);
+                triangle.f2 = makeFixedPointEdge(x2, y2, x3, y3);
+                triangle.f3 = makeFixedPointEdge(x3, y3, x1, y1);
+
+                i64 fixedArea2 = (x2 - x1) * (y3 - y1) - (x3 - x1) * (y2 - y1);
+
+                // Only counter-clockwise triangles with a non-zero snapped area can cover a sample
+                if (fixedArea2 > 0) {
+                    triangle.left = static_cast<i32>(ceilDivide(std::min({ x1, x2, x3 }), subpixelScale));
+                    triangle.top = static_cast<i32>(ceilDivide(std::min({ y1, y2, y3 }), subpixelScale));
+                    triangle.right = static_cast<i32>(floorDivide(std::max({ x1, x2, x3 }), subpixelScale));
+                    triangle.bottom = static_cast<i32>(floorDivide(std::max({ y1, y2, y3 }), subpixelScale));
+                } else {
+                    triangle.left = triangle.top = 0;
+                    triangle.right = triangle.bottom = -1;
+                }
+            } else {
+                triangle.left = static_cast<i32>(std::floor(topLeft.x));
+                triangle.top = static_cast<i32>(std::floor(topLeft.y));
+                triangle.right = static_cast<i32>(std::ceil(bottomRight.x));
+                triangle.bottom = static_cast<i32>(std::ceil(bottomRight.y));
+            }
+
+            triangle.left = std::max(triangle.left, 0);
+            triangle.top = std::max(triangle.top, 0);
+            triangle.right = std::min(triangle.right, static_cast<i32>(renderTargetSize.x) - 1);
+            triangle.bottom = std::min(triangle.bottom, static_cast<i32>(renderTargetSize.y) - 1);
         }
 
-        m_fragmentInputBuffer.clear();
+        // Covered pixels of a row form one contiguous run, so each row is reduced to its end points
+        auto findFixedPointSpan = [](const TriangleParams &triangle, i32 y) -> Vector2<i32> {
+            i64 start = triangle.left;
+            i64 end = triangle.right;
+            const i64 sampleY = static_cast<i64>(y) * subpixelScale;
+
+            // Solve a * 16x + rest >= 0 for x exactly, edge by edge
+            for (const FixedPointEdge *edge : { &triangle.f1, &triangle.f2, &triangle.f3 }) {
+                const i64 step = edge->a * subpixelScale;
+                const i64 rest = edge->b * sampleY + edge->c + edge->bias;
+
+                if (step > 0) {
+                    start = std::max(start, ceilDivide(-rest, step));
+                } else if (step < 0) {
+                    end = std::min(end, floorDivide(rest, -step));
+                } else if (rest < 0) {
+                    return { 0, -1 };
+                }
+            }
+
+            return { static_cast<i32>(start), static_cast<i32>(std::max(end, start - 1)) };
+        };
 
-        Vector2<u32> renderTargetSize = renderTarget.getBufferSize();
-        std::vector<filters::VertexData> triangleBuffer;
+        auto findFloatingPointSpan = [](const TriangleParams &triangle, i32 y) -> Vector2<i32> {
+            auto inside = [&](i32 x) {
+                f32 e1 = triangle.e1a * x + triangle.e1b * y + triangle.e1c;
+                f32 e2 = triangle.e2a * x + triangle.e2b * y + triangle.e2c;
+                f32 e3 = triangle.e3a * x + triangle.e3b * y + triangle.e3c;
+
+                return (e1 > 0 || (e1 == 0 && triangle.e1_topLeft)) &&
+                       (e2 > 0 || (e2 == 0 && triangle.e2_topLeft)) &&
+                       (e3 > 0 || (e3 == 0 && triangle.e3_topLeft));
+            };
+
+            // Only the uncovered pixels at both ends of the row are visited
+            i32 start = triangle.left;
+            while (start <= triangle.right && !inside(start)) {
+                ++start;
+            }
+
+            if (start > triangle.right) {
+                return { 0, -1 };
+            }
+
+            i32 end = triangle.right;
+            while (end > start && !inside(end)) {
+                --end;
+            }
+
+            return { start, end };
+        };
+
+        // Every triangle owns a contiguous range of row slots, one per row of its clipped bounds
+        m_rowOffsets.resize(triangleCount + 1);
 
+        u32 rowCount = 0;
         for (int ti = 0; ti < triangleCount; ++ti) {
             const auto &triangle = triangles[ti];
 
-            i32 clippedLeft = std::max(static_cast<i32>(std::floor(triangle.topLeft.x)), 0);
-            i32 clippedTop = std::max(static_cast<i32>(std::floor(triangle.topLeft.y)), 0);
-            i32 clippedRight = std::min(static_cast<i32>(std::ceil(triangle.bottomRight.x)), static_cast<i32>(renderTargetSize.x) - 1);
-            i32 clippedBottom = std::min(static_cast<i32>(std::ceil(triangle.bottomRight.y)), static_cast<i32>(renderTargetSize.y) - 1);
+            m_rowOffsets[ti] = rowCount;
 
-            if (clippedLeft > clippedRight || clippedTop > clippedBottom) {
-                continue;
+            if (triangle.left <= triangle.right && triangle.top <= triangle.bottom) {
+                rowCount += static_cast<u32>(triangle.bottom - triangle.top + 1);
             }
+        }
 
-            Vector2<i32> size = {
-                clippedRight - clippedLeft + 1,
-                clippedBottom - clippedTop + 1
-            };
+        m_rowOffsets[triangleCount] = rowCount;
 
-            triangleBuffer.resize(size.x * size.y);
+        // Empty triangles share their offset with the next one, so the last offset not past the slot is the owner
+        auto findTriangle = [this, triangleCount](i64 slot) {
+            auto owner = std::upper_bound(m_rowOffsets.begin(), m_rowOffsets.begin() + triangleCount, static_cast<u32>(slot));
+            return static_cast<i32>(owner - m_rowOffsets.begin()) - 1;
+        };
 
-            #pragma omp parallel for collapse(2) schedule(dynamic)
-            for (int y = clippedTop; y <= clippedBottom; ++y)
-            for (int x = clippedLeft; x <= clippedRight; ++x) {
-                f32 e1 = triangle.e1a * x + triangle.e1b * y + triangle.e1c;
-                f32 e2 = triangle.e2a * x + triangle.e2b * y + triangle.e2c;
-                f32 e3 = triangle.e3a * x + triangle.e3b * y + triangle.e3c;
-                
-                bool inside = (
-                    (e1 > 0 || (e1 == 0 && triangle.e1_topLeft)) &&
-                    (e2 > 0 || (e2 == 0 && triangle.e2_topLeft)) &&
-                    (e3 > 0 || (e3 == 0 && triangle.e3_topLeft))
-                );
-                
-                int index = (y - clippedTop) * size.x + (x - clippedLeft);
-
-                filters::VertexData &pixelData = triangleBuffer[index];
-
-                if (inside) {
-                    f32 w1 = e2 * triangle.inverseArea;
-                    f32 w2 = e3 * triangle.inverseArea;
-                    f32 w3 = e1 * triangle.inverseArea;
-
-                    pixelData.position = { static_cast<f32>(x), static_cast<f32>(y) };
-                    pixelData.uv = { triangle.uv1.x * w1 + triangle.uv2.x * w2 + triangle.uv3.x * w3,
-                                    triangle.uv1.y * w1 + triangle.uv2.y * w2 + triangle.uv3.y * w3 };
-                    pixelData.size = triangle.size;
-                    pixelData.inverseSize = triangle.inverseSize;
-                } else {
-                    pixelData.size = { -1.f, -1.f };
-                }
-            }
+        m_fragmentSpans.resize(rowCount);
 
-            for (const auto &pixelData : triangleBuffer) {
-                if (pixelData.size.x >= 0.f && pixelData.size.y >= 0.f) {
-                    m_fragmentInputBuffer.getBuffer().push_back(pixelData);
-                }
+        #pragma omp parallel for schedule(static)
+        for (i64 slot = 0; slot < static_cast<i64>(rowCount); ++slot) {
+            const i32 ti = findTriangle(slot);
+            const auto &triangle = triangles[ti];
+            const i32 y = triangle.top + static_cast<i32>(slot - m_rowOffsets[ti]);
+
+            Vector2<i32> rowSpan = fixedPoint ? findFixedPointSpan(triangle, y) : findFloatingPointSpan(triangle, y);
+
+            FragmentSpan &span = m_fragmentSpans[slot];
+            span.x = static_cast<u32>(std::max(rowSpan.x, 0));
+            span.y = static_cast<u32>(y);
+            span.length = rowSpan.x <= rowSpan.y ? static_cast<u32>(rowSpan.y - rowSpan.x + 1) : 0u;
+        }
+
+        m_fragmentInputBuffer.setSize(assignFragmentOffsets(m_fragmentSpans));
+
+        filters::VertexData *fragments = m_fragmentInputBuffer.getBuffer().data();
+
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (i64 slot = 0; slot < static_cast<i64>(rowCount); ++slot) {
+            const FragmentSpan &span = m_fragmentSpans[slot];
+
+            if (span.length == 0) {
+                continue;
             }
 
-            triangleBuffer.clear();
+            const auto &triangle = triangles[findTriangle(slot)];
+
+            // Span setup evaluates the uv plane once; every further pixel adds the x gradient
+            Vector2<f32> uv = triangle.uvOrigin
+                + triangle.uvDx * (static_cast<f32>(span.x) - triangle.origin.x)
+                + triangle.uvDy * (static_cast<f32>(span.y) - triangle.origin.y);
+
+            filters::VertexData pixelData;
+            pixelData.position = { static_cast<f32>(span.x), static_cast<f32>(span.y) };
+            pixelData.size = triangle.size;
+            pixelData.inverseSize = triangle.inverseSize;
+
+            filters::VertexData *output = fragments + span.firstFragment;
+
+            for (u32 i = 0; i < span.length; ++i) {
+                pixelData.uv = uv;
+                output[i] = pixelData;
+
+                pixelData.position.x += 1.f;
+                uv += triangle.uvDx;
+            }
         }
 
         m_fragmentOutputBuffer.setSize(m_fragmentInputBuffer.getSize());
 
         fragmentPipeline.run(&m_fragmentInputBuffer, &m_fragmentOutputBuffer, renderTarget.getBaseData());
 
-        for (i32 i = 0; i < m_fragmentOutputBuffer.getSize(); ++i) {
-            renderTarget.setPixelWithBlend({ static_cast<u32>(m_fragmentInputBuffer[i].position.x), static_cast<u32>(m_fragmentInputBuffer[i].position.y) }, m_fragmentOutputBuffer[i].color, blendMode);
+        const filters::VertexData *shadedFragments = m_fragmentOutputBuffer.getBuffer().data();
+
+        for (const FragmentSpan &span : m_fragmentSpans) {
+            if (span.length > 0) {
+                renderTarget.blendSpan(span.y * renderTargetSize.x + span.x, shadedFragments + span.firstFragment, span.length, blendMode);
+            }
         }
     }
 
     void Renderer::draw(RenderTarget &renderTarget, const primitives::Vertex &vertex, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode) {
-        DrawCallData drawCallData;
-        drawCallData.type = DrawCallType::Vertex;
-        drawCallData.payload = vertex;
-        drawCallData.transform = transform;
-        drawCallData.fragmentPipeline = &fragmentPipeline;
-        drawCallData.blendMode = blendMode;
-
-        renderTarget.registerDrawCall(drawCallData, depth);
+        renderTarget.registerDrawCall(DrawCallType::Vertex, vertex, transform.getAffineMatrix(), fragmentPipeline, depth, blendMode);
     }
 
     void Renderer::draw(RenderTarget &renderTarget, const primitives::Line &line, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode) {
-        DrawCallData drawCallData;
-        drawCallData.type = DrawCallType::Line;
-        drawCallData.payload = line;
-        drawCallData.transform = transform;
-        drawCallData.fragmentPipeline = &fragmentPipeline;
-        drawCallData.blendMode = blendMode;
-
-        renderTarget.registerDrawCall(drawCallData, depth);
+        renderTarget.registerDrawCall(DrawCallType::Line, line, transform.getAffineMatrix(), fragmentPipeline, depth, blendMode);
     }
 
     void Renderer::draw(RenderTarget &renderTarget, const primitives::Ellipse &ellipse, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode) {
-        DrawCallData drawCallData;
-        drawCallData.type = DrawCallType::Ellipse;
-        drawCallData.payload = ellipse;
-        drawCallData.transform = transform;
-        drawCallData.fragmentPipeline = &fragmentPipeline;
-        drawCallData.blendMode = blendMode;
-
-        renderTarget.registerDrawCall(drawCallData, depth);
+        renderTarget.registerDrawCall(DrawCallType::Ellipse, ellipse, transform.getAffineMatrix(), fragmentPipeline, depth, blendMode);
     }
 
     void Renderer::draw(RenderTarget &renderTarget, const primitives::TriangleMesh &mesh, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode) {
-        DrawCallData drawCallData;
-        drawCallData.type = DrawCallType::TriangleMesh;
-        drawCallData.payload = mesh;
-        drawCallData.transform = transform;
-        drawCallData.fragmentPipeline = &fragmentPipeline;
-        drawCallData.blendMode = blendMode;
+        renderTarget.registerDrawCall(DrawCallType::TriangleMesh, mesh, transform.getAffineMatrix(), fragmentPipeline, depth, blendMode);
+    }
+
+    void Renderer::draw(RenderTarget &renderTarget, const primitives::LineList &lines, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode) {
+        renderTarget.registerDrawCall(DrawCallType::LineList, lines, transform.getAffineMatrix(), fragmentPipeline, depth, blendMode);
+    }
+
+    void Renderer::draw(RenderTarget &renderTarget, const primitives::LineStrip &strip, const Transform &transform, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode) {
+        renderTarget.registerDrawCall(DrawCallType::LineStrip, strip, transform.getAffineMatrix(), fragmentPipeline, depth, blendMode);
+    }
+
+    void Renderer::draw(RenderTarget &renderTarget, const primitives::FragmentPass &pass, FilterPipeline<filters::VertexData, filters::VertexData> &fragmentPipeline, f32 depth, BlendMode blendMode) {
+        renderTarget.registerDrawCall(DrawCallType::FragmentPass, pass, AffineMatrix<f32>::identity(), fragmentPipeline, depth, blendMode);
+    }
 
-        renderTarget.registerDrawCall(drawCallData, depth);
+    void Renderer::beginRecording(RenderTarget &renderTarget, FragmentRecording &recording, f32 depth) {
+        renderTarget.m_drawCommands.push(DrawCallType::BeginRecording, primitives::Recording { &recording }, AffineMatrix<f32>::identity(), nullptr, depth, BlendMode::None);
+    }
+
+    void Renderer::endRecording(RenderTarget &renderTarget, FragmentRecording &recording, f32 depth) {
+        renderTarget.m_drawCommands.push(DrawCallType::EndRecording, primitives::Recording { &recording }, AffineMatrix<f32>::identity(), nullptr, depth, BlendMode::None);
+    }
+
+    void Renderer::draw(RenderTarget &renderTarget, FragmentRecording &recording, f32 depth) {
+        renderTarget.m_drawCommands.push(DrawCallType::Replay, primitives::Recording { &recording }, AffineMatrix<f32>::identity(), nullptr, depth, BlendMode::None, renderTarget.m_drawId);
     }
 
     bool Renderer::clipLineToRect(Vector2<f32>& start, Vector2<f32>& end, const Vector2<u32>& rectSize) const {
@@ -555,6 +1645,14 @@ namespace til
         }
     }
 
+    void Renderer::setRasterizationMode(RasterizationMode mode) {
+        m_rasterizationMode = mode;
+    }
+
+    RasterizationMode Renderer::getRasterizationMode() const {
+        return m_rasterizationMode;
+    }
+
     u32 Renderer::addMesh(primitives::Vertex *vertices, u32 vertexCount) {
         u32 firstVertex = static_cast<u32>(m_meshVertices.size());
         m_meshVertices.reserve(m_meshVertices.size() + vertexCount);
@@ -0,0 +1,278 @@
+#include "til.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace til
+{
+    namespace
+    {
+        // Boxes are closed, so zero-sized bounds of points and straight lines still overlap
+        bool overlaps(const Rect<f32> &a, const Rect<f32> &b) {
+            return a.position.x <= b.position.x + b.size.x && b.position.x <= a.position.x + a.size.x &&
+                   a.position.y <= b.position.y + b.size.y && b.position.y <= a.position.y + a.size.y;
+        }
+
+        bool isFinite(const Rect<f32> &rect) {
+            return std::isfinite(rect.position.x) && std::isfinite(rect.position.y) &&
+                   std::isfinite(rect.size.x) && std::isfinite(rect.size.y);
+        }
+
+        i32 cellCoordinate(f32 value, f32 inverseCellSize) {
+            const f32 cell = std::floor(value * inverseCellSize);
+            return static_cast<i32>(std::clamp(cell, -1073741824.f, 1073741824.f));
+        }
+
+        void eraseValue(std::vector<u32> &values, u32 value) {
+            auto it = std::find(values.begin(), values.end(), value);
+            if (it != values.end()) {
+                *it = values.back();
+                values.pop_back();
+            }
+        }
+    }
+
+    Scene::Scene(f32 cellSize) {
+        if (!(cellSize > 0.f)) {
+            invokeError<InvalidArgumentError>("Scene cell size must be positive");
+        }
+
+        m_cellSize = cellSize;
+        m_inverseCellSize = 1.f / cellSize;
+    }
+
+    void Scene::add(Drawable *drawable) {
+        if (!drawable) {
+            invokeError<InvalidArgumentError>("Drawable pointer cannot be null");
+        }
+
+        if (m_indices.contains(drawable)) {
+            invokeError<InvalidArgumentError>("Drawable is already in the scene");
+        }
+
+        const u32 index = static_cast<u32>(m_entries.size());
+
+        Entry entry;
+        entry.drawable = drawable;
+        entry.order = m_nextOrder++;
+        computeEntry(entry);
+
+        m_entries.push_back(entry);
+        m_indices.emplace(drawable, index);
+        link(index);
+    }
+
+    void Scene::remove(Drawable *drawable) {
+        const u32 index = findEntry(drawable);
+        const u32 last = static_cast<u32>(m_entries.size() - 1);
+
+        unlink(index);
+        m_indices.erase(drawable);
+
+        // Move the last entry into the gap; its cells must refer to the new index
+        if (index != last) {
+            unlink(last);
+            m_entries[index] = m_entries[last];
+            m_indices[m_entries[index].drawable] = index;
+            link(index);
+        }
+
+        m_entries.pop_back();
+    }
+
+    bool Scene::contains(const Drawable *drawable) const {
+        return m_indices.contains(drawable);
+    }
+
+    void Scene::clear() {
+        m_entries.clear();
+        m_indices.clear();
+        m_cells.clear();
+        m_unbucketed.clear();
+    }
+
+    u32 Scene::getDrawableCount() const {
+        return static_cast<u32>(m_entries.size());
+    }
+
+    f32 Scene::getCellSize() const {
+        return m_cellSize;
+    }
+
+    void Scene::update(Drawable *drawable) {
+        updateEntry(findEntry(drawable));
+    }
+
+    void Scene::updateAll() {
+        for (u32 i = 0; i < static_cast<u32>(m_entries.size()); ++i) {
+            updateEntry(i);
+        }
+    }
+
+    void Scene::draw(Renderer &renderer, RenderTarget &target, const Rect<f32> &view) {
+        collect(view, [](const Entry &) { return true; });
+
+        for (u32 index : m_queryIndices) {
+            m_entries[index].drawable->draw(renderer, target);
+        }
+    }
+
+    void Scene::queryRect(const Rect<f32> &region, std::vector<Drawable *> &result) const {
+        collect(region, [](const Entry &entry) { return entry.bounded; });
+
+        result.clear();
+        for (u32 index : m_queryIndices) {
+            result.push_back(m_entries[index].drawable);
+        }
+    }
+
+    void Scene::queryPoint(const Vector2<f32> &point, std::vector<Drawable *> &result) const {
+        queryRect({ point, { 0.f, 0.f } }, result);
+    }
+
+    Drawable *Scene::pick(const Vector2<f32> &point) const {
+        collect({ point, { 0.f, 0.f } }, [](const Entry &entry) { return entry.bounded; });
+        return m_queryIndices.empty() ? nullptr : m_entries[m_queryIndices.back()].drawable;
+    }
+
+    u64 Scene::cellKey(i32 x, i32 y) {
+        return (static_cast<u64>(static_cast<u32>(x)) << 32) | static_cast<u32>(y);
+    }
+
+    void Scene::computeEntry(Entry &entry) const {
+        entry.bounded = entry.drawable->getBounds(entry.bounds) && isFinite(entry.bounds);
+        entry.bucketed = false;
+
+        if (!entry.bounded) {
+            return;
+        }
+
+        const Vector2<f32> end = entry.bounds.getEnd();
+        entry.firstCell = { cellCoordinate(entry.bounds.position.x, m_inverseCellSize), cellCoordinate(entry.bounds.position.y, m_inverseCellSize) };
+        entry.lastCell = { cellCoordinate(end.x, m_inverseCellSize), cellCoordinate(end.y, m_inverseCellSize) };
+
+        // Coordinates reach +-2^30, so the spans are computed in 64 bits
+        const u64 cellCount = static_cast<u64>(static_cast<i64>(entry.lastCell.x) - entry.firstCell.x + 1) *
+                              static_cast<u64>(static_cast<i64>(entry.lastCell.y) - entry.firstCell.y + 1);
+        entry.bucketed = cellCount <= maxCellsPerDrawable;
+    }
+
+    void Scene::link(u32 index) {
+        const Entry &entry = m_entries[index];
+
+        if (!entry.bucketed) {
+            m_unbucketed.push_back(index);
+            return;
+        }
+
+        for (i32 y = entry.firstCell.y; y <= entry.lastCell.y; ++y) {
+            for (i32 x = entry.firstCell.x; x <= entry.lastCell.x; ++x) {
+                m_cells[cellKey(x, y)].push_back(index);
+            }
+        }
+    }
+
+    void Scene::unlink(u32 index) {
+        const Entry &entry = m_entries[index];
+
+        if (!entry.bucketed) {
+            eraseValue(m_unbucketed, index);
+            return;
+        }
+
+        for (i32 y = entry.firstCell.y; y <= entry.lastCell.y; ++y) {
+            for (i32 x = entry.firstCell.x; x <= entry.lastCell.x; ++x) {
+                auto it = m_cells.find(cellKey(x, y));
+                if (it == m_cells.end()) continue;
+
+                eraseValue(it->second, index);
+                if (it->second.empty()) {
+                    m_cells.erase(it);
+                }
+            }
+        }
+    }
+
+    u32 Scene::findEntry(const Drawable *drawable) const {
+        auto it = m_indices.find(drawable);
+        if (it == m_indices.end()) {
+            invokeError<InvalidArgumentError>("Drawable is not in the scene");
+        }
+        return it->second;
+    }
+
+    void Scene::updateEntry(u32 index) {
+        Entry updated = m_entries[index];
+        computeEntry(updated);
+
+        const Entry &current = m_entries[index];
+        const bool sameCells = updated.bucketed == current.bucketed &&
+                               (!updated.bucketed || (updated.firstCell == current.firstCell && updated.lastCell == current.lastCell));
+
+        if (sameCells) {
+            m_entries[index] = updated;
+            return;
+        }
+
+        unlink(index);
+        m_entries[index] = updated;
+        link(index);
+    }
+
+    template<typename Predicate>
+    void Scene::collect(const Rect<f32> &region, Predicate predicate) const {
+        m_queryIndices.clear();
+        ++m_visitStamp;
+
+        auto visit = [&](u32 index) {
+            const Entry &entry = m_entries[index];
+            if (entry.visitStamp == m_visitStamp) return;
+            entry.visitStamp = m_visitStamp;
+
+            if ((!entry.bounded || overlaps(entry.bounds, region)) && predicate(entry)) {
+                m_queryIndices.push_back(index);
+            }
+        };
+
+        bool walkOccupiedCells = true;
+        Vector2<i32> firstCell { 0, 0 };
+        Vector2<i32> lastCell { -1, -1 };
+
+        if (isFinite(region)) {
+            const Vector2<f32> end = region.getEnd();
+            firstCell = { cellCoordinate(region.position.x, m_inverseCellSize), cellCoordinate(region.position.y, m_inverseCellSize) };
+            lastCell = { cellCoordinate(end.x, m_inverseCellSize), cellCoordinate(end.y, m_inverseCellSize) };
+
+            // Regions larger than the occupied grid are cheaper to answer by walking the occupied cells
+            const u64 cellCount = static_cast<u64>(std::max<i64>(static_cast<i64>(lastCell.x) - firstCell.x + 1, 0)) *
+                                  static_cast<u64>(std::max<i64>(static_cast<i64>(lastCell.y) - firstCell.y + 1, 0));
+            walkOccupiedCells = cellCount > m_cells.size();
+        }
+
+        if (walkOccupiedCells) {
+            for (const auto &[key, indices] : m_cells) {
+                for (u32 index : indices) {
+                    visit(index);
+                }
+            }
+        } else {
+            for (i32 y = firstCell.y; y <= lastCell.y; ++y) {
+                for (i32 x = firstCell.x; x <= lastCell.x; ++x) {
+                    auto it = m_cells.find(cellKey(x, y));
+                    if (it == m_cells.end()) continue;
+
+                    for (u32 index : it->second) {
+                        visit(index);
+                    }
+                }
+            }
+        }
+
+        for (u32 index : m_unbucketed) {
+            visit(index);
+        }
+
+        std::sort(m_queryIndices.begin(), m_queryIndices.end(), [this](u32 a, u32 b) {
+            return m_entries[a].order < m_entries[b].order;
+        });
+    }
+}
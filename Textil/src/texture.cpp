@@ -36,6 +36,10 @@ namespace til
         return m_size;
     }
 
+    const std::vector<Color> &Texture::getRawData() const {
+        return m_data;
+    }
+
     void Texture::setRawData(const Vector2<u32> &size, const std::vector<Color> &data) {
         if (size.x * size.y != data.size()) {
             invokeError<InvalidArgumentError>("Size does not match data length");
@@ -0,0 +1,26 @@
+#include "til.hpp"
+
+namespace til
+{
+    TextureTarget::TextureTarget(const Vector2<u32> &size) {
+        setSize(size);
+    }
+
+    const Vector2<u32> &TextureTarget::getSize() const {
+        return getBufferSize();
+    }
+
+    void TextureTarget::setSize(const Vector2<u32> &size) {
+        setBufferSize(size);
+        fill({ 0, 0, 0, 0 });
+    }
+
+    Texture &TextureTarget::getTexture() {
+        if (m_textureVersion != getContentVersion()) {
+            m_texture.setRawData(getBufferSize(), m_pixelBuffer.getBuffer());
+            m_textureVersion = getContentVersion();
+        }
+
+        return m_texture;
+    }
+}
@@ -0,0 +1,218 @@
+#include "til.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace til
+{
+    TileMap::TileMap() {
+        m_textureSampler.data.samplingMode = Texture::SamplingMode::NearestNeighbor;
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
+    }
+
+    TileMap::TileMap(const Vector2<u32> &size, Texture *atlas, const Vector2<u32> &atlasTileSize) : TileMap() {
+        setAtlas(atlas, atlasTileSize);
+        setSize(size);
+    }
+
+    const Vector2<u32> &TileMap::getSize() const {
+        return m_size;
+    }
+
+    void TileMap::setSize(const Vector2<u32> &size) {
+        m_size = size;
+        m_tiles.assign(static_cast<std::size_t>(size.x) * size.y, 0u);
+
+        m_chunkCount = { (size.x + chunkSize - 1) / chunkSize, (size.y + chunkSize - 1) / chunkSize };
+        m_chunks.clear();
+        m_chunks.resize(static_cast<std::size_t>(m_chunkCount.x) * m_chunkCount.y);
+    }
+
+    void TileMap::setAtlas(Texture *atlas, const Vector2<u32> &atlasTileSize) {
+        if (!atlas) {
+            invokeError<InvalidArgumentError>("Atlas pointer cannot be null");
+        }
+
+        if (atlasTileSize.x == 0 || atlasTileSize.y == 0) {
+            invokeError<InvalidArgumentError>("Atlas tile size must be positive");
+        }
+
+        m_atlas = atlas;
+        m_atlasTileSize = atlasTileSize;
+        m_textureSampler.data.texture = atlas;
+        invalidateChunks();
+    }
+
+    Texture *TileMap::getAtlas() const {
+        return m_atlas;
+    }
+
+    const Vector2<u32> &TileMap::getAtlasTileSize() const {
+        return m_atlasTileSize;
+    }
+
+    u32 TileMap::getTile(const Vector2<u32> &position) const {
+        if (position.x >= m_size.x || position.y >= m_size.y) {
+            invokeError<InvalidArgumentError>("Tile position out of range");
+        }
+
+        return m_tiles[static_cast<std::size_t>(position.y) * m_size.x + position.x];
+    }
+
+    void TileMap::setTile(const Vector2<u32> &position, u32 tile) {
+        if (position.x >= m_size.x || position.y >= m_size.y) {
+            invokeError<InvalidArgumentError>("Tile position out of range");
+        }
+
+        u32 &current = m_tiles[static_cast<std::size_t>(position.y) * m_size.x + position.x];
+        if (current == tile) {
+            return;
+        }
+
+        current = tile;
+        m_chunks[(position.y / chunkSize) * m_chunkCount.x + position.x / chunkSize].dirty = true;
+    }
+
+    void TileMap::fill(u32 tile) {
+        std::fill(m_tiles.begin(), m_tiles.end(), tile);
+        invalidateChunks();
+    }
+
+    void TileMap::addFilter(BaseFilter *filter) {
+        m_fragmentPipeline.addFilter(filter).build();
+    }
+
+    void TileMap::clearFilters() {
+        m_fragmentPipeline.clearFilters();
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
+    }
+
+    bool TileMap::getLocalBounds(Rect<f32> &bounds) const {
+        bounds = { { 0.f, 0.f }, { static_cast<f32>(m_size.x) * tileSize.x, static_cast<f32>(m_size.y) * tileSize.y } };
+        return true;
+    }
+
+    void TileMap::invalidateChunks() {
+        for (Chunk &chunk : m_chunks) {
+            chunk.dirty = true;
+        }
+    }
+
+    void TileMap::rebuildChunk(const Vector2<u32> &chunkPosition) {
+        Chunk &chunk = m_chunks[chunkPosition.y * m_chunkCount.x + chunkPosition.x];
+        chunk.vertices.clear();
+        chunk.dirty = false;
+
+        const Vector2<u32> atlasSize = m_atlas->getSize();
+        const u32 columns = atlasSize.x / m_atlasTileSize.x;
+        const u32 tileCount = columns * (atlasSize.y / m_atlasTileSize.y);
+
+        const Vector2<f32> uvStep {
+            static_cast<f32>(m_atlasTileSize.x) / static_cast<f32>(atlasSize.x),
+            static_cast<f32>(m_atlasTileSize.y) / static_cast<f32>(atlasSize.y)
+        };
+
+        const u32 firstX = chunkPosition.x * chunkSize;
+        const u32 firstY = chunkPosition.y * chunkSize;
+        const u32 endX = std::min(firstX + chunkSize, m_size.x);
+        const u32 endY = std::min(firstY + chunkSize, m_size.y);
+
+        for (u32 y = firstY; y < endY; ++y) {
+            for (u32 x = firstX; x < endX; ++x) {
+                const u32 tile = m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+                if (tile == 0 || tile > tileCount) continue;
+
+                const u32 atlasIndex = tile - 1;
+                const Vector2<f32> uv0 { static_cast<f32>(atlasIndex % columns) * uvStep.x, static_cast<f32>(atlasIndex / columns) * uvStep.y };
+                const Vector2<f32> uv1 = uv0 + uvStep;
+
+                const Vector2<f32> p0 { static_cast<f32>(x) * tileSize.x, static_cast<f32>(y) * tileSize.y };
+                const Vector2<f32> p1 = p0 + tileSize;
+
+                chunk.vertices.push_back({ { p0.x, p0.y }, { uv0.x, uv0.y } });
+                chunk.vertices.push_back({ { p1.x, p0.y }, { uv1.x, uv0.y } });
+                chunk.vertices.push_back({ { p1.x, p1.y }, { uv1.x, uv1.y } });
+                chunk.vertices.push_back({ { p0.x, p0.y }, { uv0.x, uv0.y } });
+                chunk.vertices.push_back({ { p1.x, p1.y }, { uv1.x, uv1.y } });
+                chunk.vertices.push_back({ { p0.x, p1.y }, { uv0.x, uv1.y } });
+            }
+        }
+    }
+
+    void TileMap::draw(Renderer &renderer, RenderTarget &target) {
+        if (!m_atlas) {
+            invokeError<LogicError>("Cannot draw tile map without an atlas");
+            return;
+        }
+
+        const Vector2<u32> atlasSize = m_atlas->getSize();
+        if (m_size.x == 0 || m_size.y == 0 || atlasSize.x < m_atlasTileSize.x || atlasSize.y < m_atlasTileSize.y) return;
+        if (!(tileSize.x > 0.f) || !(tileSize.y > 0.f)) return;
+
+        if (atlasSize != m_builtAtlasSize || tileSize != m_builtTileSize) {
+            invalidateChunks();
+            m_builtAtlasSize = atlasSize;
+            m_builtTileSize = tileSize;
+        }
+
+        const AffineMatrix<f32> &matrix = transform.getAffineMatrix();
+        if (matrix[0][0] * matrix[1][1] - matrix[0][1] * matrix[1][0] == 0.f) return;
+
+        // Corners of the target in map coordinates give the range of tiles that can be visible
+        const AffineMatrix<f32> inverse = matrix.inverse();
+        const Vector2<f32> targetSize { static_cast<f32>(target.getBufferSize().x), static_cast<f32>(target.getBufferSize().y) };
+        const Vector2<f32> corners[4] = {
+            inverse * Vector2<f32>{ 0.f, 0.f },
+            inverse * Vector2<f32>{ targetSize.x, 0.f },
+            inverse * Vector2<f32>{ targetSize.x, targetSize.y },
+            inverse * Vector2<f32>{ 0.f, targetSize.y }
+        };
+
+        Vector2<f32> minimum = corners[0];
+        Vector2<f32> maximum = corners[0];
+        for (const Vector2<f32> &corner : corners) {
+            minimum = { std::min(minimum.x, corner.x), std::min(minimum.y, corner.y) };
+            maximum = { std::max(maximum.x, corner.x), std::max(maximum.y, corner.y) };
+        }
+
+        const f32 chunkWidth = tileSize.x * static_cast<f32>(chunkSize);
+        const f32 chunkHeight = tileSize.y * static_cast<f32>(chunkSize);
+        const f32 lastChunkX = static_cast<f32>(m_chunkCount.x) - 1.f;
+        const f32 lastChunkY = static_cast<f32>(m_chunkCount.y) - 1.f;
+
+        if (maximum.x < 0.f || maximum.y < 0.f || minimum.x > (lastChunkX + 1.f) * chunkWidth || minimum.y > (lastChunkY + 1.f) * chunkHeight) return;
+
+        const u32 firstChunkX = static_cast<u32>(std::clamp(std::floor(minimum.x / chunkWidth), 0.f, lastChunkX));
+        const u32 firstChunkY = static_cast<u32>(std::clamp(std::floor(minimum.y / chunkHeight), 0.f, lastChunkY));
+        const u32 lastVisibleX = static_cast<u32>(std::clamp(std::floor(maximum.x / chunkWidth), 0.f, lastChunkX));
+        const u32 lastVisibleY = static_cast<u32>(std::clamp(std::floor(maximum.y / chunkHeight), 0.f, lastChunkY));
+
+        u32 vertexCount = 0;
+        for (u32 cy = firstChunkY; cy <= lastVisibleY; ++cy) {
+            for (u32 cx = firstChunkX; cx <= lastVisibleX; ++cx) {
+                const Chunk &chunk = m_chunks[cy * m_chunkCount.x + cx];
+                if (chunk.dirty) {
+                    rebuildChunk({ cx, cy });
+                }
+                vertexCount += static_cast<u32>(chunk.vertices.size());
+            }
+        }
+
+        if (vertexCount == 0) return;
+
+        // All visible chunks go out as one mesh, so the map costs a single draw call
+        auto alloc = renderer.allocateMesh(vertexCount);
+        auto out = alloc.vertices.begin();
+        for (u32 cy = firstChunkY; cy <= lastVisibleY; ++cy) {
+            for (u32 cx = firstChunkX; cx <= lastVisibleX; ++cx) {
+                const Chunk &chunk = m_chunks[cy * m_chunkCount.x + cx];
+                out = std::copy(chunk.vertices.begin(), chunk.vertices.end(), out);
+            }
+        }
+
+        primitives::TriangleMesh mesh;
+        mesh.firstVertex = alloc.firstVertex;
+        mesh.vertexCount = vertexCount;
+
+        renderer.draw(target, mesh, transform, m_fragmentPipeline);
+    }
+}
@@ -1,5 +1,6 @@
 #include "til.hpp"
 #include <cmath>
+#include <algorithm>
 
 namespace til
 {
@@ -18,13 +19,129 @@ namespace til
         m_rotation(rotation),
         m_origin(origin) {}
 
+    Transform::Transform(const Transform& other)
+        : m_position(other.m_position),
+        m_scale   (other.m_scale),
+        m_rotation(other.m_rotation),
+        m_origin  (other.m_origin) {
+        setParent(other.m_parent);
+    }
+
+    Transform::Transform(Transform&& other) noexcept
+        : m_position(other.m_position),
+        m_scale   (other.m_scale),
+        m_rotation(other.m_rotation),
+        m_origin  (other.m_origin) {
+        adoptLinks(other);
+    }
+
+    Transform& Transform::operator=(const Transform& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        m_position = other.m_position;
+        m_scale = other.m_scale;
+        m_rotation = other.m_rotation;
+        m_origin = other.m_origin;
+
+        setParent(other.m_parent);
+        invalidateLocal();
+
+        return *this;
+    }
+
+    Transform& Transform::operator=(Transform&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        detachFromParent();
+        for (Transform* child : m_children) {
+            child->m_parent = nullptr;
+            child->invalidateWorld();
+        }
+        m_children.clear();
+
+        m_position = other.m_position;
+        m_scale = other.m_scale;
+        m_rotation = other.m_rotation;
+        m_origin = other.m_origin;
+
+        adoptLinks(other);
+        invalidateLocal();
+
+        return *this;
+    }
+
+    Transform::~Transform() {
+        detachFromParent();
+        for (Transform* child : m_children) {
+            child->m_parent = nullptr;
+            child->invalidateWorld();
+        }
+    }
+
     Matrix3<f32> Transform::getMatrix() const {
-        Matrix3<f32> translation = Matrix3<f32>::translate(m_position);
-        Matrix3<f32> rotation = Matrix3<f32>::rotate(m_rotation);
-        Matrix3<f32> scale = Matrix3<f32>::scale(m_scale);
-        Matrix3<f32> inverseOrigin = Matrix3<f32>::translate({-m_origin.x, -m_origin.y});
+        return getAffineMatrix().toMatrix3();
+    }
+
+    const AffineMatrix<f32>& Transform::getAffineMatrix() const {
+        if (m_worldDirty) {
+            m_worldMatrix = m_parent ? m_parent->getAffineMatrix() * getLocalAffineMatrix() : getLocalAffineMatrix();
+            m_worldDirty = false;
+        }
+
+        return m_worldMatrix;
+    }
+
+    const AffineMatrix<f32>& Transform::getLocalAffineMatrix() const {
+        if (m_localDirty) {
+            f32 c = std::cos(m_rotation);
+            f32 s = std::sin(m_rotation);
 
-        return translation * rotation * scale * inverseOrigin;
+            f32 a = c * m_scale.x;
+            f32 b = -s * m_scale.y;
+            f32 d = s * m_scale.x;
+            f32 e = c * m_scale.y;
+
+            m_localMatrix = AffineMatrix<f32>(
+                a, b, m_position.x - (a * m_origin.x + b * m_origin.y),
+                d, e, m_position.y - (d * m_origin.x + e * m_origin.y)
+            );
+            m_localDirty = false;
+        }
+
+        return m_localMatrix;
+    }
+
+    void Transform::setParent(Transform* parent) {
+        if (parent == m_parent) {
+            return;
+        }
+
+        for (Transform* ancestor = parent; ancestor; ancestor = ancestor->m_parent) {
+            if (ancestor == this) {
+                invokeError<InvalidArgumentError>("Transform cannot be parented to itself or one of its descendants");
+            }
+        }
+
+        detachFromParent();
+
+        m_parent = parent;
+        if (m_parent) {
+            m_parent->m_children.push_back(this);
+        }
+
+        invalidateWorld();
+    }
+
+    Transform* Transform::getParent() const {
+        return m_parent;
+    }
+
+    const std::vector<Transform*>& Transform::getChildren() const {
+        return m_children;
     }
 
     Vector2<f32> Transform::getPosition() const {
@@ -45,27 +162,77 @@ namespace til
 
     void Transform::setPosition(const Vector2<f32>& position) {
         m_position = position;
+        invalidateLocal();
     }
 
     void Transform::setScale(const Vector2<f32>& scale) {
         m_scale = scale;
+        invalidateLocal();
     }
 
     void Transform::setRotation(f32 rotation) {
         m_rotation = degreesToRadians(rotation);
+        invalidateLocal();
     }
 
     void Transform::setOrigin(const Vector2<f32>& origin) {
         m_origin = origin;
+        invalidateLocal();
     }
 
     void Transform::rotate(f32 degrees) {
         m_rotation += degreesToRadians(degrees);
+        invalidateLocal();
     }
 
     void Transform::move(const Vector2<f32>& delta) {
         m_position.x += delta.x;
         m_position.y += delta.y;
+        invalidateLocal();
+    }
+
+    void Transform::invalidateLocal() {
+        m_localDirty = true;
+        invalidateWorld();
+    }
+
+    void Transform::invalidateWorld() {
+        if (m_worldDirty) {
+            return;
+        }
+
+        m_worldDirty = true;
+        for (Transform* child : m_children) {
+            child->invalidateWorld();
+        }
+    }
+
+    void Transform::detachFromParent() {
+        if (!m_parent) {
+            return;
+        }
+
+        auto &siblings = m_parent->m_children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+        m_parent = nullptr;
+    }
+
+    void Transform::adoptLinks(Transform& other) {
+        m_parent = other.m_parent;
+        if (m_parent) {
+            std::replace(m_parent->m_children.begin(), m_parent->m_children.end(), &other, this);
+        }
+        other.m_parent = nullptr;
+
+        m_children = std::move(other.m_children);
+        other.m_children.clear();
+        for (Transform* child : m_children) {
+            child->m_parent = this;
+        }
+
+        m_worldDirty = false;
+        invalidateLocal();
+        other.invalidateWorld();
     }
 
     float Transform::degreesToRadians(float degrees) {
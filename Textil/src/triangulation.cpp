@@ -0,0 +1,558 @@
+#include "til.hpp"
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace til
+{
+    namespace
+    {
+        enum class VertexType : u8
+        {
+            Start,
+            End,
+            Split,
+            Merge,
+            Regular
+        };
+
+        struct SweepVertex
+        {
+            Vector2<f64> position;  // y axis points up, so counter-clockwise outlines have positive area
+            u32 previous;
+            u32 next;
+            u32 source;             // index into the concatenated input points
+        };
+
+        f64 cross(const Vector2<f64> &a, const Vector2<f64> &b) {
+            return a.x * b.y - a.y * b.x;
+        }
+
+        // Sweep order: top to bottom, left to right among points at the same height
+        bool isAbove(const Vector2<f64> &a, const Vector2<f64> &b) {
+            return a.y > b.y || (a.y == b.y && a.x < b.x);
+        }
+
+        // Orders the edges crossing the sweep line from left to right. An edge is identified by
+        // the index of its upper vertex; the edges kept in the sweep status always run downwards.
+        struct EdgeOrder
+        {
+            using is_transparent = void;
+
+            const std::vector<SweepVertex> *vertices;
+            const Vector2<f64> *sweep;
+
+            f64 xAtSweep(u32 edge) const {
+                const Vector2<f64> &top = (*vertices)[edge].position;
+                const Vector2<f64> &bottom = (*vertices)[(*vertices)[edge].next].position;
+
+                // Horizontal edges are only in the status while the sweep moves along them
+                if (top.y == bottom.y) return std::clamp(sweep->x, top.x, bottom.x);
+                if (sweep->y == top.y) return top.x;
+                if (sweep->y == bottom.y) return bottom.x;
+
+                return top.x + (sweep->y - top.y) * (bottom.x - top.x) / (bottom.y - top.y);
+            }
+
+            bool operator()(u32 a, u32 b) const {
+                if (a == b) return false;
+
+                const f64 xa = xAtSweep(a);
+                const f64 xb = xAtSweep(b);
+                if (xa != xb) return xa < xb;
+
+                // Edges meeting at the sweep point are ordered by the direction they leave in
+                const Vector2<f64> directionA = (*vertices)[(*vertices)[a].next].position - (*vertices)[a].position;
+                const Vector2<f64> directionB = (*vertices)[(*vertices)[b].next].position - (*vertices)[b].position;
+                const f64 turn = cross(directionB, directionA);
+                return turn != 0.0 ? turn < 0.0 : a < b;
+            }
+
+            bool operator()(u32 edge, const Vector2<f64> &point) const {
+                return xAtSweep(edge) < point.x;
+            }
+
+            bool operator()(const Vector2<f64> &point, u32 edge) const {
+                return point.x < xAtSweep(edge);
+            }
+        };
+
+        class Triangulator
+        {
+        public:
+
+            void addRing(const std::vector<Vector2<f32>> &points, u32 sourceOffset, bool outline) {
+                std::vector<u32> ring;
+                ring.reserve(points.size());
+
+                for (u32 i = 0; i < points.size(); ++i) {
+                    if (ring.empty() || points[ring.back()] != points[i]) {
+                        ring.push_back(i);
+                    }
+                }
+
+                while (ring.size() > 1 && points[ring.front()] == points[ring.back()]) {
+                    ring.pop_back();
+                }
+
+                if (ring.size() < 3) {
+                    return;
+                }
+
+                auto flipped = [&](u32 i) {
+                    return Vector2<f64>{ static_cast<f64>(points[i].x), -static_cast<f64>(points[i].y) };
+                };
+
+                f64 area = 0.0;
+                for (std::size_t i = 0; i < ring.size(); ++i) {
+                    area += cross(flipped(ring[i]), flipped(ring[(i + 1) % ring.size()]));
+                }
+                area *= 0.5;
+
+                if (area == 0.0) {
+                    return;
+                }
+
+                // Outlines run counter-clockwise and holes clockwise, so the interior is always on the left
+                if (outline ? area < 0.0 : area > 0.0) {
+                    std::reverse(ring.begin(), ring.end());
+                }
+
+                m_area += outline ? std::abs(area) : -std::abs(area);
+
+                const u32 base = static_cast<u32>(m_vertices.size());
+                const u32 count = static_cast<u32>(ring.size());
+
+                for (u32 i = 0; i < count; ++i) {
+                    m_vertices.push_back({
+                        flipped(ring[i]),
+                        base + (i + count - 1) % count,
+                        base + (i + 1) % count,
+                        sourceOffset + ring[i]
+                    });
+                }
+            }
+
+            bool run(std::vector<u32> &indices) {
+                if (m_vertices.empty()) {
+                    return true;
+                }
+
+                separateTouchingVertices();
+
+                bool complete = partition();
+
+                std::vector<std::vector<u32>> faces;
+                complete = buildFaces(faces) && complete;
+
+                m_coveredArea = 0.0;
+                for (const auto &face : faces) {
+                    complete = triangulateMonotone(face, indices) && complete;
+                }
+
+                // Anything the steps above missed shows up as uncovered area
+                return complete && std::abs(m_coveredArea - m_area) <= 1e-6 * std::abs(m_area) + 1e-9;
+            }
+
+        private:
+
+            // Outlines may touch themselves or each other at shared vertices, which the sweep cannot
+            // order. At each shared point the boundary is relinked so that every vertex bounds a single
+            // interior sector, and each vertex is then moved a tiny step into its sector, turning the
+            // touch into a narrow gap. Only the sweep sees the moved positions; the emitted indices
+            // still refer to the original points.
+            void separateTouchingVertices() {
+                const u32 count = static_cast<u32>(m_vertices.size());
+
+                std::vector<u32> order(count);
+                for (u32 i = 0; i < count; ++i) order[i] = i;
+                std::sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+                    return isAbove(m_vertices[a].position, m_vertices[b].position);
+                });
+
+                Vector2<f64> minimum = m_vertices[0].position, maximum = m_vertices[0].position;
+                for (const auto &vertex : m_vertices) {
+                    minimum = { std::min(minimum.x, vertex.position.x), std::min(minimum.y, vertex.position.y) };
+                    maximum = { std::max(maximum.x, vertex.position.x), std::max(maximum.y, vertex.position.y) };
+                }
+
+                // Far below the spacing of distinct f32 input coordinates
+                const f64 step = 1e-9 * std::max(maximum.x - minimum.x, maximum.y - minimum.y);
+
+                struct Ray
+                {
+                    f64 angle;
+                    bool outgoing;
+                    u32 vertex;
+                    u32 neighbour;
+
+                    bool operator<(const Ray &other) const {
+                        return angle < other.angle || (angle == other.angle && outgoing < other.outgoing);
+                    }
+                };
+
+                std::vector<Ray> rays;
+                std::vector<std::pair<u32, u32>> links;  // vertex, new previous vertex
+
+                for (u32 first = 0; first < count;) {
+                    u32 last = first + 1;
+                    while (last < count && m_vertices[order[last]].position == m_vertices[order[first]].position) {
+                        ++last;
+                    }
+
+                    if (last - first < 2) {
+                        first = last;
+                        continue;
+                    }
+
+                    const Vector2<f64> shared = m_vertices[order[first]].position;
+
+                    auto angleTo = [&](u32 vertex) {
+                        const Vector2<f64> direction = m_vertices[vertex].position - shared;
+                        return std::atan2(direction.y, direction.x);
+                    };
+
+                    rays.clear();
+                    for (u32 i = first; i < last; ++i) {
+                        const SweepVertex &vertex = m_vertices[order[i]];
+                        rays.push_back({ angleTo(vertex.next), true, order[i], vertex.next });
+                        rays.push_back({ angleTo(vertex.previous), false, order[i], vertex.previous });
+                    }
+                    std::sort(rays.begin(), rays.end());
+
+                    // The interior sector of an outgoing edge ends at the next edge counter-clockwise,
+                    // which comes into the shared point from another vertex in a valid outline
+                    links.clear();
+                    for (std::size_t i = 0; i < rays.size(); ++i) {
+                        const Ray &following = rays[(i + 1) % rays.size()];
+                        if (rays[i].outgoing && !following.outgoing) {
+                            links.push_back({ rays[i].vertex, following.neighbour });
+                        }
+                    }
+
+                    for (const auto &link : links) {
+                        m_vertices[link.first].previous = link.second;
+                        m_vertices[link.second].next = link.first;
+                    }
+
+                    for (u32 i = first; i < last; ++i) {
+                        SweepVertex &vertex = m_vertices[order[i]];
+                        const f64 outgoing = angleTo(vertex.next);
+                        f64 incoming = angleTo(vertex.previous);
+                        if (incoming <= outgoing) incoming += 6.283185307179586;
+
+                        const f64 bisector = 0.5 * (outgoing + incoming);
+                        vertex.position = shared + Vector2<f64>{ std::cos(bisector), std::sin(bisector) } * step;
+                    }
+
+                    first = last;
+                }
+            }
+
+            // Sweep-line partition into y-monotone pieces, recorded as diagonals
+            bool partition() {
+                const u32 count = static_cast<u32>(m_vertices.size());
+
+                std::vector<VertexType> types(count);
+                for (u32 i = 0; i < count; ++i) {
+                    const Vector2<f64> &previous = m_vertices[m_vertices[i].previous].position;
+                    const Vector2<f64> &current = m_vertices[i].position;
+                    const Vector2<f64> &next = m_vertices[m_vertices[i].next].position;
+
+                    const bool previousBelow = isAbove(current, previous);
+                    const bool nextBelow = isAbove(current, next);
+                    const bool convex = cross(current - previous, next - current) > 0.0;
+
+                    if (previousBelow && nextBelow) {
+                        types[i] = convex ? VertexType::Start : VertexType::Split;
+                    } else if (!previousBelow && !nextBelow) {
+                        types[i] = convex ? VertexType::End : VertexType::Merge;
+                    } else {
+                        types[i] = VertexType::Regular;
+                    }
+                }
+
+                std::vector<u32> order(count);
+                for (u32 i = 0; i < count; ++i) order[i] = i;
+                std::sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+                    return isAbove(m_vertices[a].position, m_vertices[b].position);
+                });
+
+                Vector2<f64> sweep;
+                std::set<u32, EdgeOrder> status(EdgeOrder{ &m_vertices, &sweep });
+                std::vector<std::set<u32, EdgeOrder>::iterator> edges(count, status.end());
+                std::vector<u32> helpers(count, 0);
+
+                auto insertEdge = [&](u32 vertex) {
+                    edges[vertex] = status.insert(vertex).first;
+                    helpers[vertex] = vertex;
+                };
+
+                auto removeEdge = [&](u32 edge) {
+                    status.erase(edges[edge]);
+                    edges[edge] = status.end();
+                };
+
+                auto findLeftEdge = [&](u32 vertex, u32 &edge) {
+                    auto it = status.lower_bound(m_vertices[vertex].position);
+                    if (it == status.begin()) return false;
+                    edge = *std::prev(it);
+                    return true;
+                };
+
+                auto connectToMergeHelper = [&](u32 vertex, u32 edge) {
+                    if (types[helpers[edge]] == VertexType::Merge) {
+                        m_diagonals.push_back({ vertex, helpers[edge] });
+                    }
+                };
+
+                for (u32 vertex : order) {
+                    sweep = m_vertices[vertex].position;
+
+                    const u32 previousEdge = m_vertices[vertex].previous;
+                    u32 leftEdge = 0;
+
+                    switch (types[vertex]) {
+                        case VertexType::Start:
+                            insertEdge(vertex);
+                            break;
+
+                        case VertexType::End:
+                            if (edges[previousEdge] == status.end()) return false;
+                            connectToMergeHelper(vertex, previousEdge);
+                            removeEdge(previousEdge);
+                            break;
+
+                        case VertexType::Split:
+                            if (!findLeftEdge(vertex, leftEdge)) return false;
+                            m_diagonals.push_back({ vertex, helpers[leftEdge] });
+                            helpers[leftEdge] = vertex;
+                            insertEdge(vertex);
+                            break;
+
+                        case VertexType::Merge:
+                            if (edges[previousEdge] == status.end()) return false;
+                            connectToMergeHelper(vertex, previousEdge);
+                            removeEdge(previousEdge);
+                            if (!findLeftEdge(vertex, leftEdge)) return false;
+                            connectToMergeHelper(vertex, leftEdge);
+                            helpers[leftEdge] = vertex;
+                            break;
+
+                        case VertexType::Regular:
+                            // The interior lies to the right when the boundary runs downwards here
+                            if (isAbove(m_vertices[previousEdge].position, m_vertices[vertex].position)) {
+                                if (edges[previousEdge] == status.end()) return false;
+                                connectToMergeHelper(vertex, previousEdge);
+                                removeEdge(previousEdge);
+                                insertEdge(vertex);
+                            } else {
+                                if (!findLeftEdge(vertex, leftEdge)) return false;
+                                connectToMergeHelper(vertex, leftEdge);
+                                helpers[leftEdge] = vertex;
+                            }
+                            break;
+                    }
+                }
+
+                return true;
+            }
+
+            // Walks the boundary edges and diagonals to collect the vertex cycles of the monotone pieces
+            bool buildFaces(std::vector<std::vector<u32>> &faces) {
+                const u32 count = static_cast<u32>(m_vertices.size());
+
+                std::vector<u32> from, to;
+                std::vector<bool> interior;
+                from.reserve(2 * (count + m_diagonals.size()));
+                to.reserve(from.capacity());
+                interior.reserve(from.capacity());
+
+                // Half-edges come in twin pairs at indices 2k and 2k + 1
+                auto addEdge = [&](u32 a, u32 b, bool interiorOnBothSides) {
+                    from.push_back(a); to.push_back(b); interior.push_back(true);
+                    from.push_back(b); to.push_back(a); interior.push_back(interiorOnBothSides);
+                };
+
+                for (u32 i = 0; i < count; ++i) {
+                    addEdge(i, m_vertices[i].next, false);
+                }
+
+                for (const auto &diagonal : m_diagonals) {
+                    addEdge(diagonal.first, diagonal.second, true);
+                }
+
+                const u32 halfEdgeCount = static_cast<u32>(from.size());
+
+                std::vector<std::vector<u32>> outgoing(count);
+                for (u32 h = 0; h < halfEdgeCount; ++h) {
+                    outgoing[from[h]].push_back(h);
+                }
+
+                std::vector<u32> slot(halfEdgeCount);
+                for (auto &edgesOut : outgoing) {
+                    std::sort(edgesOut.begin(), edgesOut.end(), [&](u32 a, u32 b) {
+                        const Vector2<f64> da = m_vertices[to[a]].position - m_vertices[from[a]].position;
+                        const Vector2<f64> db = m_vertices[to[b]].position - m_vertices[from[b]].position;
+                        return std::atan2(da.y, da.x) < std::atan2(db.y, db.x);
+                    });
+
+                    for (u32 i = 0; i < edgesOut.size(); ++i) {
+                        slot[edgesOut[i]] = i;
+                    }
+                }
+
+                std::vector<bool> visited(halfEdgeCount, false);
+                bool complete = true;
+
+                for (u32 first = 0; first < halfEdgeCount; ++first) {
+                    if (!interior[first] || visited[first]) {
+                        continue;
+                    }
+
+                    std::vector<u32> face;
+                    u32 edge = first;
+
+                    // Keep the face on the left: leave each vertex by the edge clockwise next to the one we came in on
+                    do {
+                        visited[edge] = true;
+                        face.push_back(from[edge]);
+
+                        const std::vector<u32> &around = outgoing[to[edge]];
+                        const u32 twin = edge ^ 1u;
+                        edge = around[(slot[twin] + around.size() - 1) % around.size()];
+                    } while (edge != first && interior[edge] && !visited[edge] && face.size() <= halfEdgeCount);
+
+                    if (edge != first) {
+                        complete = false;
+                        continue;
+                    }
+
+                    faces.push_back(std::move(face));
+                }
+
+                return complete;
+            }
+
+            void emitTriangle(u32 a, u32 b, u32 c, std::vector<u32> &indices) {
+                f64 area2 = cross(m_vertices[b].position - m_vertices[a].position, m_vertices[c].position - m_vertices[a].position);
+
+                if (area2 == 0.0) {
+                    return;
+                }
+
+                // Clockwise here is counter-clockwise on screen, where y points down
+                if (area2 > 0.0) {
+                    std::swap(b, c);
+                }
+
+                indices.push_back(m_vertices[a].source);
+                indices.push_back(m_vertices[b].source);
+                indices.push_back(m_vertices[c].source);
+
+                m_coveredArea += std::abs(area2) * 0.5;
+            }
+
+            // Linear-time triangulation of a y-monotone piece with the usual stack algorithm
+            bool triangulateMonotone(const std::vector<u32> &face, std::vector<u32> &indices) {
+                const u32 count = static_cast<u32>(face.size());
+
+                if (count < 3) {
+                    return false;
+                }
+
+                if (count == 3) {
+                    emitTriangle(face[0], face[1], face[2], indices);
+                    return true;
+                }
+
+                auto position = [&](u32 slot) -> const Vector2<f64> & {
+                    return m_vertices[face[slot]].position;
+                };
+
+                u32 top = 0, bottom = 0;
+                for (u32 i = 1; i < count; ++i) {
+                    if (isAbove(position(i), position(top))) top = i;
+                    if (isAbove(position(bottom), position(i))) bottom = i;
+                }
+
+                // Counter-clockwise from the top vertex runs down the left chain
+                std::vector<bool> leftChain(count, false);
+                for (u32 i = top; i != bottom; i = (i + 1) % count) {
+                    leftChain[i] = true;
+                }
+
+                std::vector<u32> order(count);
+                for (u32 i = 0; i < count; ++i) order[i] = i;
+                std::sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+                    return isAbove(position(a), position(b));
+                });
+
+                std::vector<u32> stack { order[0], order[1] };
+
+                for (u32 j = 2; j + 1 < count; ++j) {
+                    const u32 current = order[j];
+
+                    if (leftChain[current] != leftChain[stack.back()]) {
+                        while (stack.size() > 1) {
+                            const u32 last = stack.back();
+                            stack.pop_back();
+                            emitTriangle(face[current], face[last], face[stack.back()], indices);
+                        }
+
+                        stack.clear();
+                        stack.push_back(order[j - 1]);
+                        stack.push_back(current);
+                    } else {
+                        u32 last = stack.back();
+                        stack.pop_back();
+
+                        while (!stack.empty()) {
+                            const f64 side = cross(position(current) - position(stack.back()), position(last) - position(stack.back()));
+
+                            if (leftChain[current] ? side >= 0.0 : side <= 0.0) {
+                                break;
+                            }
+
+                            emitTriangle(face[current], face[last], face[stack.back()], indices);
+                            last = stack.back();
+                            stack.pop_back();
+                        }
+
+                        stack.push_back(last);
+                        stack.push_back(current);
+                    }
+                }
+
+                const u32 lowest = order[count - 1];
+                while (stack.size() > 1) {
+                    const u32 last = stack.back();
+                    stack.pop_back();
+                    emitTriangle(face[lowest], face[last], face[stack.back()], indices);
+                }
+
+                return true;
+            }
+
+            std::vector<SweepVertex> m_vertices;
+            std::vector<std::pair<u32, u32>> m_diagonals;
+            f64 m_area = 0.0;
+            f64 m_coveredArea = 0.0;
+        };
+    }
+
+    bool triangulatePolygon(const std::vector<Vector2<f32>> &outline, const std::vector<std::vector<Vector2<f32>>> &holes, std::vector<u32> &indices) {
+        indices.clear();
+
+        Triangulator triangulator;
+        triangulator.addRing(outline, 0, true);
+
+        u32 offset = static_cast<u32>(outline.size());
+        for (const auto &hole : holes) {
+            triangulator.addRing(hole, offset, false);
+            offset += static_cast<u32>(hole.size());
+        }
+
+        return triangulator.run(indices);
+    }
+}
@@ -0,0 +1,455 @@
+#include "til.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <sstream>
+
+namespace til
+{
+    namespace
+    {
+        // Whole-token parse; stoul/stof would throw on malformed headers
+        template<typename T>
+        bool parseNumber(const std::string &text, T &value) {
+            const char *end = text.data() + text.size();
+            auto [pointer, error] = std::from_chars(text.data(), end, value);
+            return error == std::errc() && pointer == end;
+        }
+
+        u8 clampChannel(i32 value) {
+            return static_cast<u8>(std::clamp(value, 0, 255));
+        }
+
+        // BT.601 limited range, the usual encoding of y4m content
+        Color yuvToColor(i32 y, i32 u, i32 v) {
+            const i32 c = 298 * (y - 16) + 128;
+            const i32 d = u - 128;
+            const i32 e = v - 128;
+
+            return {
+                clampChannel((c + 409 * e) >> 8),
+                clampChannel((c - 100 * d - 208 * e) >> 8),
+                clampChannel((c + 516 * d) >> 8),
+                255
+            };
+        }
+    }
+
+    VideoSprite::VideoSprite() {
+        m_textureSampler.data.samplingMode = Texture::SamplingMode::NearestNeighbor;
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
+    }
+
+    VideoSprite::~VideoSprite() {
+        close();
+    }
+
+    void VideoSprite::open(const std::string &filepath) {
+        close();
+
+        m_file.open(filepath, std::ios::binary);
+        if (!m_file) {
+            invokeError<InvalidArgumentError>("Failed to open video file: " + filepath);
+            return;
+        }
+
+        std::string header;
+        if (!std::getline(m_file, header) || header.rfind("YUV4MPEG2", 0) != 0) {
+            m_file.close();
+            invokeError<InvalidArgumentError>("Not a YUV4MPEG2 file: " + filepath);
+            return;
+        }
+
+        Vector2<u32> frameSize { 0u, 0u };
+        f32 framesPerSecond = 25.f;
+        Format format = Format::Yuv420;
+
+        std::istringstream tokens(header.substr(9));
+        std::string token;
+        while (tokens >> token) {
+            const char tag = token[0];
+            const std::string value = token.substr(1);
+
+            bool valid = true;
+
+            if (tag == 'W') {
+                valid = parseNumber(value, frameSize.x);
+            } else if (tag == 'H') {
+                valid = parseNumber(value, frameSize.y);
+            } else if (tag == 'F') {
+                const std::size_t colon = value.find(':');
+                f32 numerator = 0.f;
+                f32 denominator = 1.f;
+                valid = parseNumber(value.substr(0, colon), numerator) &&
+                        (colon == std::string::npos || parseNumber(value.substr(colon + 1), denominator));
+                if (valid && numerator > 0.f && denominator > 0.f) {
+                    framesPerSecond = numerator / denominator;
+                }
+            } else if (tag == 'C') {
+                if (value.rfind("420", 0) == 0) {
+                    format = Format::Yuv420;
+                } else if (value.rfind("422", 0) == 0) {
+                    format = Format::Yuv422;
+                } else if (value.rfind("444", 0) == 0 && value.find("alpha") == std::string::npos) {
+                    format = Format::Yuv444;
+                } else if (value.rfind("mono", 0) == 0 && value != "mono16") {
+                    format = Format::Mono;
+                } else {
+                    m_file.close();
+                    invokeError<InvalidArgumentError>("Unsupported YUV4MPEG2 colorspace: " + value);
+                    return;
+                }
+            }
+
+            if (!valid) {
+                m_file.close();
+                invokeError<InvalidArgumentError>("Malformed YUV4MPEG2 header field: " + token);
+                return;
+            }
+        }
+
+        if (frameSize.x == 0 || frameSize.y == 0) {
+            m_file.close();
+            invokeError<InvalidArgumentError>("YUV4MPEG2 header has no frame size: " + filepath);
+            return;
+        }
+
+        m_format = format;
+        m_frameSize = frameSize;
+        m_framesPerSecond = framesPerSecond;
+        m_firstFrame = m_file.tellg();
+        start();
+    }
+
+    void VideoSprite::openRaw(const std::string &filepath, const Vector2<u32> &frameSize, f32 framesPerSecond) {
+        close();
+
+        if (frameSize.x == 0 || frameSize.y == 0 || !(framesPerSecond > 0.f)) {
+            invokeError<InvalidArgumentError>("Raw video frame size and frame rate must be positive");
+            return;
+        }
+
+        m_file.open(filepath, std::ios::binary);
+        if (!m_file) {
+            invokeError<InvalidArgumentError>("Failed to open video file: " + filepath);
+            return;
+        }
+
+        m_format = Format::Rgba;
+        m_frameSize = frameSize;
+        m_framesPerSecond = framesPerSecond;
+        m_firstFrame = m_file.tellg();
+        start();
+    }
+
+    void VideoSprite::close() {
+        if (m_decoder.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+            m_decoder.join();
+        }
+
+        if (m_file.is_open()) {
+            m_file.close();
+        }
+        m_file.clear();
+
+        m_open = false;
+        m_stop = false;
+        m_endOfStream = false;
+        m_ready.clear();
+        m_free.clear();
+        m_presented = -1;
+        m_targetFrame = 0;
+        m_droppedFrames = 0;
+        m_playbackTime = 0.0;
+        m_currentFrame = 0;
+        m_playing = false;
+        m_finished = false;
+        m_textureSampler.data.texture = nullptr;
+    }
+
+    bool VideoSprite::isOpen() const {
+        return m_open;
+    }
+
+    void VideoSprite::play() {
+        if (m_open && !m_finished) {
+            m_playing = true;
+        }
+    }
+
+    void VideoSprite::pause() {
+        m_playing = false;
+    }
+
+    void VideoSprite::setLooping(bool looping) {
+        m_loop = looping;
+    }
+
+    bool VideoSprite::isLooping() const {
+        return m_loop;
+    }
+
+    bool VideoSprite::isPlaying() const {
+        return m_playing;
+    }
+
+    bool VideoSprite::isFinished() const {
+        return m_finished;
+    }
+
+    void VideoSprite::update(f32 deltaTime) {
+        if (!m_open) return;
+
+        if (m_playing) {
+            m_playbackTime += deltaTime;
+        }
+
+        const u64 target = static_cast<u64>(m_playbackTime * m_framesPerSecond);
+        m_targetFrame = target;
+
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Take the newest due frame; older due frames were overtaken by the clock
+            i32 pick = -1;
+            while (!m_ready.empty() && m_slots[m_ready.front()].frame <= target) {
+                if (pick >= 0) {
+                    m_free.push_back(static_cast<u32>(pick));
+                    ++m_droppedFrames;
+                }
+                pick = static_cast<i32>(m_ready.front());
+                m_ready.pop_front();
+            }
+
+            if (pick >= 0) {
+                if (m_presented >= 0) {
+                    m_free.push_back(static_cast<u32>(m_presented));
+                }
+                m_presented = pick;
+                m_currentFrame = m_slots[pick].frame;
+                m_textureSampler.data.texture = &m_slots[pick].texture;
+                notify = true;
+            }
+
+            // Also reached when every frame was skipped before one could be presented
+            if (m_endOfStream && m_ready.empty()) {
+                m_finished = true;
+                m_playing = false;
+            }
+        }
+
+        if (notify) {
+            m_condition.notify_one();
+        }
+    }
+
+    const Vector2<u32> &VideoSprite::getFrameSize() const {
+        return m_frameSize;
+    }
+
+    f32 VideoSprite::getFrameRate() const {
+        return m_framesPerSecond;
+    }
+
+    u64 VideoSprite::getCurrentFrame() const {
+        return m_currentFrame;
+    }
+
+    u64 VideoSprite::getDroppedFrameCount() const {
+        return m_droppedFrames;
+    }
+
+    const Texture *VideoSprite::getTexture() const {
+        return m_presented >= 0 ? &m_slots[m_presented].texture : nullptr;
+    }
+
+    void VideoSprite::addFilter(BaseFilter *filter) {
+        m_fragmentPipeline.addFilter(filter).build();
+    }
+
+    void VideoSprite::clearFilters() {
+        m_fragmentPipeline.clearFilters();
+        m_fragmentPipeline.addFilter(&m_textureSampler).build();
+    }
+
+    void VideoSprite::draw(Renderer &renderer, RenderTarget &target) {
+        if (m_presented < 0) return;
+
+        auto alloc = renderer.allocateMesh(6);
+        auto &v = alloc.vertices;
+        v[0] = { { 0.f,     0.f      }, { 0.f, 0.f } };
+        v[1] = { { size.x,  0.f      }, { 1.f, 0.f } };
+        v[2] = { { size.x,  size.y   }, { 1.f, 1.f } };
+        v[3] = { { 0.f,     0.f      }, { 0.f, 0.f } };
+        v[4] = { { size.x,  size.y   }, { 1.f, 1.f } };
+        v[5] = { { 0.f,     size.y   }, { 0.f, 1.f } };
+
+        primitives::TriangleMesh mesh;
+        mesh.firstVertex = alloc.firstVertex;
+        mesh.vertexCount = 6;
+
+        renderer.draw(target, mesh, transform, m_fragmentPipeline);
+    }
+
+    bool VideoSprite::getLocalBounds(Rect<f32> &bounds) const {
+        bounds = { { std::min(0.f, size.x), std::min(0.f, size.y) }, { std::abs(size.x), std::abs(size.y) } };
+        return true;
+    }
+
+    void VideoSprite::start() {
+        m_open = true;
+        m_frameBytes.resize(getFrameByteCount());
+
+        m_file.seekg(0, std::ios::end);
+        m_fileSize = m_file.tellg();
+        m_file.seekg(m_firstFrame);
+
+        for (u32 i = ringSize; i > 0; --i) {
+            m_free.push_back(i - 1);
+        }
+
+        m_decoder = std::thread(&VideoSprite::decodeLoop, this);
+    }
+
+    void VideoSprite::decodeLoop() {
+        u64 next = 0;
+
+        // Reads or skips one frame, wrapping around at the end of the file when looping
+        auto advance = [this](bool skip) {
+            if (readFrame(skip)) return true;
+            if (!m_loop) return false;
+
+            m_file.clear();
+            m_file.seekg(m_firstFrame);
+            return readFrame(skip);
+        };
+
+        while (true) {
+            u32 slot = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stop || !m_free.empty(); });
+                if (m_stop) return;
+
+                slot = m_free.back();
+                m_free.pop_back();
+            }
+
+            // Frames the clock already passed would be dropped on arrival; skip them unread
+            bool ok = true;
+            while (ok && next < m_targetFrame) {
+                ok = advance(true);
+                if (ok) {
+                    ++next;
+                    ++m_droppedFrames;
+                }
+            }
+
+            ok = ok && advance(false);
+
+            if (!ok) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_free.push_back(slot);
+                m_endOfStream = true;
+                return;
+            }
+
+            convertFrame(m_decodeScratch);
+            m_slots[slot].texture.setRawData(m_frameSize, std::move(m_decodeScratch));
+            m_slots[slot].frame = next++;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ready.push_back(slot);
+        }
+    }
+
+    bool VideoSprite::readFrame(bool skip) {
+        if (m_format != Format::Rgba) {
+            std::string header;
+            if (!std::getline(m_file, header) || header.rfind("FRAME", 0) != 0) {
+                return false;
+            }
+        }
+
+        const std::streamsize count = static_cast<std::streamsize>(m_frameBytes.size());
+
+        // A skipped frame counts once all of its bytes are in the file; reaching the
+        // end right after it is left for the next header or read to find
+        if (skip) {
+            if (m_fileSize - m_file.tellg() < count) {
+                return false;
+            }
+            m_file.seekg(count, std::ios::cur);
+            return static_cast<bool>(m_file);
+        }
+
+        m_file.read(reinterpret_cast<char *>(m_frameBytes.data()), count);
+        return m_file.gcount() == count;
+    }
+
+    void VideoSprite::convertFrame(std::vector<Color> &pixels) const {
+        const u32 width = m_frameSize.x;
+        const u32 height = m_frameSize.y;
+        pixels.resize(static_cast<std::size_t>(width) * height);
+
+        const u8 *bytes = m_frameBytes.data();
+
+        if (m_format == Format::Rgba) {
+            #pragma omp parallel for
+            for (i64 i = 0; i < static_cast<i64>(pixels.size()); ++i) {
+                const u8 *texel = bytes + i * 4;
+                pixels[i] = { texel[0], texel[1], texel[2], texel[3] };
+            }
+            return;
+        }
+
+        const u32 chromaWidth = m_format == Format::Yuv444 ? width : (width + 1) / 2;
+        const u32 chromaHeight = m_format == Format::Yuv420 ? (height + 1) / 2 : height;
+        const u8 *planeY = bytes;
+        const u8 *planeU = planeY + static_cast<std::size_t>(width) * height;
+        const u8 *planeV = planeU + static_cast<std::size_t>(chromaWidth) * chromaHeight;
+
+        #pragma omp parallel for
+        for (i64 y = 0; y < static_cast<i64>(height); ++y) {
+            const u8 *rowY = planeY + static_cast<std::size_t>(y) * width;
+            Color *out = pixels.data() + static_cast<std::size_t>(y) * width;
+
+            if (m_format == Format::Mono) {
+                for (u32 x = 0; x < width; ++x) {
+                    out[x] = yuvToColor(rowY[x], 128, 128);
+                }
+                continue;
+            }
+
+            const std::size_t chromaRow = static_cast<std::size_t>(m_format == Format::Yuv420 ? y / 2 : y) * chromaWidth;
+            const u8 *rowU = planeU + chromaRow;
+            const u8 *rowV = planeV + chromaRow;
+            const u32 shift = m_format == Format::Yuv444 ? 0 : 1;
+
+            for (u32 x = 0; x < width; ++x) {
+                out[x] = yuvToColor(rowY[x], rowU[x >> shift], rowV[x >> shift]);
+            }
+        }
+    }
+
+    std::size_t VideoSprite::getFrameByteCount() const {
+        const std::size_t pixels = static_cast<std::size_t>(m_frameSize.x) * m_frameSize.y;
+        const std::size_t chromaWidth = (m_frameSize.x + 1) / 2;
+        const std::size_t chromaHeight = (m_frameSize.y + 1) / 2;
+
+        switch (m_format) {
+            case Format::Rgba: return pixels * 4;
+            case Format::Yuv420: return pixels + 2 * chromaWidth * chromaHeight;
+            case Format::Yuv422: return pixels + 2 * chromaWidth * m_frameSize.y;
+            case Format::Yuv444: return pixels * 3;
+            case Format::Mono: return pixels;
+        }
+        return pixels;
+    }
+}
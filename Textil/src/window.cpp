@@ -20,6 +20,10 @@ namespace til
     }
 
     void Window::runPostProcessingPipeline() {
+        if (postProcessPipeline.getFilterCount() > 0) {
+            markDirty();
+        }
+
         postProcessPipeline.run(&m_pixelBuffer, &m_pixelBuffer, getBaseData());
     }
 
@@ -0,0 +1,47 @@
+#include "benchmark.hpp"
+
+namespace til::benchmarks
+{
+    State::State(u64 iterations)
+        : m_iterations(iterations),
+        m_remaining(iterations) {}
+
+    bool State::keepRunning() {
+        if (!m_started) {
+            m_started = true;
+            m_start = std::chrono::steady_clock::now();
+        }
+
+        if (m_remaining == 0) {
+            m_elapsed = std::chrono::steady_clock::now() - m_start;
+            return false;
+        }
+
+        --m_remaining;
+        return true;
+    }
+
+    void State::setItemsPerIteration(u64 items) {
+        m_itemsPerIteration = items;
+    }
+
+    u64 State::getIterations() const {
+        return m_iterations;
+    }
+
+    u64 State::getItemsPerIteration() const {
+        return m_itemsPerIteration;
+    }
+
+    std::chrono::steady_clock::duration State::getElapsed() const {
+        return m_elapsed;
+    }
+
+    void Registry::add(std::string name, std::function<void(State&)> run) {
+        m_benchmarks.push_back({ std::move(name), std::move(run) });
+    }
+
+    const std::vector<Benchmark> &Registry::getBenchmarks() const {
+        return m_benchmarks;
+    }
+}
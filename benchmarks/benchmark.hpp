@@ -0,0 +1,129 @@
+/**
+ * @file benchmark.hpp
+ * @brief Minimal microbenchmark harness used by the TextilBenchmarks target
+ * @details Benchmarks are plain functions taking a State. Setup code runs before the
+ *          first call to State::keepRunning() and is not measured; the loop body is.
+ *          The runner grows the iteration count until a run lasts at least the requested
+ *          minimum time and reports the results as JSON.
+ */
+
+#ifndef TIL_BENCHMARKS_BENCHMARK_HPP
+#define TIL_BENCHMARKS_BENCHMARK_HPP
+
+#include <til.hpp>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace til::benchmarks
+{
+    /**
+     * @brief Iteration control and counters passed to every benchmark function
+     */
+    class State
+    {
+    public:
+        /**
+         * @brief Create a state that runs the loop a fixed number of times
+         * @param iterations Number of times keepRunning() returns true
+         */
+        explicit State(u64 iterations);
+
+        /**
+         * @brief Advance the measured loop
+         * @return True while iterations remain
+         * @details The first call starts the timer, the call returning false stops it.
+         */
+        bool keepRunning();
+
+        /**
+         * @brief Declare how many items one iteration processes
+         * @param items Items per iteration (vertices, pixels, events, ...)
+         * @details Used to report throughput in items per second.
+         */
+        void setItemsPerIteration(u64 items);
+
+        /**
+         * @brief Get the number of iterations requested for this run
+         * @return Iteration count
+         */
+        u64 getIterations() const;
+
+        /**
+         * @brief Get the items processed per iteration
+         * @return Items per iteration, 0 if not declared
+         */
+        u64 getItemsPerIteration() const;
+
+        /**
+         * @brief Get the time spent inside the measured loop
+         * @return Elapsed wall-clock time
+         */
+        std::chrono::steady_clock::duration getElapsed() const;
+
+    private:
+        u64 m_iterations = 0;                             ///< Requested iteration count
+        u64 m_remaining = 0;                              ///< Iterations left in the loop
+        u64 m_itemsPerIteration = 0;                      ///< Items processed per iteration
+        bool m_started = false;                           ///< Whether the timer was started
+        std::chrono::steady_clock::time_point m_start {}; ///< Start of the measured loop
+        std::chrono::steady_clock::duration m_elapsed {}; ///< Duration of the measured loop
+    };
+
+    /**
+     * @brief A named benchmark function
+     */
+    struct Benchmark
+    {
+        std::string name;                  ///< Unique name, grouped with slashes (e.g. "transform/soa")
+        std::function<void(State&)> run;   ///< Benchmark body
+    };
+
+    /**
+     * @brief Collection of benchmarks to run
+     */
+    class Registry
+    {
+    public:
+        /**
+         * @brief Register a benchmark
+         * @param name Unique benchmark name
+         * @param run Benchmark body
+         */
+        void add(std::string name, std::function<void(State&)> run);
+
+        /**
+         * @brief Get all registered benchmarks in registration order
+         * @return Registered benchmarks
+         */
+        const std::vector<Benchmark> &getBenchmarks() const;
+
+    private:
+        std::vector<Benchmark> m_benchmarks {}; ///< Registered benchmarks
+    };
+
+    /**
+     * @brief Prevent the compiler from discarding a computed value
+     * @param value Value whose computation must be kept
+     */
+    template<typename T>
+    inline void doNotOptimize(const T &value) {
+    #if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+    #else
+        static const void *volatile sink;
+        sink = &value;
+    #endif
+    }
+
+    void registerTransformBenchmarks(Registry &registry);
+    void registerConsoleBenchmarks(Registry &registry);
+    void registerRasterBenchmarks(Registry &registry);
+    void registerFilterBenchmarks(Registry &registry);
+    void registerColorBenchmarks(Registry &registry);
+    void registerTextBenchmarks(Registry &registry);
+    void registerEventBenchmarks(Registry &registry);
+}
+
+#endif // TIL_BENCHMARKS_BENCHMARK_HPP
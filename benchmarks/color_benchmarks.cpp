@@ -0,0 +1,98 @@
+#include "benchmark.hpp"
+#include <random>
+
+namespace til::benchmarks
+{
+    namespace
+    {
+        constexpr u32 colorCount = 65536;
+        constexpr u32 sampleCount = 65536;
+
+        std::vector<Color> makeColors(u32 seed) {
+            std::mt19937 generator(seed);
+            std::uniform_int_distribution<u32> channel(0, 255);
+
+            std::vector<Color> colors(colorCount);
+            for (Color &color : colors) {
+                color = Color(channel(generator), channel(generator), channel(generator), channel(generator));
+            }
+            return colors;
+        }
+
+        std::string blendModeName(BlendMode mode) {
+            switch (mode) {
+                case BlendMode::None: return "none";
+                case BlendMode::Alpha: return "alpha";
+                case BlendMode::Additive: return "additive";
+                case BlendMode::Multiplicative: return "multiplicative";
+                case BlendMode::Subtractive: return "subtractive";
+                case BlendMode::Screen: return "screen";
+                case BlendMode::Overlay: return "overlay";
+            }
+            return "unknown";
+        }
+
+        std::vector<Vector2<f32>> makeUVs(bool coherent) {
+            std::mt19937 generator(1234);
+            std::uniform_real_distribution<f32> distribution(0.f, 1.f);
+
+            std::vector<Vector2<f32>> uvs(sampleCount);
+            for (u32 i = 0; i < sampleCount; ++i) {
+                if (coherent) {
+                    uvs[i] = { (i % 256 + 0.5f) / 256.f, (i / 256 + 0.5f) / 256.f };
+                } else {
+                    uvs[i] = { distribution(generator), distribution(generator) };
+                }
+            }
+            return uvs;
+        }
+    }
+
+    void registerColorBenchmarks(Registry &registry) {
+        for (BlendMode mode : {
+            BlendMode::None, BlendMode::Alpha, BlendMode::Additive, BlendMode::Multiplicative,
+            BlendMode::Subtractive, BlendMode::Screen, BlendMode::Overlay
+        }) {
+            registry.add("color/apply_blend/" + blendModeName(mode) + "/64K", [mode](State &state) {
+                auto destination = makeColors(1);
+                auto source = makeColors(2);
+                std::vector<Color> output(colorCount);
+
+                state.setItemsPerIteration(colorCount);
+                while (state.keepRunning()) {
+                    for (u32 i = 0; i < colorCount; ++i) {
+                        output[i] = Color::applyBlend(destination[i], source[i], mode);
+                    }
+                    doNotOptimize(output.data());
+                }
+            });
+        }
+
+        for (Texture::SamplingMode mode : { Texture::SamplingMode::NearestNeighbor, Texture::SamplingMode::Bilinear }) {
+            const std::string modeName = mode == Texture::SamplingMode::Bilinear ? "bilinear" : "nearest";
+
+            for (bool coherent : { true, false }) {
+                const std::string pattern = coherent ? "coherent" : "random";
+
+                registry.add("texture/sample/" + modeName + "/" + pattern + "/512x512", [mode, coherent](State &state) {
+                    Texture texture(Vector2<u32>(512u, 512u));
+                    std::vector<Color> pixels = makeColors(3);
+                    for (u32 i = 0; i < 512u * 512u; ++i) {
+                        texture.setPixel({ i % 512u, i / 512u }, pixels[i % colorCount]);
+                    }
+
+                    auto uvs = makeUVs(coherent);
+                    std::vector<Color> output(sampleCount);
+
+                    state.setItemsPerIteration(sampleCount);
+                    while (state.keepRunning()) {
+                        for (u32 i = 0; i < sampleCount; ++i) {
+                            output[i] = texture.sample(uvs[i], mode);
+                        }
+                        doNotOptimize(output.data());
+                    }
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include "benchmark.hpp"
+#include <random>
+
+namespace til::benchmarks
+{
+    namespace
+    {
+        const Vector2<u32> screenSize { 240u, 67u };
+
+        enum class ColorEntropy
+        {
+            Uniform,   // one color for the whole screen
+            PerRow,    // a new color at the start of every row
+            Palette16, // random picks from 16 colors
+            Random     // a random 24-bit color in every cell
+        };
+
+        std::vector<CharacterCell> makeCells(ColorEntropy entropy) {
+            std::mt19937 generator(1234);
+            std::uniform_int_distribution<u32> channel(0, 255);
+            std::uniform_int_distribution<u32> character(33, 126);
+
+            std::vector<Color> palette;
+            for (u32 i = 0; i < 16; ++i) {
+                palette.push_back(Color(channel(generator), channel(generator), channel(generator)));
+            }
+            std::uniform_int_distribution<u32> paletteIndex(0, static_cast<u32>(palette.size() - 1));
+
+            std::vector<CharacterCell> cells(screenSize.x * screenSize.y);
+            for (u32 y = 0; y < screenSize.y; ++y) {
+                Color rowColor(channel(generator), channel(generator), channel(generator));
+
+                for (u32 x = 0; x < screenSize.x; ++x) {
+                    CharacterCell &cell = cells[y * screenSize.x + x];
+                    cell.codepoint = character(generator);
+
+                    switch (entropy) {
+                        case ColorEntropy::Uniform:
+                            cell.color = palette[0];
+                            break;
+                        case ColorEntropy::PerRow:
+                            cell.color = rowColor;
+                            break;
+                        case ColorEntropy::Palette16:
+                            cell.color = palette[paletteIndex(generator)];
+                            break;
+                        case ColorEntropy::Random:
+                            cell.color = Color(channel(generator), channel(generator), channel(generator));
+                            break;
+                    }
+                }
+            }
+            return cells;
+        }
+
+        void addEncodeBenchmark(Registry &registry, const std::string &name, ColorEntropy entropy) {
+            registry.add("console/encode/" + name + "/240x67", [entropy](State &state) {
+                auto cells = makeCells(entropy);
+                std::string output;
+                output.reserve(cells.size() * 4);
+
+                state.setItemsPerIteration(cells.size());
+                while (state.keepRunning()) {
+                    output.clear();
+                    encodeCharacterCells(cells, screenSize, output);
+                    doNotOptimize(output.data());
+                }
+            });
+        }
+    }
+
+    void registerConsoleBenchmarks(Registry &registry) {
+        addEncodeBenchmark(registry, "uniform", ColorEntropy::Uniform);
+        addEncodeBenchmark(registry, "per_row", ColorEntropy::PerRow);
+        addEncodeBenchmark(registry, "palette16", ColorEntropy::Palette16);
+        addEncodeBenchmark(registry, "random", ColorEntropy::Random);
+    }
+}
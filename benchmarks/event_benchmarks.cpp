@@ -0,0 +1,63 @@
+#include "benchmark.hpp"
+
+namespace til::benchmarks
+{
+    namespace
+    {
+        constexpr u32 eventCounts[] = { 16, 256, 4096 };
+
+        std::vector<Event> makeEvents(u32 count) {
+            std::vector<Event> events(count);
+
+            for (u32 i = 0; i < count; ++i) {
+                Event &event = events[i];
+
+                switch (i % 4) {
+                    case 0:
+                        event.setType<KeyPressEvent>();
+                        event.key = KeyCode::A;
+                        break;
+                    case 1:
+                        event.setType<KeyReleaseEvent>();
+                        event.key = KeyCode::A;
+                        break;
+                    case 2:
+                        event.setType<MouseMoveEvent>();
+                        event.mouseDelta = { 1, -1 };
+                        break;
+                    case 3:
+                        event.setType<MouseScrollEvent>();
+                        event.mouseScrollDelta = 1;
+                        break;
+                }
+            }
+            return events;
+        }
+    }
+
+    void registerEventBenchmarks(Registry &registry) {
+        for (u32 count : eventCounts) {
+            // handleEvents consumes the queue, so refilling it is part of every iteration
+            registry.add("events/handle_events/" + std::to_string(count), [count](State &state) {
+                EventManager eventManager;
+                auto events = makeEvents(count);
+                i64 sum = 0;
+
+                state.setItemsPerIteration(count);
+                while (state.keepRunning()) {
+                    for (const Event &event : events) {
+                        eventManager.pushEvent(event);
+                    }
+
+                    eventManager.handleEvents(
+                        [&sum](KeyPressEvent, const Event &event) { sum += static_cast<i64>(event.key); },
+                        [&sum](MouseMoveEvent, const Event &event) { sum += event.mouseDelta.x; },
+                        [&sum](MouseScrollEvent, const Event &event) { sum += event.mouseScrollDelta; }
+                    );
+                    eventManager.discardEvents();
+                    doNotOptimize(sum);
+                }
+            });
+        }
+    }
+}
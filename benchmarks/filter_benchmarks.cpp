@@ -0,0 +1,137 @@
+#include "benchmark.hpp"
+#include <memory>
+#include <random>
+
+namespace til::benchmarks
+{
+    namespace
+    {
+        using ExecutionMode = BaseFilter::ExecutionMode;
+
+        constexpr u32 bufferWidth = 256;
+        constexpr u32 bufferHeight = 256;
+        constexpr u32 elementCount = bufferWidth * bufferHeight;
+
+        constexpr ExecutionMode allModes[] = { ExecutionMode::Single, ExecutionMode::Sequential, ExecutionMode::Concurrent };
+
+        std::string modeName(ExecutionMode mode) {
+            switch (mode) {
+                case ExecutionMode::Single: return "single";
+                case ExecutionMode::Sequential: return "sequential";
+                case ExecutionMode::Concurrent: return "concurrent";
+            }
+            return "unknown";
+        }
+
+        void fillInput(FilterableBuffer<Color> &buffer) {
+            std::mt19937 generator(1234);
+            std::uniform_int_distribution<u32> channel(0, 255);
+
+            buffer.setSize(elementCount);
+            for (u32 i = 0; i < elementCount; ++i) {
+                buffer[i] = Color(channel(generator), channel(generator), channel(generator));
+            }
+        }
+
+        void fillInput(FilterableBuffer<filters::VertexData> &buffer) {
+            buffer.setSize(elementCount);
+            for (u32 y = 0; y < bufferHeight; ++y) {
+                for (u32 x = 0; x < bufferWidth; ++x) {
+                    filters::VertexData &fragment = buffer[y * bufferWidth + x];
+                    fragment.position = { static_cast<f32>(x), static_cast<f32>(y) };
+                    fragment.uv = { (x + 0.5f) / bufferWidth, (y + 0.5f) / bufferHeight };
+                    fragment.color = Color(x, y, 128);
+                    fragment.size = { static_cast<f32>(bufferWidth), static_cast<f32>(bufferHeight) };
+                    fragment.inverseSize = { 1.f / bufferWidth, 1.f / bufferHeight };
+                }
+            }
+        }
+
+        // Runs the filter alone in a pipeline, as the renderer and windows do
+        template<typename InputType, typename OutputType, typename Factory>
+        void addFilterBenchmark(Registry &registry, const std::string &name, Factory factory, ExecutionMode mode) {
+            registry.add("filter/" + name + "/" + modeName(mode) + "/256x256", [factory, mode](State &state) {
+                auto filter = factory();
+                filter->executionMode = mode;
+
+                FilterPipeline<InputType, OutputType> pipeline;
+                pipeline.addFilter(filter.get()).build();
+
+                FilterableBuffer<InputType> input;
+                FilterableBuffer<OutputType> output;
+                fillInput(input);
+                output.setSize(elementCount);
+
+                filters::BaseData baseData;
+                baseData.bufferSize = { bufferWidth, bufferHeight };
+
+                state.setItemsPerIteration(elementCount);
+                while (state.keepRunning()) {
+                    // Time-based filters such as CharacterShuffleColored update on every run
+                    baseData.time += 1.f;
+                    pipeline.run(&input, &output, baseData);
+                    doNotOptimize(output.getBuffer().data());
+                }
+            });
+        }
+
+        template<typename InputType, typename OutputType, typename Factory>
+        void addFilterBenchmarks(Registry &registry, const std::string &name, Factory factory) {
+            for (ExecutionMode mode : allModes) {
+                addFilterBenchmark<InputType, OutputType>(registry, name, factory, mode);
+            }
+        }
+    }
+
+    void registerFilterBenchmarks(Registry &registry) {
+        addFilterBenchmarks<Color, CharacterCell>(registry, "single_character_colored", [] {
+            return std::make_unique<filters::SingleCharacterColored>(35);
+        });
+
+        addFilterBenchmarks<Color, CharacterCell>(registry, "single_colored_dithered", [] {
+            return std::make_unique<filters::SingleColoredDithered>(Color(255, 255, 255));
+        });
+
+        addFilterBenchmarks<Color, CharacterCell>(registry, "character_shuffle_colored", [] {
+            return std::make_unique<filters::CharacterShuffleColored>();
+        });
+
+        addFilterBenchmarks<filters::VertexData, filters::VertexData>(registry, "solid_color", [] {
+            return std::make_unique<filters::SolidColor>(Color(200, 120, 40));
+        });
+
+        addFilterBenchmarks<filters::VertexData, filters::VertexData>(registry, "uv_gradient", [] {
+            return std::make_unique<filters::UVGradient>();
+        });
+
+        addFilterBenchmarks<filters::VertexData, filters::VertexData>(registry, "grayscale", [] {
+            return std::make_unique<filters::Grayscale>();
+        });
+
+        addFilterBenchmarks<filters::VertexData, filters::VertexData>(registry, "invert", [] {
+            return std::make_unique<filters::Invert>();
+        });
+
+        auto texture = std::make_shared<Texture>(Vector2<u32> { 64u, 64u });
+        for (u32 y = 0; y < 64; ++y) {
+            for (u32 x = 0; x < 64; ++x) {
+                texture->setPixel({ x, y }, Color(x * 4, y * 4, (x ^ y) * 4));
+            }
+        }
+
+        addFilterBenchmarks<filters::VertexData, filters::VertexData>(registry, "texture_sampler", [texture] {
+            return std::make_unique<filters::TextureSampler>(texture.get());
+        });
+
+        // Lighting works on whole images and only implements the Single mode
+        addFilterBenchmark<Color, Color>(registry, "lighting", [] {
+            auto lighting = std::make_unique<filters::Lighting>();
+            lighting->data.lights = {
+                { { 64.f, 64.f }, Color(255, 200, 150), 96.f, 1.f },
+                { { 192.f, 160.f }, Color(120, 160, 255), 128.f, 1.f }
+            };
+            lighting->data.addRectangleOccluder({ { 110.f, 100.f }, { 24.f, 48.f } });
+            return lighting;
+        }, ExecutionMode::Single);
+    }
+}
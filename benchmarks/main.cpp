@@ -0,0 +1,111 @@
+#include "benchmark.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+using namespace til::benchmarks;
+
+namespace
+{
+    struct Options
+    {
+        std::string filter {};
+        double minTimeSeconds = 0.5;
+    };
+
+    struct Result
+    {
+        std::string name;
+        til::u64 iterations = 0;
+        double seconds = 0.0;
+        til::u64 itemsPerIteration = 0;
+    };
+
+    Options parseOptions(int argc, char **argv) {
+        Options options;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string_view argument = argv[i];
+
+            if (argument == "--filter" && i + 1 < argc) {
+                options.filter = argv[++i];
+            } else if (argument == "--min-time" && i + 1 < argc) {
+                options.minTimeSeconds = std::max(0.001, std::atof(argv[++i]));
+            } else {
+                std::cerr << "Usage: TextilBenchmarks [--filter <substring>] [--min-time <seconds>]\n";
+                std::exit(1);
+            }
+        }
+
+        return options;
+    }
+
+    Result runBenchmark(const Benchmark &benchmark, double minTimeSeconds) {
+        til::u64 iterations = 1;
+
+        while (true) {
+            State state(iterations);
+            benchmark.run(state);
+
+            double seconds = std::chrono::duration<double>(state.getElapsed()).count();
+
+            if (seconds >= minTimeSeconds || iterations >= (1ull << 40)) {
+                return { benchmark.name, iterations, seconds, state.getItemsPerIteration() };
+            }
+
+            double scale = seconds > 0.0 ? std::min(minTimeSeconds * 1.2 / seconds, 100.0) : 100.0;
+            iterations = std::max(iterations + 1, static_cast<til::u64>(static_cast<double>(iterations) * scale));
+        }
+    }
+
+    void writeJson(const std::vector<Result> &results, std::ostream &out) {
+        out << "{\n  \"benchmarks\": [";
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result &result = results[i];
+            double nsPerIteration = result.seconds * 1e9 / static_cast<double>(result.iterations);
+
+            out << (i == 0 ? "\n" : ",\n");
+            out << "    {\"name\": \"" << result.name << "\""
+                << ", \"iterations\": " << result.iterations
+                << ", \"ns_per_iteration\": " << nsPerIteration;
+
+            if (result.itemsPerIteration > 0) {
+                double itemsPerSecond = static_cast<double>(result.itemsPerIteration * result.iterations) / result.seconds;
+                out << ", \"items_per_iteration\": " << result.itemsPerIteration
+                    << ", \"items_per_second\": " << itemsPerSecond;
+            }
+
+            out << "}";
+        }
+
+        out << "\n  ]\n}\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    Options options = parseOptions(argc, argv);
+
+    Registry registry;
+    registerTransformBenchmarks(registry);
+    registerConsoleBenchmarks(registry);
+    registerRasterBenchmarks(registry);
+    registerFilterBenchmarks(registry);
+    registerColorBenchmarks(registry);
+    registerTextBenchmarks(registry);
+    registerEventBenchmarks(registry);
+
+    std::vector<Result> results;
+    for (const Benchmark &benchmark : registry.getBenchmarks()) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        results.push_back(runBenchmark(benchmark, options.minTimeSeconds));
+    }
+
+    writeJson(results, std::cout);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "benchmark.hpp"
+
+namespace til::benchmarks
+{
+    namespace
+    {
+        const Vector2<u32> targetSize { 512u, 512u };
+        constexpr f32 primitiveSizes[] = { 4.f, 32.f, 256.f };
+
+        // Fragments are written without blending so the numbers track rasterization
+        struct RasterFixture
+        {
+            TextureTarget target { targetSize };
+            Renderer renderer;
+            filters::SolidColor solidColor { Color(200, 120, 40) };
+            FilterPipeline<filters::VertexData, filters::VertexData> pipeline;
+            Transform transform;
+
+            RasterFixture() {
+                target.setRenderer(&renderer);
+                pipeline.addFilter(&solidColor).build();
+            }
+        };
+
+        std::string sizeName(f32 size) {
+            return std::to_string(static_cast<u32>(size)) + "px";
+        }
+
+        std::string modeName(RasterizationMode mode) {
+            return mode == RasterizationMode::FixedPoint ? "fixed" : "float";
+        }
+    }
+
+    void registerRasterBenchmarks(Registry &registry) {
+        for (RasterizationMode mode : { RasterizationMode::FloatingPoint, RasterizationMode::FixedPoint }) {
+            for (f32 size : primitiveSizes) {
+                registry.add("raster/triangle/" + modeName(mode) + "/" + sizeName(size), [mode, size](State &state) {
+                    RasterFixture fixture;
+                    fixture.renderer.setRasterizationMode(mode);
+
+                    const Vector2<f32> center { targetSize.x * 0.5f, targetSize.y * 0.5f };
+                    // Counter-clockwise, the winding both rasterization modes fill
+                    primitives::Vertex vertices[3] = {
+                        { { center.x - size * 0.5f, center.y + size * 0.5f }, { 0.f, 1.f } },
+                        { { center.x, center.y - size * 0.5f }, { 0.5f, 0.f } },
+                        { { center.x + size * 0.5f, center.y + size * 0.5f }, { 1.f, 1.f } }
+                    };
+                    primitives::TriangleMesh mesh { fixture.renderer.addMesh(vertices, 3), 3 };
+
+                    state.setItemsPerIteration(1);
+                    while (state.keepRunning()) {
+                        fixture.renderer.drawImmediate(fixture.target, mesh, fixture.transform, fixture.pipeline, BlendMode::None);
+                    }
+                    doNotOptimize(fixture.target.getTexture().getRawData().data());
+                });
+            }
+        }
+
+        for (f32 size : primitiveSizes) {
+            registry.add("raster/ellipse/" + sizeName(size), [size](State &state) {
+                RasterFixture fixture;
+                primitives::Ellipse ellipse { { targetSize.x * 0.5f, targetSize.y * 0.5f }, { size * 0.5f, size * 0.5f } };
+
+                state.setItemsPerIteration(1);
+                while (state.keepRunning()) {
+                    fixture.renderer.drawImmediate(fixture.target, ellipse, fixture.transform, fixture.pipeline, BlendMode::None);
+                }
+                doNotOptimize(fixture.target.getTexture().getRawData().data());
+            });
+        }
+
+        for (f32 size : primitiveSizes) {
+            registry.add("raster/line/" + sizeName(size), [size](State &state) {
+                RasterFixture fixture;
+                const Vector2<f32> center { targetSize.x * 0.5f, targetSize.y * 0.5f };
+                primitives::Line line {
+                    { { center.x - size * 0.5f, center.y - size * 0.25f }, { 0.f, 0.f } },
+                    { { center.x + size * 0.5f, center.y + size * 0.25f }, { 1.f, 1.f } }
+                };
+
+                state.setItemsPerIteration(1);
+                while (state.keepRunning()) {
+                    fixture.renderer.drawImmediate(fixture.target, line, fixture.transform, fixture.pipeline, BlendMode::None);
+                }
+                doNotOptimize(fixture.target.getTexture().getRawData().data());
+            });
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#include "benchmark.hpp"
+#include <filesystem>
+#include <fstream>
+
+namespace til::benchmarks
+{
+    namespace
+    {
+        // Writes an 8x16 font covering printable ASCII so the benchmark needs no font files
+        std::filesystem::path writeBenchmarkFont() {
+            std::filesystem::path path = std::filesystem::temp_directory_path() / "textil_benchmark_font.bdf";
+            std::ofstream file(path);
+
+            file << "STARTFONT 2.1\nFONTBOUNDINGBOX 8 16 0 -4\nCHARS 95\n";
+            for (u32 codepoint = 32; codepoint < 127; ++codepoint) {
+                file << "STARTCHAR U+" << codepoint << "\n"
+                     << "ENCODING " << codepoint << "\n"
+                     << "DWIDTH 8 0\n"
+                     << "BBX 8 16 0 -4\n"
+                     << "BITMAP\n";
+
+                for (u32 row = 0; row < 16; ++row) {
+                    const u32 bits = codepoint == 32 ? 0u : ((codepoint * 37u + row * 11u) & 0x7Eu);
+                    const char *digits = "0123456789ABCDEF";
+                    file << digits[bits >> 4] << digits[bits & 0xF] << "\n";
+                }
+
+                file << "ENDCHAR\n";
+            }
+            file << "ENDFONT\n";
+
+            return path;
+        }
+
+        void addRenderBenchmark(Registry &registry, const std::string &name, const std::string &text) {
+            registry.add("text/render_to_texture/" + name, [text](State &state) {
+                const std::filesystem::path path = writeBenchmarkFont();
+                BitmapFont font;
+                font.loadFromBDF(path.string());
+                std::filesystem::remove(path);
+
+                Texture texture;
+
+                state.setItemsPerIteration(text.size());
+                while (state.keepRunning()) {
+                    font.renderToTexture(text, texture, Color(255, 255, 255), Color(0, 0, 0, 0));
+                    doNotOptimize(texture.getRawData().data());
+                }
+            });
+        }
+    }
+
+    void registerTextBenchmarks(Registry &registry) {
+        addRenderBenchmark(registry, "word", "Textil");
+        addRenderBenchmark(registry, "sentence", "The quick brown fox jumps over the lazy dog 0123456789");
+
+        std::string paragraph;
+        for (u32 line = 0; line < 20; ++line) {
+            paragraph += "Line " + std::to_string(line) + ": The quick brown fox jumps over the lazy dog\n";
+        }
+        addRenderBenchmark(registry, "paragraph", paragraph);
+    }
+}
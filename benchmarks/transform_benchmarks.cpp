@@ -0,0 +1,88 @@
+#include "benchmark.hpp"
+#include <random>
+
+namespace til::benchmarks
+{
+    namespace
+    {
+        constexpr u64 vertexCount = 1'000'000;
+
+        Transform makeTransform() {
+            Transform transform({ 40.f, 12.f }, { 1.5f, 0.75f }, 0.3f, { 8.f, 4.f });
+            return transform;
+        }
+
+        std::vector<primitives::Vertex> makeVertices() {
+            std::mt19937 generator(1234);
+            std::uniform_real_distribution<f32> distribution(-100.f, 100.f);
+
+            std::vector<primitives::Vertex> vertices(vertexCount);
+            for (auto &vertex : vertices) {
+                vertex.position = { distribution(generator), distribution(generator) };
+                vertex.uv = { 0.5f, 0.5f };
+            }
+            return vertices;
+        }
+    }
+
+    void registerTransformBenchmarks(Registry &registry) {
+        registry.add("transform/matrix3_per_vertex/1M", [](State &state) {
+            auto vertices = makeVertices();
+            std::vector<Vector2<f32>> output(vertexCount);
+            Matrix3<f32> matrix = makeTransform().getMatrix();
+
+            state.setItemsPerIteration(vertexCount);
+            while (state.keepRunning()) {
+                for (u64 i = 0; i < vertexCount; ++i) {
+                    output[i] = matrix * vertices[i].position;
+                }
+                doNotOptimize(output.data());
+            }
+        });
+
+        registry.add("transform/batch_interleaved/1M", [](State &state) {
+            auto vertices = makeVertices();
+            std::vector<Vector2<f32>> positions(vertexCount);
+            std::vector<Vector2<f32>> output(vertexCount);
+            for (u64 i = 0; i < vertexCount; ++i) {
+                positions[i] = vertices[i].position;
+            }
+            AffineMatrix<f32> matrix = makeTransform().getAffineMatrix();
+
+            state.setItemsPerIteration(vertexCount);
+            while (state.keepRunning()) {
+                transformPoints(matrix, positions.data(), output.data(), vertexCount);
+                doNotOptimize(output.data());
+            }
+        });
+
+        registry.add("transform/batch_soa/1M", [](State &state) {
+            auto vertices = makeVertices();
+            std::vector<f32> x(vertexCount), y(vertexCount), outX(vertexCount), outY(vertexCount);
+            for (u64 i = 0; i < vertexCount; ++i) {
+                x[i] = vertices[i].position.x;
+                y[i] = vertices[i].position.y;
+            }
+            AffineMatrix<f32> matrix = makeTransform().getAffineMatrix();
+
+            state.setItemsPerIteration(vertexCount);
+            while (state.keepRunning()) {
+                transformPoints(matrix, x.data(), y.data(), outX.data(), outY.data(), vertexCount);
+                doNotOptimize(outX.data());
+                doNotOptimize(outY.data());
+            }
+        });
+
+        registry.add("transform/batch_vertex_strided/1M", [](State &state) {
+            auto vertices = makeVertices();
+            std::vector<Vector2<f32>> output(vertexCount);
+            AffineMatrix<f32> matrix = makeTransform().getAffineMatrix();
+
+            state.setItemsPerIteration(vertexCount);
+            while (state.keepRunning()) {
+                transformPointsStrided(matrix, &vertices[0].position, sizeof(primitives::Vertex), output.data(), vertexCount);
+                doNotOptimize(output.data());
+            }
+        });
+    }
+}
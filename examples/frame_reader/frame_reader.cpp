@@ -0,0 +1,90 @@
+// Mirrors the frames of a Textil application that exports them with
+// SharedFrameExporter, reading the shared memory ring without linking Textil.
+//
+// Usage: frame_reader [name]   (default name: /textil-frames)
+
+#include <shared_frame.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    void appendUtf8(std::string &out, til::u32 codepoint) {
+        if (codepoint < 0x80) {
+            out += static_cast<char>(codepoint);
+        } else if (codepoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codepoint >> 6));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        } else if (codepoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codepoint >> 12));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codepoint >> 18));
+            out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::string name = argc > 1 ? argv[1] : "/textil-frames";
+
+    til::SharedFrameReader reader;
+    while (!reader.open(name)) {
+        std::printf("\rWaiting for %s...", name.c_str());
+        std::fflush(stdout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    }
+
+    std::vector<til::SharedFrameCell> cells;
+    std::string output;
+    til::u64 lastSequence = 0;
+    til::u64 missedFrames = 0;
+    til::u64 tornReads = 0;
+
+    std::printf("\x1b[2J");
+
+    while (true) {
+        til::SharedFrameView frame;
+        if (!reader.acquire(frame) || frame.sequence == lastSequence) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        // Copy out of the ring, then make sure the writer did not lap us meanwhile
+        cells.assign(frame.cells, frame.cells + static_cast<std::size_t>(frame.columns) * frame.rows);
+        if (!reader.isValid(frame)) {
+            ++tornReads;
+            continue;
+        }
+
+        if (lastSequence != 0 && frame.sequence > lastSequence + 1) {
+            missedFrames += frame.sequence - lastSequence - 1;
+        }
+        lastSequence = frame.sequence;
+
+        output = "\x1b[H";
+        for (til::u32 y = 0; y < frame.rows; ++y) {
+            for (til::u32 x = 0; x < frame.columns; ++x) {
+                const til::SharedFrameCell &cell = cells[static_cast<std::size_t>(y) * frame.columns + x];
+                output += "\x1b[38;2;" + std::to_string(cell.r) + ";" + std::to_string(cell.g) + ";" + std::to_string(cell.b) + "m";
+                appendUtf8(output, cell.codepoint);
+            }
+            output += "\x1b[0m\r\n";
+        }
+
+        output += "frame " + std::to_string(frame.sequence) +
+                  "  " + std::to_string(frame.columns) + "x" + std::to_string(frame.rows) + " cells" +
+                  "  pixels " + std::to_string(frame.pixelWidth) + "x" + std::to_string(frame.pixelHeight) +
+                  "  missed " + std::to_string(missedFrames) +
+                  "  torn " + std::to_string(tornReads) + "\x1b[K";
+
+        std::fwrite(output.data(), 1, output.size(), stdout);
+        std::fflush(stdout);
+    }
+}
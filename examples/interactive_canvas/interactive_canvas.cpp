@@ -5,6 +5,11 @@
 namespace
 {
     constexpr float kMoveStep = 1.0f;
+
+    // Draw ids of the pickable shapes; 0 means nothing was hit.
+    constexpr til::u32 kBoxId = 1;
+    constexpr til::u32 kDiscId = 2;
+    constexpr til::u32 kTriangleId = 3;
 }
 
 int main() {
@@ -15,6 +20,7 @@ int main() {
     til::Window &window = framework.windowManager.createWindow();
     window.setSize(framework.console.getSize());
     window.setRenderer(&framework.renderer);
+    window.setIdBufferEnabled(true);
     window.depth = 1.0f;
 
     til::filters::SingleCharacterColored characterFilter('.');
@@ -25,6 +31,30 @@ int main() {
     fragmentPipeline.addFilter(&solidFill).build();
 
     const auto initialSize = window.getSize();
+    const til::Vector2<til::f32> center = {
+        static_cast<til::f32>(initialSize.x) * 0.5f,
+        static_cast<til::f32>(initialSize.y) * 0.5f
+    };
+
+    // Overlapping shapes; whichever is visible under the cursor gets highlighted.
+    til::filters::SolidColor boxFill({70, 130, 200, 255});
+    til::Rectangle box;
+    box.topLeft = {center.x - 30.f, center.y - 12.f};
+    box.size = {30.f, 16.f};
+    box.fragmentPipeline.addFilter(&boxFill).build();
+
+    til::filters::SolidColor discFill({90, 190, 110, 255});
+    til::EllipseDrawable disc;
+    disc.center = {center.x + 4.f, center.y - 2.f};
+    disc.radii = {12.f, 8.f};
+    disc.fragmentPipeline.addFilter(&discFill).build();
+
+    til::filters::SolidColor triangleFill({200, 90, 150, 255});
+    til::Polygon triangle;
+    triangle.setPoints({{center.x + 8.f, center.y + 14.f}, {center.x + 30.f, center.y - 10.f}, {center.x + 34.f, center.y + 14.f}});
+    triangle.fragmentPipeline.addFilter(&triangleFill).build();
+
+    til::u32 hovered = 0;
 
     til::primitives::Ellipse ellipse;
     ellipse.center = {0.f, 0.f};
@@ -33,10 +63,7 @@ int main() {
     til::Transform transform;
     transform.setOrigin({0.f, 0.f});
 
-    til::Vector2<til::f32> position = {
-        static_cast<til::f32>(initialSize.x) * 0.5f,
-        static_cast<til::f32>(initialSize.y) * 0.5f
-    };
+    til::Vector2<til::f32> position = center;
     float accumulatedTime = 0.f;
     bool running = true;
 
@@ -91,6 +118,26 @@ int main() {
             }
         }
 
+        // Shapes are tagged with their draw id; the grid above keeps id 0.
+        auto highlight = [&](til::u32 id, til::Color color) {
+            return hovered == id ? til::Color{255, 255, 255, 255} : color;
+        };
+        boxFill.data.color = highlight(kBoxId, {70, 130, 200, 255});
+        discFill.data.color = highlight(kDiscId, {90, 190, 110, 255});
+        triangleFill.data.color = highlight(kTriangleId, {200, 90, 150, 255});
+
+        window.setDrawId(kBoxId);
+        box.draw(framework.renderer, window);
+        window.setDrawId(kDiscId);
+        disc.draw(framework.renderer, window);
+        window.setDrawId(kTriangleId);
+        triangle.draw(framework.renderer, window);
+        window.setDrawId(0);
+
+        // Rasterize the shapes now, so the ID buffer is filled before the cursor covers it.
+        window.render();
+        hovered = window.pick({static_cast<til::u32>(position.x), static_cast<til::u32>(position.y)});
+
         transform.setPosition(position);
 
         solidFill.data.color = {
@@ -3,7 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <limits>
+#include <vector>
 #include <numbers>
 
 namespace
@@ -62,35 +62,40 @@ namespace
         };
     }
 
-    til::Color shadeWall(int cellId, bool isSideHit, til::f32 distance)
+    til::Color wallBaseColor(int cellId)
     {
-        til::Color baseColor;
         switch (cellId) {
-            case 1: baseColor = { 220, 60, 60, 255 }; break;
-            case 2: baseColor = { 60, 190, 210, 255 }; break;
-            case 3: baseColor = { 245, 200, 65, 255 }; break;
-            case 4: baseColor = { 170, 90, 220, 255 }; break;
-            default: baseColor = { 210, 210, 210, 255 }; break;
+            case 1: return { 220, 60, 60, 255 };
+            case 2: return { 60, 190, 210, 255 };
+            case 3: return { 245, 200, 65, 255 };
+            case 4: return { 170, 90, 220, 255 };
+            default: return { 210, 210, 210, 255 };
         }
+    }
 
-        til::f32 brightness = 1.0f / (1.0f + distance * 0.18f);
-        brightness = std::clamp(brightness, 0.18f, 1.0f);
-
-        if (isSideHit) {
-            brightness *= 0.75f;
+    // Brick pattern tinted with the wall color, with darker mortar lines
+    til::Texture makeBrickTexture(const til::Color &color)
+    {
+        til::Texture texture(til::Vector2<til::u32>{ 16, 16 });
+        for (til::u32 y = 0; y < 16; ++y) {
+            for (til::u32 x = 0; x < 16; ++x) {
+                const til::u32 offset = (y / 4) % 2 == 0 ? 0 : 4;
+                const bool mortar = y % 4 == 3 || (x + offset) % 8 == 7;
+                texture.setPixel({ x, y }, scaleColor(color, mortar ? 0.45f : 1.0f - 0.1f * static_cast<til::f32>((x * 7 + y * 3) % 3)));
+            }
         }
-
-        return scaleColor(baseColor, brightness);
+        return texture;
     }
 
-    til::Color lerpColor(const til::Color &from, const til::Color &to, til::f32 t)
+    til::Texture makeCheckerTexture(const til::Color &light, const til::Color &dark)
     {
-        return {
-            static_cast<til::u8>(std::lerp(static_cast<til::f32>(from.r), static_cast<til::f32>(to.r), t)),
-            static_cast<til::u8>(std::lerp(static_cast<til::f32>(from.g), static_cast<til::f32>(to.g), t)),
-            static_cast<til::u8>(std::lerp(static_cast<til::f32>(from.b), static_cast<til::f32>(to.b), t)),
-            static_cast<til::u8>(std::lerp(static_cast<til::f32>(from.a), static_cast<til::f32>(to.a), t))
-        };
+        til::Texture texture(til::Vector2<til::u32>{ 8, 8 });
+        for (til::u32 y = 0; y < 8; ++y) {
+            for (til::u32 x = 0; x < 8; ++x) {
+                texture.setPixel({ x, y }, ((x / 4) + (y / 4)) % 2 == 0 ? light : dark);
+            }
+        }
+        return texture;
     }
 }
 
@@ -108,16 +113,33 @@ int main()
     til::filters::SingleCharacterColored charFilter(0x2588); // solid block for filled pixels
     window.characterPipeline.addFilter(&charFilter).build();
 
+    til::Raycaster raycaster;
+    raycaster.setMap({ kMapWidth, kMapHeight }, std::vector<til::u32>(kLevel.begin(), kLevel.end()));
+
+    std::array<til::Texture, 4> wallTextures {
+        makeBrickTexture(wallBaseColor(1)),
+        makeBrickTexture(wallBaseColor(2)),
+        makeBrickTexture(wallBaseColor(3)),
+        makeBrickTexture(wallBaseColor(4))
+    };
+    for (til::u32 cell = 1; cell <= wallTextures.size(); ++cell) {
+        raycaster.setWallTexture(cell, &wallTextures[cell - 1]);
+    }
+
+    til::Texture floorTexture = makeCheckerTexture({ 70, 62, 50, 255 }, { 50, 44, 36, 255 });
+    raycaster.floorTexture = &floorTexture;
+    raycaster.ceilingColor = { 40, 70, 130, 255 };
+
     struct Player
     {
-    til::Vector2<til::f32> position { 8.5f, 8.5f };
-    til::Vector2<til::f32> direction { -1.0f, 0.0f };
-        til::Vector2<til::f32> cameraPlane { 0.0f, 0.66f };
+        til::Vector2<til::f32> position { 8.5f, 8.5f };
+        til::Vector2<til::f32> direction { -1.0f, 0.0f };
+        til::Vector2<til::f32> cameraPlane { 0.0f, -0.66f };
         til::f32               fovScale { 0.66f };
 
         void updateCameraPlane()
         {
-            cameraPlane = { direction.y * fovScale, -direction.x * fovScale };
+            cameraPlane = { -direction.y * fovScale, direction.x * fovScale };
         }
     } player;
     player.updateCameraPlane();
@@ -203,8 +225,8 @@ int main()
         if (strafeLeft || strafeRight) {
             const til::f32 direction = strafeRight ? 1.0f : -1.0f;
             til::Vector2<til::f32> strafe {
-                player.direction.y * direction * strafeSpeed,
-                -player.direction.x * direction * strafeSpeed
+                -player.direction.y * direction * strafeSpeed,
+                player.direction.x * direction * strafeSpeed
             };
             til::Vector2<til::f32> candidateX { player.position.x + strafe.x, player.position.y };
             til::Vector2<til::f32> candidateY { player.position.x, player.position.y + strafe.y };
@@ -228,10 +250,10 @@ int main()
         };
 
         if (turnLeft) {
-            rotatePlayer(rotationSpeed);
+            rotatePlayer(-rotationSpeed);
         }
         if (turnRight) {
-            rotatePlayer(-rotationSpeed);
+            rotatePlayer(rotationSpeed);
         }
 
         const auto size = window.getSize();
@@ -241,111 +263,7 @@ int main()
             continue;
         }
 
-        const til::u32 horizon = size.y / 2;
-
-        const til::Color skyTop { 30, 60, 120, 255 };
-        const til::Color skyBottom { 80, 120, 200, 255 };
-        const til::Color floorNear { 55, 48, 38, 255 };
-        const til::Color floorFar { 10, 10, 14, 255 };
-
-        for (til::u32 y = 0; y < horizon; ++y) {
-            const til::f32 t = static_cast<til::f32>(y) / std::max<til::u32>(1, horizon - 1);
-            const til::Color rowColor = lerpColor(skyTop, skyBottom, t);
-            for (til::u32 x = 0; x < size.x; ++x) {
-                framework.renderer.drawImmediatePixel(window, { x, y }, rowColor, til::BlendMode::None);
-            }
-        }
-
-        for (til::u32 y = horizon; y < size.y; ++y) {
-            const til::f32 t = static_cast<til::f32>(y - horizon) / std::max<til::u32>(1, size.y - horizon - 1);
-            const til::Color rowColor = lerpColor(floorNear, floorFar, t);
-            for (til::u32 x = 0; x < size.x; ++x) {
-                framework.renderer.drawImmediatePixel(window, { x, y }, rowColor, til::BlendMode::None);
-            }
-        }
-
-        for (til::u32 x = 0; x < size.x; ++x) {
-            const til::f32 cameraX = 2.0f * static_cast<til::f32>(x) / static_cast<til::f32>(size.x) - 1.0f;
-            til::Vector2<til::f32> rayDirection {
-                player.direction.x + player.cameraPlane.x * cameraX,
-                player.direction.y + player.cameraPlane.y * cameraX
-            };
-
-            int mapX = static_cast<int>(player.position.x);
-            int mapY = static_cast<int>(player.position.y);
-
-            til::f32 sideDistanceX;
-            til::f32 sideDistanceY;
-
-            const til::f32 deltaDistanceX = rayDirection.x == 0.0f ? std::numeric_limits<til::f32>::infinity() : std::fabs(1.0f / rayDirection.x);
-            const til::f32 deltaDistanceY = rayDirection.y == 0.0f ? std::numeric_limits<til::f32>::infinity() : std::fabs(1.0f / rayDirection.y);
-
-            int stepX;
-            int stepY;
-
-            if (rayDirection.x < 0.0f) {
-                stepX = -1;
-                sideDistanceX = (player.position.x - static_cast<til::f32>(mapX)) * deltaDistanceX;
-            } else {
-                stepX = 1;
-                sideDistanceX = (static_cast<til::f32>(mapX + 1) - player.position.x) * deltaDistanceX;
-            }
-
-            if (rayDirection.y < 0.0f) {
-                stepY = -1;
-                sideDistanceY = (player.position.y - static_cast<til::f32>(mapY)) * deltaDistanceY;
-            } else {
-                stepY = 1;
-                sideDistanceY = (static_cast<til::f32>(mapY + 1) - player.position.y) * deltaDistanceY;
-            }
-
-            bool hit = false;
-            bool sideHit = false;
-            int cellId = 0;
-
-            for (int iterations = 0; iterations < 128 && !hit; ++iterations) {
-                if (sideDistanceX < sideDistanceY) {
-                    sideDistanceX += deltaDistanceX;
-                    mapX += stepX;
-                    sideHit = false;
-                } else {
-                    sideDistanceY += deltaDistanceY;
-                    mapY += stepY;
-                    sideHit = true;
-                }
-
-                cellId = getCell(mapX, mapY);
-                if (cellId > 0) {
-                    hit = true;
-                }
-            }
-
-            if (!hit) {
-                continue;
-            }
-
-            const til::f32 perpendicularDistance = sideHit ? (sideDistanceY - deltaDistanceY) : (sideDistanceX - deltaDistanceX);
-            const til::f32 clampedDistance = std::max(perpendicularDistance, 0.0001f);
-
-            const til::f32 projectedHeight = static_cast<til::f32>(size.y) / clampedDistance;
-            int lineHeight = static_cast<int>(projectedHeight);
-            int drawStart = static_cast<int>(static_cast<int>(size.y) / 2 - lineHeight / 2);
-            int drawEnd = static_cast<int>(static_cast<int>(size.y) / 2 + lineHeight / 2);
-
-            drawStart = std::max(drawStart, 0);
-            drawEnd = std::min(drawEnd, static_cast<int>(size.y) - 1);
-
-            const til::Color columnColor = shadeWall(cellId, sideHit, clampedDistance);
-
-            for (int y = drawStart; y <= drawEnd; ++y) {
-                framework.renderer.drawImmediatePixel(
-                    window,
-                    { static_cast<til::u32>(x), static_cast<til::u32>(y) },
-                    columnColor,
-                    til::BlendMode::None
-                );
-            }
-        }
+        raycaster.render(window, { player.position, player.direction, player.cameraPlane });
 
         const auto drawMinimap = [&](const til::Vector2<til::f32> &playerPos, const til::Vector2<til::f32> &playerDir) {
             constexpr til::u32 offsetX = 2;
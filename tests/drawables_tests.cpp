@@ -0,0 +1,72 @@
+#include "test.hpp"
+#include <algorithm>
+
+namespace til::tests
+{
+    namespace
+    {
+        constexpr u32 targetExtent = 64;
+
+        filters::SolidColor solidRed(Color(255, 0, 0, 255));
+
+        // Draws a drawable onto a fresh target and returns whether each pixel was hit
+        std::vector<bool> drawCoverage(Drawable &drawable) {
+            TextureTarget target({ targetExtent, targetExtent });
+            Renderer renderer;
+            target.setRenderer(&renderer);
+            drawable.draw(renderer, target);
+            target.render();
+
+            std::vector<bool> hits;
+            for (const Color &pixel : target.getTexture().getRawData()) {
+                hits.push_back(pixel.r != 0);
+            }
+            return hits;
+        }
+
+        bool isHit(const std::vector<bool> &hits, u32 x, u32 y) {
+            return hits[y * targetExtent + x];
+        }
+    }
+
+    void registerDrawablesTests(Registry &registry) {
+        // The cached stroke of a thick line follows every change of its end points and thickness
+        registry.add("drawables/thick_line_rebuilds_on_change", [] {
+            LineDrawable line;
+            line.start = { 10.f, 10.f };
+            line.end = { 50.f, 10.f };
+            line.thickness = 4.f;
+            line.fragmentPipeline.addFilter(&solidRed).build();
+
+            std::vector<bool> hits = drawCoverage(line);
+            check(isHit(hits, 30, 10) && !isHit(hits, 10, 30), "horizontal line not drawn along its end points");
+
+            hits = drawCoverage(line);
+            check(isHit(hits, 30, 10) && !isHit(hits, 10, 30), "redrawing the unchanged line differs");
+
+            line.end = { 10.f, 50.f };
+            hits = drawCoverage(line);
+            check(!isHit(hits, 30, 10) && isHit(hits, 10, 30) && !isHit(hits, 14, 30), "moved end point left the old stroke in place");
+
+            line.thickness = 12.f;
+            hits = drawCoverage(line);
+            check(isHit(hits, 14, 30) && !isHit(hits, 17, 30), "new thickness left the old stroke width in place");
+        });
+
+        // A hole reaching outside the outline cannot be triangulated, so nothing may be filled
+        registry.add("drawables/polygon_with_invalid_hole_draws_nothing", [] {
+            Polygon polygon;
+            polygon.setPoints({ { 10.f, 10.f }, { 50.f, 10.f }, { 50.f, 50.f }, { 10.f, 50.f } });
+            polygon.fragmentPipeline.addFilter(&solidRed).build();
+
+            polygon.addHole({ { 20.f, 20.f }, { 30.f, 20.f }, { 30.f, 30.f }, { 20.f, 30.f } });
+            std::vector<bool> hits = drawCoverage(polygon);
+            check(isHit(hits, 15, 15) && !isHit(hits, 25, 25), "valid hole not cut out of the polygon");
+
+            polygon.clearHoles();
+            polygon.addHole({ { 40.f, 20.f }, { 60.f, 20.f }, { 60.f, 30.f }, { 40.f, 30.f } });
+            hits = drawCoverage(polygon);
+            check(std::find(hits.begin(), hits.end(), true) == hits.end(), "polygon with an invalid hole was partly filled");
+        });
+    }
+}
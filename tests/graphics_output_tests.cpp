@@ -0,0 +1,120 @@
+#include "test.hpp"
+
+namespace til::tests
+{
+    namespace
+    {
+        const Color red(255, 0, 0, 255);
+        const Color halfBlue(0, 0, 255, 128);
+
+        // Two pixels whose RGBA bytes FF 00 00 FF 00 00 FF 80 encode to "/wAA/wAA/4A="
+        GraphicsUpdate makeFullUpdate() {
+            GraphicsUpdate update;
+            update.imageId = 7;
+            update.cellPosition = { 2, 1 };
+            update.imageSize = { 2u, 1u };
+            update.region = { { 0u, 0u }, { 2u, 1u } };
+            update.replace = true;
+            update.pixels = { red, halfBlue };
+            return update;
+        }
+
+        GraphicsUpdate makeDeltaUpdate() {
+            GraphicsUpdate update = makeFullUpdate();
+            update.region = { { 1u, 0u }, { 1u, 1u } };
+            update.replace = false;
+            update.pixels = { halfBlue };
+            return update;
+        }
+
+        void checkBytes(const std::string &actual, const std::string &expected) {
+            check(actual == expected, "encoded bytes differ\n         expected: " + expected + "\n         actual:   " + actual);
+        }
+    }
+
+    void registerGraphicsOutputTests(Registry &registry) {
+        registry.add("graphics_output/kitty_transmits_whole_image", [] {
+            std::string output;
+            encodeKittyGraphics(makeFullUpdate(), output);
+
+            checkBytes(output, "\x1b[2;3H\x1b_Ga=T,f=32,s=2,v=1,i=7,p=1,C=1,q=2,m=0;/wAA/wAA/4A=\x1b\\");
+        });
+
+        registry.add("graphics_output/kitty_edits_region_in_place", [] {
+            std::string output;
+            encodeKittyGraphics(makeDeltaUpdate(), output);
+
+            checkBytes(output, "\x1b_Ga=f,r=1,X=1,f=32,i=7,x=1,y=0,s=1,v=1,q=2,m=0;AAD/gA==\x1b\\");
+        });
+
+        // 1100 zero pixels are 5868 base64 characters ending in one pad: a full 4096-byte chunk and the rest
+        registry.add("graphics_output/kitty_splits_data_into_chunks", [] {
+            GraphicsUpdate update = makeFullUpdate();
+            update.imageSize = { 1100u, 1u };
+            update.region = { { 0u, 0u }, { 1100u, 1u } };
+            update.pixels.assign(1100, Color(0, 0, 0, 0));
+
+            std::string output;
+            encodeKittyGraphics(update, output);
+
+            const std::string first = "\x1b[2;3H\x1b_Ga=T,f=32,s=1100,v=1,i=7,p=1,C=1,q=2,m=1;";
+            const std::string second = "\x1b\\\x1b_Gq=2,m=0;";
+            checkBytes(output, first + std::string(4096, 'A') + second + std::string(5868 - 4096 - 1, 'A') + "=\x1b\\");
+        });
+
+        // Red quantizes to palette entry 210 and blue to 5; the transparent pixel keeps its bit clear
+        registry.add("graphics_output/sixel_defines_used_palette_and_runs", [] {
+            GraphicsUpdate update;
+            update.imageSize = { 5u, 2u };
+            update.region = { { 0u, 0u }, { 5u, 2u } };
+            update.pixels = {
+                red, red, red, red, Color(0, 0, 255, 255),
+                red, red, red, red, Color(0, 0, 0, 0)
+            };
+
+            std::string output;
+            encodeSixelGraphics(update, { 0u, 0u }, output);
+
+            checkBytes(output, "\x1b[1;1H\x1bP0;1;0q\"1;1;5;2#5;2;0;0;100#210;2;100;0;0#210!4B$#5!4?@\x1b\\");
+        });
+
+        // The presenter's sink sees a keyframe first, then only the changed pixel
+        registry.add("graphics_output/presenter_sink_receives_frames", [] {
+            Window window;
+            window.id = 7;
+            window.setPosition({ 2, 1 });
+            window.setSize({ 2u, 1u });
+
+            std::vector<std::string> frames;
+            GraphicsPresenter presenter;
+            presenter.setSink([&frames](const std::string &bytes) { frames.push_back(bytes); });
+            presenter.setProtocol(GraphicsProtocol::Kitty);
+
+            {
+                PixelLock lock = window.lockPixels();
+                lock.getRow(0)[0] = red;
+                lock.getRow(0)[1] = halfBlue;
+            }
+            presenter.submit(window);
+            presenter.present();
+            presenter.finish();
+
+            {
+                PixelLock lock = window.lockPixels({ { 1u, 0u }, { 1u, 1u } });
+                lock.getRow(0)[0] = halfBlue;
+            }
+            presenter.submit(window);
+            presenter.present();
+            presenter.finish();
+
+            std::string keyframe = "\x1b[2J\x1b_Ga=d,d=A,q=2\x1b\\";
+            encodeKittyGraphics(makeFullUpdate(), keyframe);
+            std::string delta;
+            encodeKittyGraphics(makeDeltaUpdate(), delta);
+
+            check(frames.size() == 2, std::to_string(frames.size()) + " frames reached the sink instead of 2");
+            checkBytes(frames[0], keyframe);
+            checkBytes(frames[1], delta);
+        });
+    }
+}
@@ -0,0 +1,45 @@
+#include "test.hpp"
+#include <iostream>
+#include <string_view>
+
+using namespace til::tests;
+
+int main(int argc, char **argv) {
+    std::string_view filter;
+    if (argc == 2) {
+        filter = argv[1];
+    } else if (argc > 2) {
+        std::cerr << "Usage: TextilTests [<substring>]\n";
+        return 1;
+    }
+
+    // Library errors become exceptions without waiting for a key press
+    til::ErrorSettings::getInstance().displayErrorMessages = false;
+
+    Registry registry;
+    registerRenderTests(registry);
+    registerVideoTests(registry);
+    registerGraphicsOutputTests(registry);
+    registerDrawablesTests(registry);
+
+    int failed = 0;
+    int run = 0;
+    for (const Test &test : registry.getTests()) {
+        if (!filter.empty() && test.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        ++run;
+        try {
+            test.run();
+            std::cout << "[ PASS ] " << test.name << "\n";
+        } catch (const std::exception &error) {
+            ++failed;
+            std::cout << "[ FAIL ] " << test.name << "\n         " << error.what() << "\n";
+        }
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed\n";
+
+    return failed == 0 ? 0 : 1;
+}
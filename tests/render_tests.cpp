@@ -0,0 +1,121 @@
+#include "test.hpp"
+#include <random>
+
+namespace til::tests
+{
+    namespace
+    {
+        constexpr u32 targetExtent = 64;
+        constexpr u32 gridCells = 8;
+
+        // Quads of a gridCells x gridCells grid spanning [low, high]^2, two counter-clockwise
+        // triangles each. Interior grid points move by up to jitter, so neighbouring triangles
+        // share arbitrary sub-pixel edges while the outline stays a rectangle.
+        std::vector<primitives::Vertex> makeQuadGrid(f32 low, f32 high, f32 jitter) {
+            std::mt19937 generator(1234);
+            std::uniform_real_distribution<f32> offset(-jitter, jitter);
+
+            const f32 step = (high - low) / gridCells;
+            std::vector<Vector2<f32>> points((gridCells + 1) * (gridCells + 1));
+            for (u32 y = 0; y <= gridCells; ++y) {
+                for (u32 x = 0; x <= gridCells; ++x) {
+                    Vector2<f32> &point = points[y * (gridCells + 1) + x];
+                    point = { low + step * x, low + step * y };
+
+                    if (x > 0 && x < gridCells) point.x += offset(generator);
+                    if (y > 0 && y < gridCells) point.y += offset(generator);
+                }
+            }
+
+            std::vector<primitives::Vertex> vertices;
+            for (u32 y = 0; y < gridCells; ++y) {
+                for (u32 x = 0; x < gridCells; ++x) {
+                    const Vector2<f32> topLeft = points[y * (gridCells + 1) + x];
+                    const Vector2<f32> topRight = points[y * (gridCells + 1) + x + 1];
+                    const Vector2<f32> bottomLeft = points[(y + 1) * (gridCells + 1) + x];
+                    const Vector2<f32> bottomRight = points[(y + 1) * (gridCells + 1) + x + 1];
+
+                    for (Vector2<f32> position : { bottomLeft, topLeft, topRight, bottomLeft, topRight, bottomRight }) {
+                        vertices.push_back({ position, { 0.f, 0.f } });
+                    }
+                }
+            }
+            return vertices;
+        }
+
+        // Draws the grid with additive blending, so each pixel's red channel counts the triangles covering it
+        std::vector<u32> countCoverage(std::vector<primitives::Vertex> &vertices) {
+            TextureTarget target({ targetExtent, targetExtent });
+            Renderer renderer;
+            target.setRenderer(&renderer);
+            renderer.setRasterizationMode(RasterizationMode::FixedPoint);
+
+            filters::SolidColor solidColor(Color(1, 0, 0, 0));
+            FilterPipeline<filters::VertexData, filters::VertexData> pipeline;
+            pipeline.addFilter(&solidColor).build();
+
+            const u32 vertexCount = static_cast<u32>(vertices.size());
+            primitives::TriangleMesh mesh { renderer.addMesh(vertices.data(), vertexCount), vertexCount };
+            renderer.drawImmediate(target, mesh, Transform(), pipeline, BlendMode::Additive);
+
+            std::vector<u32> hits;
+            for (const Color &pixel : target.getTexture().getRawData()) {
+                hits.push_back(pixel.r);
+            }
+            return hits;
+        }
+
+        std::string pixelName(u32 x, u32 y) {
+            return "pixel (" + std::to_string(x) + ", " + std::to_string(y) + ")";
+        }
+    }
+
+    void registerRenderTests(Registry &registry) {
+        // Pixels are sampled at integer coordinates, so a [4.5, 59.5] outline covers 5..59 with no ties
+        registry.add("render/fixed_point/jittered_grid_covers_once", [] {
+            auto vertices = makeQuadGrid(4.5f, 59.5f, 2.9f);
+            const std::vector<u32> hits = countCoverage(vertices);
+
+            for (u32 y = 0; y < targetExtent; ++y) {
+                for (u32 x = 0; x < targetExtent; ++x) {
+                    const bool inside = x >= 5 && x <= 59 && y >= 5 && y <= 59;
+                    check(hits[y * targetExtent + x] == (inside ? 1u : 0u), pixelName(x, y) + " covered " + std::to_string(hits[y * targetExtent + x]) + " times");
+                }
+            }
+        });
+
+        // Every edge lies on pixel samples, so only the top-left rule keeps neighbours from both claiming them
+        registry.add("render/fixed_point/aligned_grid_covers_once", [] {
+            auto vertices = makeQuadGrid(4.f, 60.f, 0.f);
+            const std::vector<u32> hits = countCoverage(vertices);
+
+            u32 covered = 0;
+            for (u32 y = 0; y < targetExtent; ++y) {
+                for (u32 x = 0; x < targetExtent; ++x) {
+                    const u32 count = hits[y * targetExtent + x];
+                    check(count <= 1, pixelName(x, y) + " covered " + std::to_string(count) + " times");
+
+                    if (x > 4 && x < 59 && y > 4 && y < 59) {
+                        check(count == 1, pixelName(x, y) + " inside the grid is not covered");
+                    }
+                    covered += count;
+                }
+            }
+
+            // Exactly one of each pair of outline rows and columns belongs to the 56x56 area
+            check(covered == 56 * 56, "grid covered " + std::to_string(covered) + " pixels instead of 3136");
+        });
+
+        // A line marks the box between its end points dirty as a whole
+        registry.add("render/line_marks_spanned_box_dirty", [] {
+            TextureTarget target({ targetExtent, targetExtent });
+            Renderer renderer;
+            target.clearDirtyRegion();
+            renderer.drawImmediateLine(target, { 40u, 3u }, { 10u, 20u }, Color(255, 0, 0, 255));
+
+            const Rect<u32> &dirty = target.getDirtyRegion();
+            check(dirty.position == Vector2<u32>(10u, 3u), "dirty region starts at (" + std::to_string(dirty.position.x) + ", " + std::to_string(dirty.position.y) + ")");
+            check(dirty.size == Vector2<u32>(31u, 18u), "dirty region is " + std::to_string(dirty.size.x) + "x" + std::to_string(dirty.size.y));
+        });
+    }
+}
@@ -0,0 +1,18 @@
+#include "test.hpp"
+
+namespace til::tests
+{
+    void check(bool condition, const std::string &description, std::source_location location) {
+        if (!condition) {
+            throw Failure(std::string(location.file_name()) + ":" + std::to_string(location.line()) + ": " + description);
+        }
+    }
+
+    void Registry::add(std::string name, std::function<void()> run) {
+        m_tests.push_back({ std::move(name), std::move(run) });
+    }
+
+    const std::vector<Test> &Registry::getTests() const {
+        return m_tests;
+    }
+}
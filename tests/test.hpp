@@ -0,0 +1,76 @@
+/**
+ * @file test.hpp
+ * @brief Minimal test harness used by the TextilTests target
+ * @details Tests are plain functions registered by name. A failed check throws and
+ *          ends the test; the runner reports every test and exits non-zero if any failed.
+ */
+
+#ifndef TIL_TESTS_TEST_HPP
+#define TIL_TESTS_TEST_HPP
+
+#include <til.hpp>
+#include <functional>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace til::tests
+{
+    /**
+     * @brief Thrown by check() when a condition does not hold
+     */
+    class Failure : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * @brief Fail the running test unless a condition holds
+     * @param condition Condition that must be true
+     * @param description What was checked, included in the failure message
+     * @param location Call site, filled in automatically
+     * @throws Failure If condition is false
+     */
+    void check(bool condition, const std::string &description, std::source_location location = std::source_location::current());
+
+    /**
+     * @brief A named test function
+     */
+    struct Test
+    {
+        std::string name;            ///< Unique name, grouped with slashes (e.g. "render/fixed_point")
+        std::function<void()> run;   ///< Test body
+    };
+
+    /**
+     * @brief Collection of tests to run
+     */
+    class Registry
+    {
+    public:
+        /**
+         * @brief Register a test
+         * @param name Unique test name
+         * @param run Test body
+         */
+        void add(std::string name, std::function<void()> run);
+
+        /**
+         * @brief Get all registered tests in registration order
+         * @return Registered tests
+         */
+        const std::vector<Test> &getTests() const;
+
+    private:
+        std::vector<Test> m_tests {}; ///< Registered tests
+    };
+
+    void registerRenderTests(Registry &registry);
+    void registerVideoTests(Registry &registry);
+    void registerGraphicsOutputTests(Registry &registry);
+    void registerDrawablesTests(Registry &registry);
+}
+
+#endif // TIL_TESTS_TEST_HPP
@@ -0,0 +1,120 @@
+#include "test.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace til::tests
+{
+    namespace
+    {
+        constexpr u32 frameCount = 20;
+
+        // Luma of a frame, so every decoded frame identifies itself
+        u8 frameLuma(u64 frame) {
+            return static_cast<u8>(16 + 10 * (frame % frameCount));
+        }
+
+        u8 expectedRed(u64 frame) {
+            return static_cast<u8>(std::clamp((298 * (frameLuma(frame) - 16) + 128) >> 8, 0, 255));
+        }
+
+        // A 3x3 monochrome y4m at 25 fps, removed again when the test ends
+        class TestVideo
+        {
+        public:
+            TestVideo() : m_path(std::filesystem::temp_directory_path() / "textil_test_video.y4m") {
+                std::ofstream file(m_path, std::ios::binary);
+
+                file << "YUV4MPEG2 W3 H3 F25:1 Cmono\n";
+                for (u32 frame = 0; frame < frameCount; ++frame) {
+                    file << "FRAME\n" << std::string(9, static_cast<char>(frameLuma(frame)));
+                }
+            }
+
+            ~TestVideo() {
+                std::filesystem::remove(m_path);
+            }
+
+            std::string getPath() const {
+                return m_path.string();
+            }
+
+        private:
+            std::filesystem::path m_path;
+        };
+
+        // The presented texture must always hold the content of the reported frame
+        void checkPresentedFrame(const VideoSprite &video) {
+            const Texture *texture = video.getTexture();
+            if (texture == nullptr) return;
+
+            const u64 frame = video.getCurrentFrame();
+            check(texture->getRawData()[0].r == expectedRed(frame), "frame " + std::to_string(frame) + " does not show its own content");
+        }
+
+        // Gives the decoder thread time to refill the ring between clock steps
+        void waitForDecoder() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void registerVideoTests(Registry &registry) {
+        // 0.35 s steps jump 8.75 frames, so the decoder keeps skipping frames and wrapping around
+        registry.add("video/looping_with_drops_keeps_frame_identity", [] {
+            TestVideo file;
+            VideoSprite video;
+            video.setLooping(true);
+            video.open(file.getPath());
+            video.play();
+
+            for (u32 step = 0; step < 200; ++step) {
+                video.update(0.35f);
+                checkPresentedFrame(video);
+                waitForDecoder();
+            }
+
+            check(video.getCurrentFrame() > 2 * frameCount, "playback did not wrap around");
+            check(video.getDroppedFrameCount() > 0, "no frames were dropped");
+        });
+
+        // Jumping past the end before any frame is shown must still finish playback
+        registry.add("video/skip_past_end_finishes", [] {
+            TestVideo file;
+            VideoSprite video;
+            video.open(file.getPath());
+            video.play();
+            video.update(10.f);
+
+            for (u32 attempt = 0; attempt < 1000 && !video.isFinished(); ++attempt) {
+                waitForDecoder();
+                video.update(0.f);
+            }
+
+            check(video.isFinished(), "playback skipped past the end never finished");
+            check(!video.isPlaying(), "finished playback still reports playing");
+            checkPresentedFrame(video);
+        });
+
+        registry.add("video/malformed_header_is_rejected", [] {
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / "textil_test_malformed.y4m";
+
+            for (const char *header : { "YUV4MPEG2 Wabc H3\n", "YUV4MPEG2 W3 H99999999999999999999\n", "YUV4MPEG2 W3 H3 F1:x\n" }) {
+                std::ofstream(path, std::ios::binary) << header;
+
+                VideoSprite video;
+                bool rejected = false;
+                try {
+                    video.open(path.string());
+                } catch (const std::invalid_argument &) {
+                    rejected = true;
+                }
+
+                check(rejected, std::string("header accepted: ") + header);
+                check(!video.isOpen(), std::string("video left open after: ") + header);
+            }
+
+            std::filesystem::remove(path);
+        });
+    }
+}